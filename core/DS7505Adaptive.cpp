@@ -0,0 +1,78 @@
+// shared by the mbed and Linux ports, DS7505Adaptive.h comes from the port include path
+
+#include <stdlib.h>
+
+#include "DS7505Adaptive.h"
+
+DS7505Adaptive::DS7505Adaptive(DS7505 &sensor, DS7505Scheduler &scheduler, uint8_t index,
+                               DS7505::eResolution coarse, DS7505::eResolution fine):
+    _sensor(sensor),
+    _scheduler(scheduler),
+    _index(index),
+    _coarse(coarse),
+    _fine(fine),
+    _nearRaw(DS7505_ADAPTIVE_NEAR_RAW),
+    _changeRaw(DS7505_ADAPTIVE_CHANGE_RAW),
+    _windowMs(DS7505_ADAPTIVE_WINDOW_MS),
+    _stableSamples(DS7505_ADAPTIVE_STABLE),
+    _quiet(0),
+    _started(false),
+    _refRaw(0),
+    _refMs(0),
+    _switches(0)
+{
+}
+
+//----------PUBLIC FUNCTION
+void DS7505Adaptive::limits(int16_t nearRaw, int16_t changeRaw, uint16_t windowMs,
+                            uint8_t stableSamples){
+    _nearRaw = nearRaw;
+    _changeRaw = changeRaw;
+    _windowMs = windowMs ? windowMs : 1;
+    _stableSamples = stableSamples;
+};
+
+// the change is measured against the first sample of a window, so a fast move is
+// seen within one window and slow drift never adds up across windows
+int8_t DS7505Adaptive::update(uint32_t nowMs){
+    int16_t raw = _sensor.ds7505.temperature_raw;
+    bool moved = _started && abs(raw - _refRaw) > _changeRaw;
+    if(!_started || moved || (uint32_t)(nowMs - _refMs) >= _windowMs) {
+        _started = true;
+        _refRaw = raw;
+        _refMs = nowMs;
+    }
+    if(moved || near(raw)) {
+        _quiet = 0;
+        return fine() ? DS7505_SUCCESS : change(_fine, nowMs);
+    }
+    if(fine() && ++_quiet >= _stableSamples) {
+        return change(_coarse, nowMs);
+    }
+    return DS7505_SUCCESS;
+};
+
+bool DS7505Adaptive::fine() const {
+    return (_sensor.ds7505.config & DS7505Protocol::RESOLUTION) == _fine;
+};
+
+uint32_t DS7505Adaptive::switches() const {
+    return _switches;
+};
+
+//------------PRIVATE FUNCTION
+bool DS7505Adaptive::near(int16_t raw) const {
+    return abs(raw - _sensor.ds7505.temp_os_raw) <= _nearRaw ||
+           abs(raw - _sensor.ds7505.temp_hyst_raw) <= _nearRaw;
+};
+
+// the sensor starts a new conversion at the new resolution, the scheduler waits for it
+int8_t DS7505Adaptive::change(DS7505::eResolution resolution, uint32_t nowMs){
+    if(_sensor.setResolution(resolution) != DS7505_SUCCESS) {
+        return DS7505_ERROR;
+    }
+    _scheduler.restart(_index, nowMs);
+    _quiet = 0;
+    _switches++;
+    return DS7505_SUCCESS;
+};
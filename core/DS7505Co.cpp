@@ -0,0 +1,217 @@
+// shared by the mbed and Linux ports, DS7505Co.h comes from the port include path
+
+#include <algorithm>
+
+#include "DS7505Co.h"
+#include "DS7505Eeprom.h"
+
+// a task awaited by another one goes back to it, the awaiting task frees it;
+// a spawned task frees itself, its frame is not touched after the final suspend
+std::coroutine_handle<> DS7505CoTask::final_awaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept {
+    promise_type &promise = handle.promise();
+    if(promise.continuation) {
+        return promise.continuation;
+    }
+    if(promise.loop != nullptr) {
+        promise.loop->finished(handle);
+        handle.destroy();
+    }
+    return std::noop_coroutine();
+};
+
+DS7505CoTask::DS7505CoTask(DS7505CoTask &&other) noexcept: _handle(other._handle)
+{
+    other._handle = nullptr;
+}
+
+DS7505CoTask::~DS7505CoTask(){
+    if(_handle) {
+        _handle.destroy();
+    }
+}
+
+//----------PUBLIC FUNCTION
+// symmetric transfer, a chain of awaited tasks does not grow the stack
+std::coroutine_handle<> DS7505CoTask::await_suspend(std::coroutine_handle<> caller) noexcept {
+    _handle.promise().continuation = caller;
+    return _handle;
+};
+
+int8_t DS7505CoTask::await_resume() const noexcept {
+    return _handle.promise().result;
+};
+
+DS7505CoLoop::DS7505CoLoop(): _seq(0),
+                              _now(0),
+                              _clockUs(ds7505_now_us()),
+                              _clockRestUs(0)
+{
+}
+
+DS7505CoLoop::~DS7505CoLoop(){
+    _waits.clear();
+    for(size_t i = 0; i < _spawned.size(); i++) {
+        _spawned[i].destroy();
+    }
+}
+
+//----------PUBLIC FUNCTION
+void DS7505CoLoop::spawn(DS7505CoTask &&task){
+    std::coroutine_handle<DS7505CoTask::promise_type> handle = task._handle;
+    task._handle = nullptr;
+    handle.promise().loop = this;
+    handle.promise().slot = _spawned.size();
+    _spawned.push_back(handle);
+    at(_now, handle);
+};
+
+uint32_t DS7505CoLoop::tasks() const {
+    return _spawned.size();
+};
+
+// tasks that wait again for now (sleep(0)) run with the next call, so one
+// task cannot keep the others from running
+uint32_t DS7505CoLoop::run(uint32_t nowMs){
+    uint32_t resumed = 0;
+    uint32_t last = _seq;
+    _now = nowMs;
+    while(!_waits.empty() && (int32_t)(nowMs - _waits.front().due) >= 0 &&
+          (int32_t)(last - _waits.front().seq) > 0) {
+        std::pop_heap(_waits.begin(), _waits.end(), later);
+        std::coroutine_handle<> handle = _waits.back().handle;
+        _waits.pop_back();
+        handle.resume();
+        resumed++;
+    }
+    return resumed;
+};
+
+uint32_t DS7505CoLoop::nextDueMs(uint32_t nowMs) const {
+    if(_waits.empty()) {
+        return DS7505_CO_IDLE;
+    }
+    int32_t left = (int32_t)(_waits.front().due - nowMs);
+    return left > 0 ? left : 0;
+};
+
+// a task that waits on something else than the loop (none of the awaitables
+// here) would end it early, runUntilDone() stops when nothing is scheduled
+void DS7505CoLoop::runUntilDone(){
+    while(!_spawned.empty()) {
+        run(clockMs());
+        uint32_t wait = nextDueMs(clockMs());
+        if(wait == DS7505_CO_IDLE) {
+            return;
+        }
+        if(wait > 0) {
+            ds7505_sleep_ms(wait);
+        }
+    }
+};
+
+uint32_t DS7505CoLoop::nowMs() const {
+    return _now;
+};
+
+DS7505CoLoop::sleep_t DS7505CoLoop::sleep(uint32_t ms){
+    return sleep_t{ this, _now + ms };
+};
+
+void DS7505CoLoop::at(uint32_t dueMs, std::coroutine_handle<> handle){
+    _waits.push_back(wait_t{ dueMs, _seq++, handle });
+    std::push_heap(_waits.begin(), _waits.end(), later);
+};
+
+//------------PRIVATE FUNCTION
+bool DS7505CoLoop::later(const DS7505CoLoop::wait_t &a, const DS7505CoLoop::wait_t &b){
+    int32_t due = (int32_t)(a.due - b.due);
+    return due > 0 || (due == 0 && (int32_t)(a.seq - b.seq) > 0);
+};
+
+// the last spawned task takes the slot of the finished one
+void DS7505CoLoop::finished(std::coroutine_handle<DS7505CoTask::promise_type> handle){
+    uint32_t slot = handle.promise().slot;
+    _spawned[slot] = _spawned.back();
+    _spawned[slot].promise().slot = slot;
+    _spawned.pop_back();
+};
+
+// ms since the loop was made, ds7505_now_us() wraps after 71 minutes
+uint32_t DS7505CoLoop::clockMs(){
+    uint32_t now = ds7505_now_us();
+    _clockRestUs += now - _clockUs;
+    _clockUs = now;
+    uint32_t ms = _clockRestUs / 1000;
+    _clockRestUs -= ms * 1000;
+    _now += ms;
+    return _now;
+};
+
+DS7505CoSensor::DS7505CoSensor(DS7505 &sensor, DS7505CoLoop &loop): _sensor(sensor),
+                                                                    _loop(loop),
+                                                                    _due(0)
+{
+    restart();
+}
+
+//----------PUBLIC FUNCTION
+// a sensor that does not answer is due at once, the read reports it
+void DS7505CoSensor::restart(){
+    _due = _loop.nowMs();
+    if(_sensor.getConfigRegCached() == DS7505_SUCCESS) {
+        _due += DS7505::conversionTimeMs(_sensor.ds7505.config);
+    }
+};
+
+DS7505CoSensor::ready_t DS7505CoSensor::conversionReady(){
+    return ready_t{ this, false };
+};
+
+DS7505CoSensor::ready_t DS7505CoSensor::readTemperature(){
+    return ready_t{ this, true };
+};
+
+// nowMs is truncated, one more ms keeps the read behind the end of the conversion
+DS7505CoTask DS7505CoSensor::readOneShot(){
+    if(_sensor.wakeUp() != DS7505_SUCCESS || _sensor.shutDown() != DS7505_SUCCESS) {
+        co_return DS7505_ERROR;
+    }
+    co_await _loop.sleep(DS7505::conversionTimeMs(_sensor.ds7505.config) + 1);
+    co_return _sensor.getTemp();
+};
+
+// DS7505Eeprom checks NVB, the task sleeps on the loop until its next check is due
+DS7505CoTask DS7505CoSensor::commitEeprom(){
+    DS7505Eeprom eeprom(_sensor);
+    if(eeprom.commit(_loop.nowMs()) != DS7505_SUCCESS) {
+        co_return DS7505_ERROR;
+    }
+    while(eeprom.busy()) {
+        co_await _loop.sleep(eeprom.nextDueMs(_loop.nowMs()));
+        eeprom.run(_loop.nowMs());
+    }
+    co_return eeprom.run(_loop.nowMs());
+};
+
+// the due time moves on with every read, like DS7505Scheduler
+bool DS7505CoSensor::ready_t::await_ready() const noexcept {
+    return (sensor->_sensor.ds7505.config & DS7505::SHUTDOWN) != 0 ||
+           (int32_t)(sensor->_loop.nowMs() - sensor->_due) >= 0;
+};
+
+void DS7505CoSensor::ready_t::await_suspend(std::coroutine_handle<> handle){
+    sensor->_loop.at(sensor->_due, handle);
+};
+
+int8_t DS7505CoSensor::ready_t::await_resume(){
+    DS7505 &ds7505 = sensor->_sensor;
+    if((ds7505.ds7505.config & DS7505::SHUTDOWN) != 0) {
+        return DS7505_ERROR;
+    }
+    if(!read) {
+        return DS7505_SUCCESS;
+    }
+    sensor->_due = sensor->_loop.nowMs() + DS7505::conversionTimeMs(ds7505.ds7505.config);
+    return ds7505.getTemp();
+};
@@ -0,0 +1,212 @@
+// shared by the mbed and Linux ports, DS7505Codec.h comes from the port include path
+
+#include "DS7505Codec.h"
+
+DS7505Encoder::DS7505Encoder(uint8_t *buffer, uint16_t size, uint8_t keyframeInterval):
+    _buffer(buffer),
+    _size(size),
+    _interval(keyframeInterval ? keyframeInterval : 1)
+{
+    reset();
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505Encoder::push(int16_t raw, uint8_t resolutionBits){
+    if(resolutionBits < 9 || resolutionBits > 12) {
+        return DS7505_ERROR;
+    }
+    uint8_t shift = 16 - resolutionBits;
+    int16_t value = raw >> shift;
+
+    // keyframe: new block at the next byte
+    if(_header == _size || _buffer[_header + 4] == _interval || shift != _shift) {
+        uint32_t start = (_bitPos + 7) / 8;
+        if(start + DS7505_CODEC_HEADER_SIZE > _size) {
+            return DS7505_ERROR;
+        }
+        int16_t masked = value * (1 << shift);
+        _buffer[start] = DS7505_CODEC_MAGIC;
+        _buffer[start + 1] = resolutionBits;
+        _buffer[start + 2] = DS7505Protocol::encodeMsb(masked);
+        _buffer[start + 3] = DS7505Protocol::encodeLsb(masked);
+        _buffer[start + 4] = 1;
+        _header = start;
+        _bitPos = (start + DS7505_CODEC_HEADER_SIZE) * 8;
+        _shift = shift;
+        _last = value;
+        _samples++;
+        return DS7505_SUCCESS;
+    }
+
+    int16_t change = value - _last;
+    uint32_t zigzag = ((uint32_t)change << 1) ^ (uint32_t)(change >> 15);
+    uint8_t length = 0;
+    uint8_t bits = 1;
+    if(change == 1 || change == -1) {
+        bits = 3;
+    } else if(change != 0) {
+        while((zigzag >> length) != 0) {
+            length++;
+        }
+        bits = 6 + length;
+    }
+    if((_bitPos + bits + 7) / 8 > _size) {
+        return DS7505_ERROR;
+    }
+
+    if(change == 0) {
+        writeBits(0, 1);
+    } else if(bits == 3) {
+        writeBits(change > 0 ? 0x04 : 0x05, 3);
+    } else {
+        writeBits(0x30 | length, 6);
+        writeBits(zigzag, length);
+    }
+    _buffer[_header + 4]++;
+    _last = value;
+    _samples++;
+    return DS7505_SUCCESS;
+};
+
+int8_t DS7505Encoder::push(const DS7505 &sensor){
+    return push(sensor.ds7505.temperature_raw, 16 - DS7505Protocol::rawShift(sensor.ds7505.config));
+};
+
+// the rest of the buffer reads like erased flash, the decoder stops there
+uint16_t DS7505Encoder::flush(){
+    uint16_t used = size();
+    for(uint16_t i = used; i < _size; i++) {
+        _buffer[i] = DS7505_CODEC_ERASED;
+    }
+    _header = _size;
+    return used;
+};
+
+void DS7505Encoder::reset(){
+    _header = _size;
+    _bitPos = 0;
+    _shift = 0;
+    _last = 0;
+    _samples = 0;
+};
+
+uint16_t DS7505Encoder::size() const {
+    return (_bitPos + 7) / 8;
+};
+
+uint32_t DS7505Encoder::samples() const {
+    return _samples;
+};
+
+//------------PRIVATE FUNCTION
+// MSB first, a byte is cleared when the first bit goes into it
+void DS7505Encoder::writeBits(uint32_t value, uint8_t count){
+    while(count > 0) {
+        uint32_t byte = _bitPos >> 3;
+        uint8_t used = _bitPos & 0x07;
+        uint8_t room = 8 - used;
+        uint8_t n = count < room ? count : room;
+        uint8_t bits = (value >> (count - n)) & ((1 << n) - 1);
+        if(used == 0) {
+            _buffer[byte] = 0;
+        }
+        _buffer[byte] |= bits << (room - n);
+        _bitPos += n;
+        count -= n;
+    }
+};
+
+DS7505Decoder::DS7505Decoder(const uint8_t *data, uint16_t size): _data(data),
+                                                                  _size(size),
+                                                                  _bitPos(0),
+                                                                  _left(0),
+                                                                  _shift(0),
+                                                                  _last(0),
+                                                                  _error(false)
+{
+}
+
+//----------PUBLIC FUNCTION
+uint16_t DS7505Decoder::decode(int16_t *raw, uint16_t max){
+    uint16_t n = 0;
+    while(n < max && !_error) {
+        if(_left == 0) {
+            _bitPos = (_bitPos + 7) & ~0x07UL;
+            if(_bitPos / 8 + DS7505_CODEC_HEADER_SIZE > _size ||
+               _data[_bitPos / 8] == DS7505_CODEC_ERASED) {
+                break;
+            }
+            if(!readHeader(raw[n])) {
+                _error = true;
+                break;
+            }
+            n++;
+            continue;
+        }
+
+        // a zero byte is eight unchanged samples
+        if((_bitPos & 0x07) == 0 && _left >= 8 && max - n >= 8 && _bitPos / 8 < _size &&
+           _data[_bitPos / 8] == 0) {
+            int16_t value = _last * (1 << _shift);
+            for(uint8_t i = 0; i < 8; i++) {
+                raw[n++] = value;
+            }
+            _bitPos += 8;
+            _left -= 8;
+            continue;
+        }
+
+        int16_t change = 0;
+        if(readBits(1) != 0) {
+            if(readBits(1) == 0) {
+                change = readBits(1) ? -1 : 1;
+            } else {
+                uint32_t zigzag = readBits(readBits(4));
+                change = (int16_t)((zigzag >> 1) ^ (0 - (zigzag & 1)));
+            }
+        }
+        if(_error) {
+            break;
+        }
+        _last += change;
+        _left--;
+        raw[n++] = _last * (1 << _shift);
+    }
+    return n;
+};
+
+bool DS7505Decoder::error() const {
+    return _error;
+};
+
+//------------PRIVATE FUNCTION
+uint32_t DS7505Decoder::readBits(uint8_t count){
+    uint32_t value = 0;
+    if(_bitPos + count > (uint32_t)_size * 8) {
+        _error = true;
+        return 0;
+    }
+    while(count > 0) {
+        uint8_t used = _bitPos & 0x07;
+        uint8_t room = 8 - used;
+        uint8_t n = count < room ? count : room;
+        uint8_t bits = (_data[_bitPos >> 3] >> (room - n)) & ((1 << n) - 1);
+        value = (value << n) | bits;
+        _bitPos += n;
+        count -= n;
+    }
+    return value;
+};
+
+bool DS7505Decoder::readHeader(int16_t &raw){
+    const uint8_t *header = &_data[_bitPos / 8];
+    if(header[0] != DS7505_CODEC_MAGIC || header[1] < 9 || header[1] > 12 || header[4] == 0) {
+        return false;
+    }
+    _shift = 16 - header[1];
+    raw = DS7505Protocol::decode(header[2], header[3]);
+    _last = raw >> _shift;
+    _left = header[4] - 1;
+    _bitPos += DS7505_CODEC_HEADER_SIZE * 8;
+    return true;
+};
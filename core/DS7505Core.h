@@ -0,0 +1,498 @@
+/**
+Header-only DS7505 protocol and driver core shared by the C++ ports.
+
+DS7505Protocol holds the register map, the byte encoding, the conversion
+constants as constexpr functions and the register state of a sensor.
+DS7505Core<Bus, Addr, Resolution> is the whole driver on a bus policy: the
+pointer cache, the CONFIG shadow, the thresholds, the EEPROM commands and
+the batched profile. The mbed and Linux DS7505 classes are thin wrappers
+around it (locking, the async read, bus recovery, the retry budget). With
+a 7-bit address and a resolution as template parameters the conversion
+time, the raw mask and every transfer are resolved at compile time;
+ADDR_RUNTIME takes the address from the constructor instead. There is no
+virtual call on the way to the bus.
+
+A bus policy is any class with (7-bit address, 0 on success):
+    int write(uint8_t addr, const uint8_t *data, int length);
+    int read(uint8_t addr, uint8_t *data, int length);
+    int writeRead(uint8_t addr, const uint8_t *wdata, int wlength, uint8_t *rdata, int rlength);
+    int transfer(uint8_t addr, DS7505Protocol::msg_t *msgs, int count);
+writeRead must send the pointer byte and the read with a repeated start,
+transfer sends up to TRANSFER_MAX messages with repeated starts in between
+and one STOP at the end (only applyProfile() uses it).
+Policies: DS7505MbedBus (mbed/), DS7505LinuxBus (linux/), DS7505ZephyrBus
+(zephyr/, for C++ applications), DS7505SimBus (sim/). The mbed and Linux
+policies keep the DS7505_INSTRUMENT counters of the calls made through them.
+example:
+I2C i2c(PB_9, PB_8);
+DS7505MbedBus bus(i2c);
+DS7505Core<DS7505MbedBus, 0x48, DS7505Protocol::BITS_12> ds7505(bus);
+
+int main()
+{
+    ds7505.init();
+    while(1) {
+        thread_sleep_for(decltype(ds7505)::conversionTimeMs);
+        if(ds7505.getTemp() == DS7505_SUCCESS) {
+            printf("%ld centi C\n", DS7505Protocol::rawToCenti(ds7505.temperatureRaw()));
+        }
+    }
+}
+ */
+
+#ifndef _DS7505CORE_H
+#define _DS7505CORE_H
+
+#include <stdint.h>
+
+#ifndef DS7505_SUCCESS
+#define DS7505_SUCCESS  0
+#define DS7505_ERROR    -1
+#endif
+
+struct DS7505Protocol {
+    enum eReg {
+        TEMPER  = 0x00,
+        CONFIG  = 0x01,
+        T_HYST  = 0x02,
+        T_OS    = 0x03
+    };
+
+    enum eCommand {
+        RECALL_DATA     = 0xB8,
+        COPY_DATA       = 0x48,
+        SOFTWARE_POR    = 0x54
+    };
+
+    // CONFIG bits
+    enum eConfig {
+        NVB         = 0x80,
+        RESOLUTION  = 0x60,
+        FAULT       = 0x18,
+        POLARITY    = 0x04,
+        MODE        = 0x02,
+        SHUTDOWN    = 0x01
+    };
+
+    enum eResolution {
+        BITS_9  = 0x00 << 5,
+        BITS_10 = 0x01 << 5,
+        BITS_11 = 0x02 << 5,
+        BITS_12 = 0x03 << 5
+    };
+
+    // bus operations counted with DS7505_INSTRUMENT
+    enum eOp {
+        OP_POINTER_WRITE    = 0,
+        OP_DATA_READ        = 1,
+        OP_CONFIG_WRITE     = 2,    // CONFIG, T_HYST and T_OS
+        OP_COMMAND          = 3
+    };
+
+    // why a bus call failed, FAULT_ERROR when the bus does not tell
+    enum eFault {
+        FAULT_NONE,
+        FAULT_NACK,
+        FAULT_TIMEOUT,
+        FAULT_ERROR
+    };
+
+    // the address comes from the constructor of DS7505Core
+    static const uint8_t ADDR_RUNTIME = 0x00;
+    static const uint8_t POINTER_UNKNOWN = 0xFF;
+    // the longest transfer, the read-back of applyProfile()
+    static const int TRANSFER_MAX = 6;
+    // T_OS and T_HYST keep 9 bits, 0.5 degC
+    static const int16_t LIMIT_MASK = (int16_t)0xFF80;
+
+    // register state of one sensor as the driver last saw it
+    struct state_t {
+        uint8_t addr;           // 7-bit
+        uint8_t pointer;        // last value written to the pointer register
+        uint8_t config;         // shadow of CONFIG, NVB is only valid right after getConfigReg()
+        bool config_valid;      // false until read or written, after SOFTWARE_POR and RECALL_DATA
+        int16_t temp_hyst_raw;  // register values, 1/256 degC per LSB
+        int16_t temp_os_raw;
+        int16_t temperature_raw;
+#ifndef DS7505_NO_FLOAT
+        float temp_hyst;
+        float temp_os;
+        float temperature;
+#endif
+    };
+
+    // complete desired state for applyProfile()
+    struct profile_t {
+        uint8_t config;         // resolution | tolerance | polarity | mode
+        int16_t temp_hyst_raw;  // 1/256 degC per LSB, the sensor keeps 0.5 degC
+        int16_t temp_os_raw;
+    };
+
+    // one message of a bus policy transfer()
+    struct msg_t {
+        bool read;
+        uint8_t *data;
+        int length;
+    };
+
+    // 25/50/100/200 ms for the R1:R0 bits of config
+    static constexpr uint16_t conversionTimeMs(uint8_t config) {
+        return 25 << ((config & RESOLUTION) >> 5);
+    }
+
+    // unused low bits of the TEMPER register at a resolution (9 bits: 7, 12 bits: 4)
+    static constexpr uint8_t rawShift(uint8_t config) {
+        return 7 - ((config & RESOLUTION) >> 5);
+    }
+
+    // bits of the TEMPER register that carry data at a resolution (9 bits: 0xFF80)
+    static constexpr int16_t rawMask(uint8_t config) {
+        return (int16_t)(uint16_t)(0xFFFF << rawShift(config));
+    }
+
+    // temperature registers are MSB first, 1/256 degC per LSB
+    static constexpr int16_t decode(uint8_t msb, uint8_t lsb) {
+        return (int16_t)((msb << 8) | lsb);
+    }
+
+    static constexpr uint8_t encodeMsb(int16_t raw) {
+        return (uint8_t)(((uint16_t)raw) >> 8);
+    }
+
+    static constexpr uint8_t encodeLsb(int16_t raw) {
+        return (uint8_t)(raw & 0xFF);
+    }
+
+    static constexpr int32_t rawToCenti(int16_t raw) {
+        return ((int32_t)raw * 100) / 256;
+    }
+
+    static constexpr int16_t centiToRaw(int32_t centi) {
+        return (int16_t)((centi * 256) / 100);
+    }
+
+    // R1:R0 replaced, the other bits kept, NVB never written back
+    static constexpr uint8_t resolutionConfig(uint8_t config, uint8_t resolution) {
+        return (uint8_t)(((config & ~RESOLUTION) | (resolution & RESOLUTION)) & ~NVB);
+    }
+
+    // NVB is read-only and never written back
+    static constexpr uint8_t shutdownConfig(uint8_t config, bool shutdown) {
+        return (uint8_t)((shutdown ? (config | SHUTDOWN) : (config & ~SHUTDOWN)) & ~NVB);
+    }
+
+    // every register value the driver gets or sets goes through here, the float
+    // follows the raw value unless DS7505_NO_FLOAT
+    static void store(state_t &state, uint8_t reg, int16_t raw) {
+        if(reg == TEMPER) {
+            state.temperature_raw = raw;
+#ifndef DS7505_NO_FLOAT
+            state.temperature = raw / 256.0f;
+#endif
+        } else if(reg == T_OS) {
+            state.temp_os_raw = raw;
+#ifndef DS7505_NO_FLOAT
+            state.temp_os = raw / 256.0f;
+#endif
+        } else {
+            state.temp_hyst_raw = raw;
+#ifndef DS7505_NO_FLOAT
+            state.temp_hyst = raw / 256.0f;
+#endif
+        }
+    }
+};
+
+#ifdef DS7505_INSTRUMENT
+#define DS7505_INSTR_OPS            4
+// latency buckets: < 64 us, < 128 us, ... < 4096 us, >= 4096 us
+#define DS7505_INSTR_BUCKETS        8
+#define DS7505_INSTR_BUCKET0_US     64
+
+struct ds7505_op_stats_t {
+    uint32_t count;         // bus calls, failed ones included
+    uint32_t errors;        // all failures, NACKs and timeouts included
+    uint32_t nacks;         // only when the bus tells, see the bus policy
+    uint32_t timeouts;
+    uint32_t retries;
+    uint32_t total_us;
+    uint32_t max_us;
+    uint32_t latency[DS7505_INSTR_BUCKETS];
+};
+
+// per sensor, indexed by DS7505Protocol::eOp
+struct ds7505_instr_t {
+    ds7505_op_stats_t op[DS7505_INSTR_OPS];
+};
+
+// one bus call that took us into the counters of its operation
+inline void ds7505_instr_record(ds7505_op_stats_t &stats, uint32_t us, DS7505Protocol::eFault fault)
+{
+    uint8_t bucket = 0;
+    for(uint32_t limit = DS7505_INSTR_BUCKET0_US; bucket < DS7505_INSTR_BUCKETS - 1 && us >= limit;
+        limit <<= 1) {
+        bucket++;
+    }
+    stats.count++;
+    stats.total_us += us;
+    if(us > stats.max_us) {
+        stats.max_us = us;
+    }
+    stats.latency[bucket]++;
+    if(fault != DS7505Protocol::FAULT_NONE) {
+        stats.errors++;
+        if(fault == DS7505Protocol::FAULT_NACK) {
+            stats.nacks++;
+        } else if(fault == DS7505Protocol::FAULT_TIMEOUT) {
+            stats.timeouts++;
+        }
+    }
+}
+#endif
+
+template <class Bus, uint8_t Addr = 0x48, uint8_t Resolution = DS7505Protocol::BITS_12>
+class DS7505Core {
+    public:
+        static_assert(Addr == DS7505Protocol::ADDR_RUNTIME || (Addr >= 0x48 && Addr <= 0x4F),
+                      "DS7505 address is 0x48..0x4F or ADDR_RUNTIME");
+        static_assert((Resolution & ~DS7505Protocol::RESOLUTION) == 0, "Resolution is BITS_9..BITS_12");
+
+        // of Resolution, init() sets it; after setResolution() conversionTimeMs(config()) holds
+        static constexpr uint16_t conversionTimeMs = DS7505Protocol::conversionTimeMs(Resolution);
+        static constexpr int16_t rawMask = DS7505Protocol::rawMask(Resolution);
+
+        // addr is only used with ADDR_RUNTIME; the shadow starts at Resolution and not valid
+        explicit DS7505Core(Bus &bus, uint8_t addr = Addr): _bus(bus)
+        {
+            _state.addr = Addr == DS7505Protocol::ADDR_RUNTIME ? addr : Addr;
+            _state.pointer = DS7505Protocol::POINTER_UNKNOWN;
+            _state.config = Resolution;
+            _state.config_valid = false;
+            _state.temp_hyst_raw = 0;
+            _state.temp_os_raw = 0;
+            _state.temperature_raw = 0;
+#ifndef DS7505_NO_FLOAT
+            _state.temp_hyst = 0;
+            _state.temp_os = 0;
+            _state.temperature = 0;
+#endif
+        }
+
+        // CONFIG = Resolution, other bits 0 (comparator, active low, converting)
+        int8_t init() {
+            return setConfig(Resolution);
+        }
+
+        int8_t getConfigReg() {
+            uint8_t config;
+            if(readReg(DS7505Protocol::CONFIG, &config, 1) != DS7505_SUCCESS) {
+                return DS7505_ERROR;
+            }
+            _state.config = config;
+            _state.config_valid = true;
+            return DS7505_SUCCESS;
+        }
+
+        // reads CONFIG only when the shadow is not valid
+        int8_t getConfigRegCached() {
+            if(_state.config_valid) {
+                return DS7505_SUCCESS;
+            }
+            return getConfigReg();
+        }
+
+        // NVB is read-only, the shadow follows the written value without a read-back
+        int8_t setConfig(uint8_t config) {
+            const uint8_t data[2] = { DS7505Protocol::CONFIG, (uint8_t)(config & ~DS7505Protocol::NVB) };
+            if(writeReg(data, sizeof(data)) != DS7505_SUCCESS) {
+                _state.config_valid = false;
+                return DS7505_ERROR;
+            }
+            _state.config = data[1];
+            _state.config_valid = true;
+            return DS7505_SUCCESS;
+        }
+
+        // only R1:R0 change, one CONFIG write from the shadow (read first when not valid)
+        int8_t setResolution(uint8_t resolution) {
+            if(getConfigRegCached() != DS7505_SUCCESS) {
+                return DS7505_ERROR;
+            }
+            return setConfig(DS7505Protocol::resolutionConfig(_state.config, resolution));
+        }
+
+        int8_t getTemp() {
+            return readTemperature(DS7505Protocol::TEMPER);
+        }
+
+        int8_t getTempOS() {
+            return readTemperature(DS7505Protocol::T_OS);
+        }
+
+        int8_t getTempHYST() {
+            return readTemperature(DS7505Protocol::T_HYST);
+        }
+
+        int8_t setTempOSRaw(int16_t raw) {
+            return writeTemperature(DS7505Protocol::T_OS, raw);
+        }
+
+        int8_t setTempHystRaw(int16_t raw) {
+            return writeTemperature(DS7505Protocol::T_HYST, raw);
+        }
+
+        int8_t shutDown() {
+            return shutMode(true);
+        }
+
+        int8_t wakeUp() {
+            return shutMode(false);
+        }
+
+        int8_t copySRAMtoEPRROM() {
+            return command(DS7505Protocol::COPY_DATA);
+        }
+
+        // the sensor reloads CONFIG from the EEPROM
+        int8_t recallData() {
+            _state.config_valid = false;
+            return command(DS7505Protocol::RECALL_DATA);
+        }
+
+        int8_t softwarePOR() {
+            _state.config_valid = false;
+            return command(DS7505Protocol::SOFTWARE_POR);
+        }
+
+        bool memoryBusy() {
+            return getConfigReg() == DS7505_SUCCESS && (_state.config & DS7505Protocol::NVB) != 0;
+        }
+
+        // all writes in one transfer and all read-backs in a second one, then COPY_DATA
+        // when commit is set and everything matched
+        int8_t applyProfile(const DS7505Protocol::profile_t &profile, bool commit = false) {
+            uint8_t config[2] = { DS7505Protocol::CONFIG, (uint8_t)(profile.config & ~DS7505Protocol::NVB) };
+            uint8_t hyst[3] = { DS7505Protocol::T_HYST, DS7505Protocol::encodeMsb(profile.temp_hyst_raw),
+                                DS7505Protocol::encodeLsb(profile.temp_hyst_raw) };
+            uint8_t os[3] = { DS7505Protocol::T_OS, DS7505Protocol::encodeMsb(profile.temp_os_raw),
+                              DS7505Protocol::encodeLsb(profile.temp_os_raw) };
+            DS7505Protocol::msg_t writes[3] = {
+                { false, config, sizeof(config) },
+                { false, hyst, sizeof(hyst) },
+                { false, os, sizeof(os) }
+            };
+            _state.pointer = DS7505Protocol::POINTER_UNKNOWN;
+            _state.config_valid = false;
+            if(_bus.transfer(address(), writes, 3) != 0) {
+                return DS7505_ERROR;
+            }
+
+            uint8_t readConfig = 0;
+            uint8_t readHyst[2];
+            uint8_t readOs[2];
+            DS7505Protocol::msg_t reads[DS7505Protocol::TRANSFER_MAX] = {
+                { false, &config[0], 1 },
+                { true, &readConfig, 1 },
+                { false, &hyst[0], 1 },
+                { true, readHyst, sizeof(readHyst) },
+                { false, &os[0], 1 },
+                { true, readOs, sizeof(readOs) }
+            };
+            if(_bus.transfer(address(), reads, DS7505Protocol::TRANSFER_MAX) != 0) {
+                return DS7505_ERROR;
+            }
+            _state.pointer = DS7505Protocol::T_OS;
+            _state.config = readConfig;
+            _state.config_valid = true;
+            DS7505Protocol::store(_state, DS7505Protocol::T_HYST, DS7505Protocol::decode(readHyst[0], readHyst[1]));
+            DS7505Protocol::store(_state, DS7505Protocol::T_OS, DS7505Protocol::decode(readOs[0], readOs[1]));
+
+            if((readConfig & ~DS7505Protocol::NVB) != config[1] ||
+               _state.temp_hyst_raw != (profile.temp_hyst_raw & DS7505Protocol::LIMIT_MASK) ||
+               _state.temp_os_raw != (profile.temp_os_raw & DS7505Protocol::LIMIT_MASK)) {
+                return DS7505_ERROR;
+            }
+            if(commit) {
+                return copySRAMtoEPRROM();
+            }
+            return DS7505_SUCCESS;
+        }
+
+        uint8_t address() const {
+            return Addr == DS7505Protocol::ADDR_RUNTIME ? _state.addr : Addr;
+        }
+
+        uint8_t config() const {
+            return _state.config;
+        }
+
+        int16_t temperatureRaw() const {
+            return _state.temperature_raw;
+        }
+
+        // for transfers made around the core (an async read, bus recovery): the
+        // caller keeps pointer and shadow right
+        DS7505Protocol::state_t &state() {
+            return _state;
+        }
+
+        const DS7505Protocol::state_t &state() const {
+            return _state;
+        }
+    private:
+        Bus &_bus;
+        DS7505Protocol::state_t _state;
+
+        // pointer byte and read in one transaction, only the read when the pointer is there
+        int8_t readReg(uint8_t reg, uint8_t *data, int length) {
+            int ret;
+            if(_state.pointer == reg) {
+                ret = _bus.read(address(), data, length);
+            } else {
+                ret = _bus.writeRead(address(), &reg, 1, data, length);
+            }
+            _state.pointer = (ret == 0) ? reg : DS7505Protocol::POINTER_UNKNOWN;
+            return ret == 0 ? DS7505_SUCCESS : DS7505_ERROR;
+        }
+
+        // data[0] is the register, the pointer stays there
+        int8_t writeReg(const uint8_t *data, int length) {
+            int ret = _bus.write(address(), data, length);
+            _state.pointer = (ret == 0) ? data[0] : DS7505Protocol::POINTER_UNKNOWN;
+            return ret == 0 ? DS7505_SUCCESS : DS7505_ERROR;
+        }
+
+        // commands go through the pointer byte, the pointer is unknown afterwards
+        int8_t command(uint8_t cmd) {
+            _state.pointer = DS7505Protocol::POINTER_UNKNOWN;
+            return _bus.write(address(), &cmd, 1) == 0 ? DS7505_SUCCESS : DS7505_ERROR;
+        }
+
+        int8_t readTemperature(uint8_t reg) {
+            uint8_t data[2];
+            if(readReg(reg, data, sizeof(data)) != DS7505_SUCCESS) {
+                return DS7505_ERROR;
+            }
+            DS7505Protocol::store(_state, reg, DS7505Protocol::decode(data[0], data[1]));
+            return DS7505_SUCCESS;
+        }
+
+        // the shadow keeps the value as written, the sensor keeps 0.5 degC
+        int8_t writeTemperature(uint8_t reg, int16_t raw) {
+            const uint8_t data[3] = { reg, DS7505Protocol::encodeMsb(raw), DS7505Protocol::encodeLsb(raw) };
+            if(writeReg(data, sizeof(data)) != DS7505_SUCCESS) {
+                return DS7505_ERROR;
+            }
+            DS7505Protocol::store(_state, reg, raw);
+            return DS7505_SUCCESS;
+        }
+
+        int8_t shutMode(bool shutdown) {
+            if(getConfigRegCached() != DS7505_SUCCESS) {
+                return DS7505_ERROR;
+            }
+            return setConfig(DS7505Protocol::shutdownConfig(_state.config, shutdown));
+        }
+};
+
+#endif
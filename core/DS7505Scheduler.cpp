@@ -0,0 +1,119 @@
+// shared by the mbed and Linux ports, DS7505Scheduler.h comes from the port include path
+
+#include "DS7505Scheduler.h"
+
+DS7505Scheduler::DS7505Scheduler(uint32_t busFrequency): _count(0),
+                                                         _busFrequency(busFrequency)
+{
+}
+
+//----------PUBLIC FUNCTION
+// the conversion time and SD come from the config shadow, CONFIG is read first when
+// the shadow is not valid; a sensor that does not answer is due at once
+int8_t DS7505Scheduler::add(DS7505 &sensor){
+    if(_count == DS7505_SCHED_MAX_SENSORS) {
+        return DS7505_ERROR;
+    }
+    _sensors[_count] = &sensor;
+    _due[_count] = 0;
+    _count++;
+    sensor.getConfigRegCached();
+    return DS7505_SUCCESS;
+};
+
+uint8_t DS7505Scheduler::count() const {
+    return _count;
+};
+
+// the sensors start a new conversion, first result after one conversion time
+void DS7505Scheduler::restart(uint32_t nowMs){
+    for(uint8_t i = 0; i < _count; i++) {
+        restart(i, nowMs);
+    }
+};
+
+// CONFIG is read again when softwarePOR()/recallData() dropped the shadow; a sensor
+// that does not answer is due at once and run() reports it
+void DS7505Scheduler::restart(uint8_t index, uint32_t nowMs){
+    if(index >= _count) {
+        return;
+    }
+    _due[index] = nowMs;
+    if(_sensors[index]->getConfigRegCached() == DS7505_SUCCESS) {
+        _due[index] += DS7505::conversionTimeMs(_sensors[index]->ds7505.config);
+    }
+};
+
+// reads every sensor with a conversion finished since its last read. A sensor without
+// a valid shadow (it did not answer when added, softwarePOR()) reads CONFIG first; when
+// that fails too it is reported and tried again after the longest conversion
+uint8_t DS7505Scheduler::run(uint32_t nowMs, uint8_t *failed){
+    uint8_t fresh = 0;
+    uint8_t missed = 0;
+    for(uint8_t i = 0; i < _count; i++) {
+        if(!converting(i) || (int32_t)(nowMs - _due[i]) < 0) {
+            continue;
+        }
+        if(_sensors[i]->getConfigRegCached() != DS7505_SUCCESS) {
+            _due[i] = nowMs + DS7505::conversionTimeMs(DS7505::BITS_12);
+            missed |= 1 << i;
+            continue;
+        }
+        if(!converting(i)) {
+            continue;
+        }
+        // one conversion time after a read at least one new conversion has finished
+        _due[i] = nowMs + DS7505::conversionTimeMs(_sensors[i]->ds7505.config);
+        if(_sensors[i]->getTemp() == DS7505_SUCCESS) {
+            fresh |= 1 << i;
+        } else {
+            missed |= 1 << i;
+        }
+    }
+    if(failed != NULL) {
+        *failed = missed;
+    }
+    return fresh;
+};
+
+// time until the next sensor is due, DS7505_SCHED_IDLE when all are shut down
+uint32_t DS7505Scheduler::nextDueMs(uint32_t nowMs) const {
+    uint32_t next = DS7505_SCHED_IDLE;
+    for(uint8_t i = 0; i < _count; i++) {
+        if(!converting(i)) {
+            continue;
+        }
+        int32_t left = (int32_t)(_due[i] - nowMs);
+        if(left <= 0) {
+            return 0;
+        }
+        if((uint32_t)left < next) {
+            next = left;
+        }
+    }
+    return next;
+};
+
+// 0 for a sensor in shutdown or without a valid shadow
+uint32_t DS7505Scheduler::sampleRateMilliHz(uint8_t index) const {
+    if(index >= _count || !_sensors[index]->ds7505.config_valid || !converting(index)) {
+        return 0;
+    }
+    return 1000000 / DS7505::conversionTimeMs(_sensors[index]->ds7505.config);
+};
+
+// sum of the sensor rates, limited by the number of reads the bus can carry
+uint32_t DS7505Scheduler::busSampleRateMilliHz() const {
+    uint32_t total = 0;
+    for(uint8_t i = 0; i < _count; i++) {
+        total += sampleRateMilliHz(i);
+    }
+    uint32_t busLimit = (_busFrequency / DS7505_SCHED_READ_BITS) * 1000;
+    return total < busLimit ? total : busLimit;
+};
+
+//------------PRIVATE FUNCTION
+// without a valid shadow the sensor may be converting, run() finds out
+bool DS7505Scheduler::converting(uint8_t index) const {
+    return !_sensors[index]->ds7505.config_valid || (_sensors[index]->ds7505.config & DS7505::SHUTDOWN) == 0;
+};
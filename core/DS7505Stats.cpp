@@ -0,0 +1,111 @@
+// shared by the mbed and Linux ports, DS7505Stats.h comes from the port include path
+
+#include <string.h>
+
+#include "DS7505Stats.h"
+
+DS7505Stats::DS7505Stats(uint16_t window): _window(window ? window : 1)
+{
+    reset();
+}
+
+//----------PUBLIC FUNCTION
+bool DS7505Stats::update(int16_t raw){
+    if(_count == 0 || raw < _min) {
+        _min = raw;
+    }
+    if(_count == 0 || raw > _max) {
+        _max = raw;
+    }
+    _sum += raw;
+    if(_emaValid) {
+        _ema += raw - (_ema >> DS7505_STATS_EMA_SHIFT);
+    } else {
+        _ema = (int32_t)raw << DS7505_STATS_EMA_SHIFT;
+        _emaValid = true;
+    }
+
+    int32_t bin = ((int32_t)raw - DS7505_STATS_MIN_RAW) >> DS7505_STATS_BIN_SHIFT;
+    if(bin < 0) {
+        bin = 0;
+    } else if(bin >= DS7505_STATS_BINS) {
+        bin = DS7505_STATS_BINS - 1;
+    }
+    _bins[bin]++;
+    _count++;
+
+    if(_count < _window) {
+        return false;
+    }
+    _windows++;
+    fill(_snapshot);
+    _count = 0;
+    _sum = 0;
+    memset(_bins, 0, sizeof(_bins));
+    return true;
+};
+
+bool DS7505Stats::update(const DS7505 &sensor){
+    return update(sensor.ds7505.temperature_raw);
+};
+
+const ds7505_summary_t &DS7505Stats::snapshot() const {
+    return _snapshot;
+};
+
+void DS7505Stats::current(ds7505_summary_t &summary) const {
+    if(_count == 0) {
+        summary = ds7505_summary_t();
+        summary.window = _windows + 1;
+        summary.ema_raw = _ema >> DS7505_STATS_EMA_SHIFT;
+        return;
+    }
+    fill(summary);
+    summary.window = _windows + 1;
+};
+
+void DS7505Stats::reset(){
+    _count = 0;
+    _windows = 0;
+    _min = 0;
+    _max = 0;
+    _sum = 0;
+    _ema = 0;
+    _emaValid = false;
+    memset(_bins, 0, sizeof(_bins));
+    memset(&_snapshot, 0, sizeof(_snapshot));
+};
+
+//------------PRIVATE FUNCTION
+// centre of the bin holding the sample at perMille of the window, kept within min..max
+int16_t DS7505Stats::percentile(uint16_t perMille) const {
+    uint32_t rank = ((uint32_t)_count * perMille + 999) / 1000;
+    uint32_t seen = 0;
+    if(rank == 0) {
+        rank = 1;
+    }
+    for(uint16_t i = 0; i < DS7505_STATS_BINS; i++) {
+        seen += _bins[i];
+        if(seen >= rank) {
+            int32_t centre = DS7505_STATS_MIN_RAW + (i << DS7505_STATS_BIN_SHIFT) +
+                             ((1 << DS7505_STATS_BIN_SHIFT) >> 1);
+            if(centre < _min) {
+                return _min;
+            }
+            return centre > _max ? _max : centre;
+        }
+    }
+    return _max;
+};
+
+void DS7505Stats::fill(ds7505_summary_t &summary) const {
+    summary.window = _windows;
+    summary.count = _count;
+    summary.min_raw = _min;
+    summary.max_raw = _max;
+    summary.mean_raw = _sum / _count;
+    summary.ema_raw = _ema >> DS7505_STATS_EMA_SHIFT;
+    summary.p50_raw = percentile(500);
+    summary.p90_raw = percentile(900);
+    summary.p99_raw = percentile(990);
+};
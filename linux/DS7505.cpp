@@ -0,0 +1,172 @@
+#include "DS7505.h"
+
+#include <errno.h>
+#include <time.h>
+
+DS7505::DS7505(const char *bus, uint8_t addr): pI2C(new I2CDev(bus)),
+                                               _bus(*pI2C),
+                                               _core(_bus, addr),
+                                               ds7505(_core.state())
+{
+}
+
+DS7505::DS7505(I2CDev &i2c, uint8_t addr): pI2C(NULL),
+                                           _bus(i2c),
+                                           _core(_bus, addr),
+                                           ds7505(_core.state())
+{
+}
+
+DS7505::~DS7505(){
+    if(pI2C != NULL) {
+        delete pI2C;
+    }
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505::getConfigReg() {
+    return _core.getConfigReg();
+};
+
+int8_t DS7505::getConfigRegCached() {
+    return _core.getConfigRegCached();
+};
+
+int8_t DS7505::setConfigReg(DS7505::eResolution resolution, 
+                            DS7505::eFault_Tolerance tolerance, 
+                            DS7505::eTermostat_Out_Polarity polarity, 
+                            DS7505::eTermostat_Mode mode) {
+    return _core.setConfig((uint8_t)resolution | (uint8_t)tolerance | (uint8_t)polarity | (uint8_t)mode);
+};
+
+int8_t DS7505::setResolution(DS7505::eResolution resolution){
+    return _core.setResolution(resolution);
+};
+
+int8_t DS7505::getTemp(){
+    return _core.getTemp();
+};
+
+// the failed attempt is the estimate for the next one, errno of the last ioctl tells
+// a missing answer from a bus the adapter could not drive
+int8_t DS7505::getTempWithin(uint32_t budgetUs, uint8_t retries){
+    uint32_t start = ds7505_now_us();
+    for(uint8_t attempt = 0; ; attempt++) {
+        uint32_t attemptStart = ds7505_now_us();
+        if(_core.getTemp() == DS7505_SUCCESS) {
+            return DS7505_SUCCESS;
+        }
+        if(attempt == retries) {
+            return (errno == ETIMEDOUT || errno == EAGAIN || errno == EBUSY) ?
+                   DS7505_ERROR_BUS : DS7505_ERROR_NACK;
+        }
+        uint32_t now = ds7505_now_us();
+        if(now - start + (now - attemptStart) > budgetUs) {
+            return DS7505_ERROR_DEADLINE;
+        }
+#ifdef DS7505_INSTRUMENT
+        _bus.retried(DS7505Protocol::OP_DATA_READ);
+#endif
+    }
+};
+
+int8_t DS7505::getTempOS(){
+    return _core.getTempOS();
+};
+
+int8_t DS7505::getTempHYST(){
+    return _core.getTempHYST();
+};
+
+int8_t DS7505::setTempOSRaw(int16_t tempOS) {
+    return _core.setTempOSRaw(tempOS);
+};
+
+int8_t DS7505::setTempHystRaw(int16_t tempHYST){
+    return _core.setTempHystRaw(tempHYST);
+};
+
+int8_t DS7505::setTempOSCenti(int32_t tempOS) {
+    return _core.setTempOSRaw(DS7505Protocol::centiToRaw(tempOS));
+};
+
+int8_t DS7505::setTempHystCenti(int32_t tempHYST){
+    return _core.setTempHystRaw(DS7505Protocol::centiToRaw(tempHYST));
+};
+
+#ifndef DS7505_NO_FLOAT
+int8_t DS7505::setTempOS(float tempOS) {
+    return _core.setTempOSRaw(tempOS * 256);
+};
+
+int8_t DS7505::setTempHyst(float tempHYST){
+    return _core.setTempHystRaw(tempHYST * 256);
+};
+#endif
+
+int8_t DS7505::copySRAMtoEPRROM(){
+    return _core.copySRAMtoEPRROM();
+};
+
+int8_t DS7505::softwarePOR(){
+    return _core.softwarePOR();
+};
+
+int8_t DS7505::recallData(){
+    return _core.recallData();
+};
+
+bool DS7505::memoryBusy(){
+    return _core.memoryBusy();
+};
+
+// all writes go out as one I2C_RDWR and all read-backs as a second one
+int8_t DS7505::applyProfile(const profile_t &profile, bool commit){
+    return _core.applyProfile(profile, commit);
+};
+
+int8_t DS7505::shutDown(){
+    return _core.shutDown();
+};
+
+int8_t DS7505::wakeUp(){
+    return _core.wakeUp();
+}
+
+// SD is set again right after the wake: the conversion that started runs to the end
+// and the sensor stops after it, continuous mode would start a second one before the read
+int8_t DS7505::getTempOneShot(){
+    if(wakeUp() != DS7505_SUCCESS || shutDown() != DS7505_SUCCESS) {
+        return DS7505_ERROR;
+    }
+    ds7505_sleep_ms(conversionTimeMs(ds7505.config));
+    return getTemp();
+};
+
+#ifdef DS7505_INSTRUMENT
+void DS7505::instrumentation(ds7505_instr_t &snapshot) const {
+    _bus.instrumentation(snapshot);
+};
+
+void DS7505::resetInstrumentation(){
+    _bus.resetInstrumentation();
+};
+#endif
+
+__attribute__((weak)) uint32_t ds7505_now_us(){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+};
+
+__attribute__((weak)) void ds7505_sleep_ms(uint32_t ms){
+    struct timespec delay;
+    delay.tv_sec = ms / 1000;
+    delay.tv_nsec = (ms % 1000) * 1000000L;
+    while(nanosleep(&delay, &delay) != 0 && errno == EINTR) {
+    }
+};
+
+uint16_t DS7505::conversionTimeMs(uint8_t config){
+    return DS7505Protocol::conversionTimeMs(config);
+};
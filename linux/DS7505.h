@@ -0,0 +1,182 @@
+/**
+example:
+#include <stdio.h>
+#include <unistd.h>
+
+#include "DS7505.h"
+
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c);
+
+int main()
+{
+    int8_t status = 0;
+
+    status = ds7505.setConfigReg(DS7505::BITS_12);
+    printf("config reg set -> status %d, value: 0x%2x\n", status, ds7505.ds7505.config);
+
+    while(1) {
+        status = ds7505.getTemp();
+        printf("temperature reg read -> status %d, value dec[C]: %f\n",
+                                status,
+                                ds7505.ds7505.temperature);
+        sleep(1);
+    }
+}
+ */
+
+#ifndef _DS7505_H
+#define _DS7505_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "I2CDev.h"
+
+#define DS7505_I2C_ADDRESS  0x48 // 0b0100 1000
+
+#define DS7505_SUCCESS  0
+#define DS7505_ERROR    -1
+// only returned by getTempWithin()
+#define DS7505_ERROR_NACK       -2  // ENXIO, EREMOTEIO, EIO on the last attempt
+#define DS7505_ERROR_BUS        -3  // ETIMEDOUT, EAGAIN (arbitration lost), EBUSY
+#define DS7505_ERROR_DEADLINE   -4  // the next attempt would not fit the budget
+
+// attempts after the first one in getTempWithin()
+#define DS7505_RETRIES  2
+
+// the protocol, the register state and the DS7505_INSTRUMENT counters are shared
+// with the mbed port in core/DS7505Core.h; ds7505_now_us() and ds7505_sleep_ms()
+// are declared in I2CDev.h
+#include "DS7505LinuxBus.h"
+
+
+class DS7505 {
+    public:
+        enum eReg {
+            TEMPER  =   0x00,
+            CONFIG  =   0x01,
+            T_HYST  =   0x02,
+            T_OS    =   0x03
+        };
+
+        enum eNVB {
+            MEM_NOT_BUSY        =   0x00 << 7,
+            WRITE_IN_PROGRESS   =   0x01 << 7
+        };
+
+        enum eResolution {
+            BITS_9  =   0x00 << 5,   //25ms
+            BITS_10 =   0x01 << 5,   //50ms
+            BITS_11 =   0x02 << 5,   //100ms
+            BITS_12 =   0x03 << 5    //200ms
+        };
+
+        enum eFault_Tolerance {
+            OUT_OF_LIMITS_TRIG_1    =   0x00 << 3,
+            OUT_OF_LIMITS_TRIG_2    =   0x01 << 3,
+            OUT_OF_LIMITS_TRIG_4    =   0x02 << 3,
+            OUT_OF_LIMITS_TRIG_6    =   0x03 << 3
+        };
+
+        enum eTermostat_Out_Polarity {
+            ACTIVE_LOW  =   0x00 << 2,
+            ACTIVE_HIGH =   0x01 << 2
+        };
+
+        enum eTermostat_Mode {
+            COMPARATOR  =   0x00 << 1,
+            INTERRUPT   =   0x01 << 1,
+        };
+
+        enum eShutdown {
+            ACTIVE_CONVER   =   0x00,
+            SHUTDOWN        =   0x01
+        };
+
+        enum eCommand{
+            RECALL_DATA     =   0xB8,
+            COPY_DATA       =   0x48,
+            SOFTWARE_POR    =   0x54
+        };
+
+        // addr (7-bit), pointer cache, CONFIG shadow and the register values, kept by
+        // DS7505Core, see DS7505Protocol::state_t
+        typedef DS7505Protocol::state_t ds7505_t;
+        // complete desired state for applyProfile()
+        typedef DS7505Protocol::profile_t profile_t;
+    private:
+        typedef DS7505Core<DS7505LinuxBus, DS7505Protocol::ADDR_RUNTIME, DS7505Protocol::BITS_9> core_t;
+
+        // declared before ds7505, which refers into the core
+        I2CDev *pI2C;
+        DS7505LinuxBus _bus;
+        core_t _core;
+    public:
+        ds7505_t &ds7505;
+
+        DS7505(const char *bus, uint8_t addr = DS7505_I2C_ADDRESS);
+        DS7505(I2CDev &i2c, uint8_t addr = DS7505_I2C_ADDRESS);
+
+        ~DS7505();
+
+        int8_t getConfigReg();
+        // reads CONFIG only when the shadow is not valid
+        int8_t getConfigRegCached();
+        int8_t setConfigReg(DS7505::eResolution resolution = BITS_9,
+                            DS7505::eFault_Tolerance tolerance = OUT_OF_LIMITS_TRIG_1,
+                            DS7505::eTermostat_Out_Polarity polarity = ACTIVE_LOW,
+                            DS7505::eTermostat_Mode mode = COMPARATOR);
+
+        // only R1:R0 change, one CONFIG write from the shadow (read first when not valid)
+        int8_t setResolution(DS7505::eResolution resolution);
+
+        int8_t getTemp();
+        // getTemp() retried for at most retries more attempts while another one fits
+        // in budgetUs; bus recovery is up to the adapter driver, I2CDev::setTimeout()
+        // bounds how long one attempt can block
+        int8_t getTempWithin(uint32_t budgetUs, uint8_t retries = DS7505_RETRIES);
+        int8_t getTempOS();
+        int8_t getTempHYST();
+
+        // integer setters, no float code is pulled in with DS7505_NO_FLOAT
+        int8_t setTempOSRaw(int16_t tempOS);
+        int8_t setTempHystRaw(int16_t tempHYST);
+        int8_t setTempOSCenti(int32_t tempOS);
+        int8_t setTempHystCenti(int32_t tempHYST);
+#ifndef DS7505_NO_FLOAT
+        int8_t setTempOS(float tempOS);
+        int8_t setTempHyst(float tempHYST);
+#endif
+
+        int8_t copySRAMtoEPRROM();
+        int8_t softwarePOR();
+        int8_t recallData();
+        bool memoryBusy();
+        // CONFIG, T_HYST and T_OS written back to back and verified with one read pass,
+        // then COPY_DATA when commit is set and everything matched
+        int8_t applyProfile(const profile_t &profile, bool commit = false);
+
+        int8_t shutDown();
+        int8_t wakeUp();
+        // one conversion for a sensor kept in SHUTDOWN: wake and shut down at once (the
+        // started conversion still completes), sleep the conversion time of the cached
+        // resolution, read TEMPER. Two CONFIG writes and one read, CONFIG is only read
+        // when the shadow is not valid;
+        // DS7505OneShot does the same from a poll loop without blocking
+        int8_t getTempOneShot();
+
+        // 25/50/100/200 ms for the R1:R0 bits of config
+        static uint16_t conversionTimeMs(uint8_t config);
+
+#ifdef DS7505_INSTRUMENT
+        void instrumentation(ds7505_instr_t &snapshot) const;
+        void resetInstrumentation();
+#endif
+    private:
+        DS7505(const DS7505 &);
+        DS7505 &operator=(const DS7505 &);
+        
+};
+
+#endif
@@ -0,0 +1,90 @@
+/**
+Adaptive resolution for one sensor of a DS7505Scheduler. After every new
+sample update() decides: while the temperature is quiet and far from T_OS and
+T_HYST the sensor runs at the coarse resolution (9 bits, 25 ms, 8x the sample
+rate of 12 bits), when it moves faster than changeRaw per window or comes
+within nearRaw of a threshold it switches to the fine resolution (12 bits,
+200 ms) at once, and back after stableSamples quiet samples. A switch is one
+CONFIG write (R1:R0 only) and restarts the sensor in the scheduler, which
+takes the new conversion time from the config shadow.
+The thresholds come from the temp_os_raw/temp_hyst_raw shadows, read or set
+them first.
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c);
+DS7505Scheduler scheduler;
+DS7505Adaptive adaptive(ds7505, scheduler, 0);
+
+// CLOCK_MONOTONIC in ms
+static uint32_t millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int main()
+{
+    ds7505.setConfigReg(DS7505::BITS_9);
+    ds7505.getTempOS();
+    ds7505.getTempHYST();
+    scheduler.add(ds7505);
+    scheduler.restart(millis());
+    while(1) {
+        if(scheduler.run(millis()) & 0x01) {
+            adaptive.update(millis());
+            printf("value dec[C]: %f (%s)\n", ds7505.ds7505.temperature,
+                   adaptive.fine() ? "12 bits" : "9 bits");
+        }
+        usleep(scheduler.nextDueMs(millis()) * 1000);
+    }
+}
+ */
+
+#ifndef _DS7505ADAPTIVE_H
+#define _DS7505ADAPTIVE_H
+
+#include "DS7505.h"
+#include "DS7505Scheduler.h"
+
+#define DS7505_ADAPTIVE_NEAR_RAW    (2 * 256)   // 2 degC from T_OS or T_HYST
+// more than one 9-bit step (0.5 degC) within the window, a value flickering
+// between two steps is not a change
+#define DS7505_ADAPTIVE_CHANGE_RAW  192
+#define DS7505_ADAPTIVE_WINDOW_MS   1000
+#define DS7505_ADAPTIVE_STABLE      8
+
+class DS7505Adaptive {
+    public:
+        DS7505Adaptive(DS7505 &sensor, DS7505Scheduler &scheduler, uint8_t index,
+                       DS7505::eResolution coarse = DS7505::BITS_9,
+                       DS7505::eResolution fine = DS7505::BITS_12);
+
+        void limits(int16_t nearRaw, int16_t changeRaw, uint16_t windowMs, uint8_t stableSamples);
+
+        // after every new sample of the sensor, DS7505_ERROR when a switch failed
+        // (tried again with the next sample)
+        int8_t update(uint32_t nowMs);
+        bool fine() const;
+        uint32_t switches() const;
+    private:
+        DS7505 &_sensor;
+        DS7505Scheduler &_scheduler;
+        uint8_t _index;
+        DS7505::eResolution _coarse;
+        DS7505::eResolution _fine;
+        int16_t _nearRaw;
+        int16_t _changeRaw;
+        uint16_t _windowMs;
+        uint8_t _stableSamples;
+        uint8_t _quiet;
+        bool _started;
+        int16_t _refRaw;        // first sample of the current window
+        uint32_t _refMs;
+        uint32_t _switches;
+
+        bool near(int16_t raw) const;
+        int8_t change(DS7505::eResolution resolution, uint32_t nowMs);
+};
+
+#endif
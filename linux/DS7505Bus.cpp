@@ -0,0 +1,145 @@
+#include "DS7505Bus.h"
+
+#include <linux/i2c.h>
+
+DS7505Bus::DS7505Bus(I2CDev &i2c): _I2C(i2c),
+                                   _count(0)
+{
+}
+
+DS7505Bus::~DS7505Bus(){
+    for(uint8_t i = 0; i < _count; i++) {
+        delete _sensors[i];
+    }
+}
+
+//----------PUBLIC FUNCTION
+// sensors are kept in address order, polling walks the bus from 0x48 up
+int8_t DS7505Bus::add(uint8_t addr){
+    if(addr < DS7505_BUS_FIRST_ADDR || addr > DS7505_BUS_LAST_ADDR) {
+        return DS7505_ERROR;
+    }
+    uint8_t pos = position(addr);
+    if(pos < _count && _sensors[pos]->ds7505.addr == addr) {
+        return DS7505_SUCCESS;
+    }
+    if(_count == DS7505_BUS_MAX_SENSORS) {
+        return DS7505_ERROR;
+    }
+    insert(pos, new DS7505(_I2C, addr));
+    return DS7505_SUCCESS;
+};
+
+// adds every address that answers a CONFIG read, returns the number of sensors.
+// Every address is probed through the sensor that keeps it, so the pointer cache
+// follows the CONFIG read and a new sensor starts with a valid config shadow
+uint8_t DS7505Bus::scan(){
+    for(uint8_t addr = DS7505_BUS_FIRST_ADDR; addr <= DS7505_BUS_LAST_ADDR; addr++) {
+        uint8_t pos = position(addr);
+        if(pos < _count && _sensors[pos]->ds7505.addr == addr) {
+            _online[pos] = _sensors[pos]->getConfigReg() == DS7505_SUCCESS;
+            continue;
+        }
+        if(_count == DS7505_BUS_MAX_SENSORS) {
+            continue;
+        }
+        DS7505 *sensor = new DS7505(_I2C, addr);
+        if(sensor->getConfigReg() == DS7505_SUCCESS) {
+            insert(pos, sensor);
+        } else {
+            delete sensor;
+        }
+    }
+    return _count;
+};
+
+uint8_t DS7505Bus::count() const {
+    return _count;
+};
+
+DS7505 *DS7505Bus::sensor(uint8_t index){
+    if(index < _count) {
+        return _sensors[index];
+    }
+    return NULL;
+};
+
+// one polling cycle: the sensors that answered last time are read in a single
+// I2C_RDWR ioctl with repeated starts in between, the pointer write is only
+// added for sensors that do not point at TEMPER yet. A NACK aborts the whole
+// ioctl, then those sensors are read one by one so that only the missing ones
+// get DS7505_ERROR and drop out of the batch until they answer again.
+// samples must have room for count() entries. Returns the number of sensors
+// that answered.
+uint8_t DS7505Bus::poll(sample_t *samples){
+    struct i2c_msg msgs[2 * DS7505_BUS_MAX_SENSORS];
+    uint8_t data[DS7505_BUS_MAX_SENSORS][2];
+    char reg = DS7505::TEMPER;
+    int n = 0;
+
+    for(uint8_t i = 0; i < _count; i++) {
+        DS7505 *sensor = _sensors[i];
+        if(!_online[i]) {
+            continue;
+        }
+        if(sensor->ds7505.pointer != DS7505::TEMPER) {
+            msgs[n].addr = sensor->ds7505.addr;
+            msgs[n].flags = 0;
+            msgs[n].len = 1;
+            msgs[n].buf = (uint8_t *)&reg;
+            n++;
+        }
+        msgs[n].addr = sensor->ds7505.addr;
+        msgs[n].flags = I2C_M_RD;
+        msgs[n].len = 2;
+        msgs[n].buf = data[i];
+        n++;
+    }
+    bool batched = n > 0 && _I2C.transfer(msgs, n) == DS7505_SUCCESS;
+
+    uint8_t ok = 0;
+    for(uint8_t i = 0; i < _count; i++) {
+        DS7505 *sensor = _sensors[i];
+        samples[i].addr = sensor->ds7505.addr;
+        if(batched && _online[i]) {
+            sensor->ds7505.pointer = DS7505::TEMPER;
+            DS7505Protocol::store(sensor->ds7505, DS7505::TEMPER,
+                                  DS7505Protocol::decode(data[i][0], data[i][1]));
+            samples[i].status = DS7505_SUCCESS;
+        } else {
+            if(_online[i]) {
+                sensor->ds7505.pointer = DS7505Protocol::POINTER_UNKNOWN;
+            }
+            samples[i].status = sensor->getTemp();
+            _online[i] = samples[i].status == DS7505_SUCCESS;
+        }
+        samples[i].temperature_raw = sensor->ds7505.temperature_raw;
+#ifndef DS7505_NO_FLOAT
+        samples[i].temperature = sensor->ds7505.temperature;
+#endif
+        if(samples[i].status == DS7505_SUCCESS) {
+            ok++;
+        }
+    }
+    return ok;
+};
+
+//------------PRIVATE FUNCTION
+// index of addr, or where it goes to keep the address order
+uint8_t DS7505Bus::position(uint8_t addr) const {
+    uint8_t pos = 0;
+    while(pos < _count && _sensors[pos]->ds7505.addr < addr) {
+        pos++;
+    }
+    return pos;
+};
+
+void DS7505Bus::insert(uint8_t pos, DS7505 *sensor){
+    for(uint8_t i = _count; i > pos; i--) {
+        _sensors[i] = _sensors[i - 1];
+        _online[i] = _online[i - 1];
+    }
+    _sensors[pos] = sensor;
+    _online[pos] = true;
+    _count++;
+};
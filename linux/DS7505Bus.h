@@ -0,0 +1,65 @@
+/**
+Owns all DS7505 sensors on one i2c-dev adapter and polls them as one batch.
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505Bus bus(i2c);
+DS7505Bus::sample_t samples[DS7505_BUS_MAX_SENSORS];
+
+int main()
+{
+    bus.scan();
+    while(1) {
+        uint8_t n = bus.poll(samples);
+        for(uint8_t i = 0; i < bus.count(); i++) {
+            printf("0x%2x -> status %d, value dec[C]: %f\n",
+                   samples[i].addr, samples[i].status, samples[i].temperature);
+        }
+        sleep(1);
+    }
+}
+ */
+
+#ifndef _DS7505BUS_H
+#define _DS7505BUS_H
+
+#include "DS7505.h"
+
+#define DS7505_BUS_MAX_SENSORS  8
+#define DS7505_BUS_FIRST_ADDR   0x48
+#define DS7505_BUS_LAST_ADDR    0x4F
+
+class DS7505Bus {
+    public:
+        struct sample_t {
+            uint8_t addr;
+            int8_t status;
+            int16_t temperature_raw;
+#ifndef DS7505_NO_FLOAT
+            float temperature;
+#endif
+        };
+
+        DS7505Bus(I2CDev &i2c);
+        ~DS7505Bus();
+
+        int8_t add(uint8_t addr);
+        uint8_t scan();
+
+        uint8_t count() const;
+        DS7505 *sensor(uint8_t index);
+
+        uint8_t poll(sample_t *samples);
+    private:
+        I2CDev &_I2C;
+        DS7505 *_sensors[DS7505_BUS_MAX_SENSORS];
+        bool _online[DS7505_BUS_MAX_SENSORS];
+        uint8_t _count;
+
+        uint8_t position(uint8_t addr) const;
+        void insert(uint8_t pos, DS7505 *sensor);
+
+        DS7505Bus(const DS7505Bus &);
+        DS7505Bus &operator=(const DS7505Bus &);
+};
+
+#endif
@@ -0,0 +1,189 @@
+/**
+C++20 coroutines on top of the driver (compile with -std=c++20). Acquisition
+logic is written as one straight sequence ("configure, wait for the
+conversion, read, shut down") instead of callbacks or a blocked thread.
+DS7505CoLoop is a single-threaded scheduler of DS7505CoTask coroutines. A
+waiting task is its coroutine frame and one timer entry, there is no stack
+per task, so thousands of sensor tasks share one thread; for more threads
+run one loop per thread with its own adapters.
+DS7505CoSensor wraps a DS7505 with awaitable operations:
+    conversionReady()   resumes once a conversion finished since the last
+                        read, from the cached resolution like DS7505Scheduler
+    readTemperature()   conversionReady(), then getTemp()
+    readOneShot()       wake and shut down at once, the conversion time, read
+    commitEeprom()      COPY_DATA through DS7505Eeprom, sleeps between NVB checks
+    loop.sleep(ms)      any other wait
+All return DS7505_SUCCESS or DS7505_ERROR, the values are in ds7505 as with
+the blocking calls. The transfers themselves are short and run when the task
+resumes; the sensors of a loop are only used from the loop's thread.
+The loop runs from a poll loop (run(nowMs), nextDueMs()) or on its own
+(runUntilDone(), ms from ds7505_now_us(), ds7505_sleep_ms() in between).
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c);
+DS7505CoLoop loop;
+DS7505CoSensor sensor(ds7505, loop);
+
+DS7505CoTask acquire()
+{
+    ds7505.setConfigReg(DS7505::BITS_12);
+    sensor.restart();
+    for(int i = 0; i < 10; i++) {
+        if(co_await sensor.readTemperature() == DS7505_SUCCESS) {
+            printf("value dec[C]: %f\n", ds7505.ds7505.temperature);
+        }
+    }
+    ds7505.setTempOS(30.0);
+    co_return co_await sensor.commitEeprom();
+}
+
+int main()
+{
+    loop.spawn(acquire());
+    loop.runUntilDone();
+}
+ */
+
+#ifndef _DS7505CO_H
+#define _DS7505CO_H
+
+#if !defined(__cpp_impl_coroutine)
+#error "DS7505Co.h needs C++20 coroutines (-std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+#include "DS7505.h"
+
+#define DS7505_CO_IDLE  0xFFFFFFFF
+
+class DS7505CoLoop;
+
+class DS7505CoTask {
+    public:
+        struct promise_type;
+
+        // a finished task resumes the task that awaits it, a spawned one is freed
+        struct final_awaiter {
+            bool await_ready() const noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() const noexcept {}
+        };
+
+        struct promise_type {
+            int8_t result = DS7505_SUCCESS;
+            std::coroutine_handle<> continuation;
+            DS7505CoLoop *loop = nullptr;       // set by spawn()
+            uint32_t slot = 0;                  // index in the loop's spawned tasks
+
+            DS7505CoTask get_return_object() {
+                return DS7505CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            final_awaiter final_suspend() const noexcept { return {}; }
+            void return_value(int8_t value) { result = value; }
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        DS7505CoTask(DS7505CoTask &&other) noexcept;
+        ~DS7505CoTask();
+
+        // co_await runs the task inside the awaiting one and gives its result
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept;
+        int8_t await_resume() const noexcept;
+    private:
+        std::coroutine_handle<promise_type> _handle;
+
+        explicit DS7505CoTask(std::coroutine_handle<promise_type> handle): _handle(handle) {}
+        DS7505CoTask(const DS7505CoTask &);
+        DS7505CoTask &operator=(const DS7505CoTask &);
+
+        friend class DS7505CoLoop;
+};
+
+class DS7505CoLoop {
+    public:
+        struct sleep_t {
+            DS7505CoLoop *loop;
+            uint32_t dueMs;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { loop->at(dueMs, handle); }
+            void await_resume() const noexcept {}
+        };
+
+        DS7505CoLoop();
+        // tasks that did not finish are destroyed
+        ~DS7505CoLoop();
+
+        // the task starts with the next run()
+        void spawn(DS7505CoTask &&task);
+        uint32_t tasks() const;
+
+        // resumes every task due at nowMs, returns how many were resumed
+        uint32_t run(uint32_t nowMs);
+        // time until the next task is due, DS7505_CO_IDLE when none waits
+        uint32_t nextDueMs(uint32_t nowMs) const;
+        void runUntilDone();
+
+        // time of the current run()
+        uint32_t nowMs() const;
+        // 0 lets the other due tasks run first
+        sleep_t sleep(uint32_t ms);
+        void at(uint32_t dueMs, std::coroutine_handle<> handle);
+    private:
+        struct wait_t {
+            uint32_t due;
+            uint32_t seq;           // tasks due at the same time resume in order
+            std::coroutine_handle<> handle;
+        };
+
+        std::vector<wait_t> _waits;     // min-heap on due
+        std::vector<std::coroutine_handle<DS7505CoTask::promise_type> > _spawned;
+        uint32_t _seq;
+        uint32_t _now;
+        uint32_t _clockUs;              // runUntilDone(): last ds7505_now_us()
+        uint32_t _clockRestUs;          // us not counted in _now yet
+
+        static bool later(const wait_t &a, const wait_t &b);
+        void finished(std::coroutine_handle<DS7505CoTask::promise_type> handle);
+        uint32_t clockMs();
+
+        DS7505CoLoop(const DS7505CoLoop &);
+        DS7505CoLoop &operator=(const DS7505CoLoop &);
+
+        friend struct DS7505CoTask::final_awaiter;
+};
+
+class DS7505CoSensor {
+    public:
+        // conversionReady() and readTemperature()
+        struct ready_t {
+            DS7505CoSensor *sensor;
+            bool read;
+
+            bool await_ready() const noexcept;
+            void await_suspend(std::coroutine_handle<> handle);
+            int8_t await_resume();
+        };
+
+        DS7505CoSensor(DS7505 &sensor, DS7505CoLoop &loop);
+
+        // the sensor starts a new conversion, call it after a config write or wakeUp();
+        // CONFIG is read first when the shadow is not valid
+        void restart();
+        // DS7505_ERROR at once when the sensor is shut down
+        ready_t conversionReady();
+        ready_t readTemperature();
+        DS7505CoTask readOneShot();
+        DS7505CoTask commitEeprom();
+    private:
+        DS7505 &_sensor;
+        DS7505CoLoop &_loop;
+        uint32_t _due;
+};
+
+#endif
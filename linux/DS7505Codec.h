@@ -0,0 +1,99 @@
+/**
+Compact log format for the raw samples of one sensor. Every block starts with
+a byte-aligned keyframe, followed by the changes between samples as a bit
+stream at the sensor resolution (1/16 degC steps at 12 bits, 0.5 degC at 9):
+    block:  0xD5 | resolution bits (9..12) | raw MSB | raw LSB | samples in block
+    change: 0            same value
+            10s          +1 (s = 0) or -1 (s = 1) step
+            11 LLLL x..x zigzag of the change in L bits
+A slowly changing temperature costs 1..3 bits per sample instead of a 4-byte
+float. The encoder writes into a caller buffer and keeps the sample count in
+the header up to date, so the buffer decodes at any time; push() fails when
+the buffer is full, flush() pads the rest with 0xFF (erased flash, where the
+decoder stops), write it out and reset(). A new keyframe starts every
+keyframeInterval samples and when the resolution changes.
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c);
+uint8_t page[256];
+DS7505Encoder encoder(page, sizeof(page));
+
+int main()
+{
+    FILE *log = fopen("ds7505.log", "ab");
+    while(1) {
+        if(ds7505.getTemp() == DS7505_SUCCESS && encoder.push(ds7505) == DS7505_ERROR) {
+            fwrite(page, 1, encoder.flush(), log);
+            encoder.reset();
+            encoder.push(ds7505);
+        }
+        sleep(1);
+    }
+}
+
+reading back one page of size bytes:
+int16_t raw[2048];
+DS7505Decoder decoder(page, size);
+uint16_t n = decoder.decode(raw, 2048);
+ */
+
+#ifndef _DS7505CODEC_H
+#define _DS7505CODEC_H
+
+#include "DS7505.h"
+
+#define DS7505_CODEC_MAGIC          0xD5
+#define DS7505_CODEC_ERASED         0xFF
+#define DS7505_CODEC_HEADER_SIZE    5
+// largest change: 11, 4-bit length, 15 bits of zigzag
+#define DS7505_CODEC_MAX_BITS       21
+
+class DS7505Encoder {
+    public:
+        DS7505Encoder(uint8_t *buffer, uint16_t size, uint8_t keyframeInterval = 64);
+
+        // DS7505_ERROR when the sample does not fit any more
+        int8_t push(int16_t raw, uint8_t resolutionBits = 12);
+        int8_t push(const DS7505 &sensor);
+
+        // bytes used, the rest is padded, the next push() starts a new block
+        uint16_t flush();
+        void reset();
+
+        uint16_t size() const;
+        uint32_t samples() const;
+    private:
+        uint8_t *_buffer;
+        uint16_t _size;
+        uint8_t _interval;
+        uint16_t _header;       // offset of the open block, _size when none
+        uint32_t _bitPos;
+        uint8_t _shift;
+        int16_t _last;          // last value >> _shift
+        uint32_t _samples;
+
+        void writeBits(uint32_t value, uint8_t count);
+};
+
+class DS7505Decoder {
+    public:
+        DS7505Decoder(const uint8_t *data, uint16_t size);
+
+        // decodes up to max samples (1/256 degC per LSB), can be called again for the rest;
+        // stops at the end of the data or at a corrupt block
+        uint16_t decode(int16_t *raw, uint16_t max);
+        bool error() const;
+    private:
+        const uint8_t *_data;
+        uint16_t _size;
+        uint32_t _bitPos;
+        uint8_t _left;          // samples left in the current block
+        uint8_t _shift;
+        int16_t _last;
+        bool _error;
+
+        uint32_t readBits(uint8_t count);
+        bool readHeader(int16_t &raw);
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "DS7505Eeprom.h"
+
+DS7505Eeprom::DS7505Eeprom(DS7505 &sensor): _sensor(&sensor),
+                                            _due(0),
+                                            _waitedMs(0),
+                                            _delayMs(0),
+                                            _status(DS7505_SUCCESS)
+{
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505Eeprom::commit(uint32_t nowMs){
+    return start(&DS7505::copySRAMtoEPRROM, nowMs, DS7505_EEPROM_WRITE_MS);
+};
+
+int8_t DS7505Eeprom::recall(uint32_t nowMs){
+    return start(&DS7505::recallData, nowMs, DS7505_EEPROM_RECALL_MS);
+};
+
+// one CONFIG read per due check, NVB stays set while the EEPROM is written,
+// the result of the last operation is kept until the next one starts
+int8_t DS7505Eeprom::run(uint32_t nowMs){
+    if(_status != DS7505_EEPROM_PENDING || (int32_t)(nowMs - _due) < 0) {
+        return _status;
+    }
+    if(_sensor->getConfigReg() != DS7505_SUCCESS) {
+        _status = DS7505_ERROR;
+    } else if((_sensor->ds7505.config & DS7505::WRITE_IN_PROGRESS) == 0) {
+        _status = DS7505_SUCCESS;
+    } else if(_waitedMs >= DS7505_EEPROM_TIMEOUT_MS) {
+        _status = DS7505_ERROR;
+    } else {
+        _due = nowMs + _delayMs;
+        _waitedMs += _delayMs;
+        if(_delayMs < DS7505_EEPROM_MAX_POLL_MS) {
+            _delayMs *= 2;
+        }
+    }
+    return _status;
+};
+
+// time until the next NVB check, DS7505_EEPROM_IDLE when nothing is pending
+uint32_t DS7505Eeprom::nextDueMs(uint32_t nowMs) const {
+    if(_status != DS7505_EEPROM_PENDING) {
+        return DS7505_EEPROM_IDLE;
+    }
+    int32_t left = (int32_t)(_due - nowMs);
+    return left > 0 ? left : 0;
+};
+
+bool DS7505Eeprom::busy() const {
+    return _status == DS7505_EEPROM_PENDING;
+};
+
+//------------PRIVATE FUNCTION
+int8_t DS7505Eeprom::start(int8_t (DS7505::*command)(), uint32_t nowMs, uint16_t firstCheckMs){
+    if(_status == DS7505_EEPROM_PENDING) {
+        return DS7505_ERROR;
+    }
+    if((_sensor->*command)() != DS7505_SUCCESS) {
+        _status = DS7505_ERROR;
+        return DS7505_ERROR;
+    }
+    _status = DS7505_EEPROM_PENDING;
+    _due = nowMs + firstCheckMs;
+    _waitedMs = firstCheckMs;
+    _delayMs = 1;
+    return DS7505_SUCCESS;
+};
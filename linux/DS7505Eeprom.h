@@ -0,0 +1,75 @@
+/**
+Non-blocking COPY_DATA / RECALL_DATA for a poll loop. The command is sent at
+once, run() checks NVB only when the next check is due, first after the
+typical EEPROM write time and then with a growing interval, so the bus is free
+for other sensors in between. run() returns DS7505_EEPROM_PENDING until NVB is
+clear (DS7505_SUCCESS) or the timeout passed (DS7505_ERROR).
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c, 0x48);
+DS7505 ds7505b(i2c, 0x49);
+DS7505Eeprom eeprom[2] = { DS7505Eeprom(ds7505), DS7505Eeprom(ds7505b) };
+
+// CLOCK_MONOTONIC in ms
+static uint32_t millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int main()
+{
+    ds7505.setTempOS(30.0);
+    ds7505b.setTempOS(30.0);
+    for(int i = 0; i < 2; i++) {
+        eeprom[i].commit(millis());
+    }
+    while(eeprom[0].busy() || eeprom[1].busy()) {
+        uint32_t wait = DS7505_EEPROM_IDLE;
+        for(int i = 0; i < 2; i++) {
+            if(eeprom[i].run(millis()) == DS7505_ERROR) {
+                printf("commit %d failed\n", i);
+            }
+            uint32_t next = eeprom[i].nextDueMs(millis());
+            wait = next < wait ? next : wait;
+        }
+        if(wait != DS7505_EEPROM_IDLE) {
+            usleep(wait * 1000);
+        }
+    }
+}
+ */
+
+#ifndef _DS7505EEPROM_H
+#define _DS7505EEPROM_H
+
+#include "DS7505.h"
+
+#define DS7505_EEPROM_PENDING       1
+#define DS7505_EEPROM_IDLE          0xFFFFFFFF
+#define DS7505_EEPROM_WRITE_MS      10  // typical tWR, first NVB check after COPY_DATA
+#define DS7505_EEPROM_RECALL_MS     1
+#define DS7505_EEPROM_MAX_POLL_MS   8   // the check interval doubles up to this
+#define DS7505_EEPROM_TIMEOUT_MS    100
+
+class DS7505Eeprom {
+    public:
+        DS7505Eeprom(DS7505 &sensor);
+
+        int8_t commit(uint32_t nowMs);
+        int8_t recall(uint32_t nowMs);
+        int8_t run(uint32_t nowMs);
+        uint32_t nextDueMs(uint32_t nowMs) const;
+        bool busy() const;
+    private:
+        DS7505 *_sensor;
+        uint32_t _due;
+        uint16_t _waitedMs;
+        uint16_t _delayMs;
+        int8_t _status;
+
+        int8_t start(int8_t (DS7505::*command)(), uint32_t nowMs, uint16_t firstCheckMs);
+};
+
+#endif
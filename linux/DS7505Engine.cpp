@@ -0,0 +1,232 @@
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "DS7505Engine.h"
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+DS7505Engine::DS7505Engine(): _count(0),
+                              _next(0),
+                              _running(false)
+{
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    _stopFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+}
+
+DS7505Engine::~DS7505Engine(){
+    stop();
+    for(uint8_t i = 0; i < _count; i++) {
+        close(_workers[i]->timerFd);
+        close(_workers[i]->eventFd);
+        delete _workers[i]->bus;
+        delete _workers[i]->i2c;
+        delete _workers[i];
+    }
+    close(_stopFd);
+    close(_epollFd);
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505Engine::addAdapter(const char *path){
+    if(_running || _count == DS7505_ENGINE_MAX_ADAPTERS || _epollFd < 0 || _stopFd < 0) {
+        return DS7505_ERROR;
+    }
+    I2CDev *i2c = new I2CDev(path);
+    if(!i2c->isOpen()) {
+        delete i2c;
+        return DS7505_ERROR;
+    }
+    worker_t *worker = new worker_t;
+    worker->i2c = i2c;
+    worker->bus = new DS7505Bus(*i2c);
+    worker->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    worker->eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    worker->index = _count;
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u32 = _count;
+    if(worker->timerFd < 0 || worker->eventFd < 0 ||
+       epoll_ctl(_epollFd, EPOLL_CTL_ADD, worker->eventFd, &event) != 0) {
+        if(worker->timerFd >= 0) {
+            close(worker->timerFd);
+        }
+        if(worker->eventFd >= 0) {
+            close(worker->eventFd);
+        }
+        delete worker->bus;
+        delete worker;
+        delete i2c;
+        return DS7505_ERROR;
+    }
+    worker->bus->scan();
+    _workers[_count] = worker;
+    return _count++;
+};
+
+uint8_t DS7505Engine::adapters() const {
+    return _count;
+};
+
+DS7505Bus *DS7505Engine::bus(uint8_t adapter){
+    if(adapter < _count) {
+        return _workers[adapter]->bus;
+    }
+    return NULL;
+};
+
+// the schedulers take the resolution from the config shadow, CONFIG is read for the
+// sensors found by scan() whose shadow is not valid
+int8_t DS7505Engine::start(){
+    if(_running) {
+        return DS7505_ERROR;
+    }
+    uint64_t value;
+    while(read(_stopFd, &value, sizeof(value)) > 0) {
+    }
+    _running = true;
+    for(uint8_t i = 0; i < _count; i++) {
+        worker_t *worker = _workers[i];
+        worker->scheduler = DS7505Scheduler();
+        for(uint8_t s = 0; s < worker->bus->count(); s++) {
+            DS7505 *sensor = worker->bus->sensor(s);
+            sensor->getConfigRegCached();
+            worker->scheduler.add(*sensor);
+        }
+        worker->thread = std::thread(&DS7505Engine::run, this, worker);
+    }
+    return DS7505_SUCCESS;
+};
+
+void DS7505Engine::stop(){
+    if(!_running) {
+        return;
+    }
+    // the write can only fail with EAGAIN, the counter is non-zero then and the workers
+    // wake up anyway; they are joined in every case
+    uint64_t one = 1;
+    ssize_t written = write(_stopFd, &one, sizeof(one));
+    (void)written;
+    for(uint8_t i = 0; i < _count; i++) {
+        _workers[i]->thread.join();
+    }
+    _running = false;
+};
+
+int DS7505Engine::fd() const {
+    return _epollFd;
+};
+
+// the eventfds are cleared before the rings are drained, a sample pushed after the
+// drain sets its eventfd again and the next wait() wakes up for it
+uint16_t DS7505Engine::wait(ds7505_engine_sample_t *samples, uint16_t max, int timeoutMs){
+    struct epoll_event events[DS7505_ENGINE_MAX_ADAPTERS];
+    uint64_t end = nowNs() + (uint64_t)(timeoutMs < 0 ? 0 : timeoutMs) * 1000000ULL;
+    while(1) {
+        uint16_t n = drain(samples, max);
+        if(n > 0) {
+            return n;
+        }
+        int left = -1;
+        if(timeoutMs >= 0) {
+            uint64_t now = nowNs();
+            if(now >= end) {
+                return 0;
+            }
+            left = (end - now + 999999) / 1000000;
+        }
+        int ready = epoll_wait(_epollFd, events, DS7505_ENGINE_MAX_ADAPTERS, left);
+        for(int i = 0; i < ready; i++) {
+            uint64_t value;
+            if(read(_workers[events[i].data.u32]->eventFd, &value, sizeof(value)) < 0) {
+                continue;
+            }
+        }
+    }
+};
+
+uint32_t DS7505Engine::dropped() const {
+    uint32_t total = 0;
+    for(uint8_t i = 0; i < _count; i++) {
+        total += _workers[i]->ring.dropped();
+    }
+    return total;
+};
+
+//------------PRIVATE FUNCTION
+// one worker per adapter: read what is due, publish, sleep on the timerfd until the
+// next conversion finishes or the engine stops
+void DS7505Engine::run(worker_t *worker){
+    struct pollfd fds[2] = { { worker->timerFd, POLLIN, 0 }, { _stopFd, POLLIN, 0 } };
+    worker->scheduler.restart(nowNs() / 1000000);
+    while(1) {
+        uint64_t now = nowNs() / 1000000;
+        uint32_t nowMs = now;
+        uint8_t failed = 0;
+        uint8_t fresh = worker->scheduler.run(nowMs, &failed);
+        if((fresh | failed) != 0) {
+            for(uint8_t i = 0; i < worker->bus->count(); i++) {
+                if(((fresh | failed) & (1 << i)) == 0) {
+                    continue;
+                }
+                ds7505_engine_sample_t sample;
+                sample.timestamp = nowMs;
+                sample.adapter = worker->index;
+                sample.addr = worker->bus->sensor(i)->ds7505.addr;
+                sample.status = (fresh & (1 << i)) ? DS7505_SUCCESS : DS7505_ERROR;
+                sample.temperature_raw = worker->bus->sensor(i)->ds7505.temperature_raw;
+                worker->ring.push(sample);
+            }
+            uint64_t one = 1;
+            if(write(worker->eventFd, &one, sizeof(one)) != sizeof(one)) {
+                break;
+            }
+        }
+
+        // absolute deadline, the time spent on the bus does not shift the next read;
+        // all sensors shut down disarms the timer until stop()
+        struct itimerspec deadline = {};
+        uint32_t wait = worker->scheduler.nextDueMs(nowMs);
+        if(wait != DS7505_SCHED_IDLE) {
+            uint64_t due = (now + wait) * 1000000ULL;
+            deadline.it_value.tv_sec = due / 1000000000ULL;
+            deadline.it_value.tv_nsec = due % 1000000000ULL;
+        }
+        timerfd_settime(worker->timerFd, TFD_TIMER_ABSTIME, &deadline, NULL);
+        if(poll(fds, 2, -1) < 0 && errno != EINTR) {
+            break;
+        }
+        if(fds[1].revents & POLLIN) {
+            break;
+        }
+        if(fds[0].revents & POLLIN) {
+            uint64_t expirations;
+            if(read(worker->timerFd, &expirations, sizeof(expirations)) < 0) {
+                continue;
+            }
+        }
+    }
+};
+
+// round robin over the adapters, one busy adapter cannot starve the others
+uint16_t DS7505Engine::drain(ds7505_engine_sample_t *samples, uint16_t max){
+    uint16_t n = 0;
+    for(uint8_t i = 0; i < _count && n < max; i++) {
+        worker_t *worker = _workers[(_next + i) % _count];
+        n += worker->ring.pop(samples + n, max - n);
+    }
+    if(_count > 0) {
+        _next = (_next + 1) % _count;
+    }
+    return n;
+};
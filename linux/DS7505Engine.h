@@ -0,0 +1,102 @@
+/**
+Acquisition engine for several i2c-dev adapters. Every adapter gets its own
+worker thread with a DS7505Bus (scanned when the adapter is added) and a
+DS7505Scheduler; the worker sleeps on a timerfd armed for the absolute
+CLOCK_MONOTONIC time of the next finished conversion, which follows from the
+resolution of every sensor (25/50/100/200 ms). The samples go into a lock-free
+ring per worker and an eventfd wakes the consumer, which waits on one epoll
+descriptor for all adapters. The adapters run in parallel, so the sample rate
+grows with the number of adapters instead of being capped by one blocking loop.
+A sensor that was due and did not answer gives a sample with DS7505_ERROR.
+Configure the sensors through bus() before start(), the workers own them after.
+example:
+DS7505Engine engine;
+ds7505_engine_sample_t samples[64];
+
+int main()
+{
+    engine.addAdapter("/dev/i2c-1");
+    engine.addAdapter("/dev/i2c-3");
+    engine.start();
+    while(1) {
+        uint16_t n = engine.wait(samples, 64, 1000);
+        for(uint16_t i = 0; i < n; i++) {
+            printf("%u i2c-%u 0x%2x status %d, %d centi C\n", samples[i].timestamp,
+                   samples[i].adapter, samples[i].addr, samples[i].status,
+                   DS7505Protocol::rawToCenti(samples[i].temperature_raw));
+        }
+    }
+}
+ */
+
+#ifndef _DS7505ENGINE_H
+#define _DS7505ENGINE_H
+
+#include <thread>
+
+#include "I2CDev.h"
+#include "DS7505.h"
+#include "DS7505Bus.h"
+#include "DS7505Ring.h"
+#include "DS7505Scheduler.h"
+
+#define DS7505_ENGINE_MAX_ADAPTERS  8
+// samples buffered per adapter until the consumer drains them
+#ifndef DS7505_ENGINE_RING_SIZE
+#define DS7505_ENGINE_RING_SIZE     256
+#endif
+
+// one read, failed ones included like DS7505Bus::sample_t
+struct ds7505_engine_sample_t {
+    uint32_t timestamp;     // ms, CLOCK_MONOTONIC
+    uint8_t adapter;        // index from addAdapter()
+    uint8_t addr;           // 7-bit address
+    int8_t status;          // DS7505_ERROR when the sensor did not answer
+    int16_t temperature_raw;    // the last good value after a failed read
+};
+
+class DS7505Engine {
+    public:
+        DS7505Engine();
+        ~DS7505Engine();
+
+        // opens and scans the adapter, returns its index or DS7505_ERROR
+        int8_t addAdapter(const char *path);
+        uint8_t adapters() const;
+        DS7505Bus *bus(uint8_t adapter);
+
+        int8_t start();
+        void stop();
+
+        // readable when samples are waiting, to nest the engine in another epoll loop
+        int fd() const;
+        // up to max samples of all adapters, 0 when none came within timeoutMs (-1 waits)
+        uint16_t wait(ds7505_engine_sample_t *samples, uint16_t max, int timeoutMs);
+        uint32_t dropped() const;
+    private:
+        struct worker_t {
+            I2CDev *i2c;
+            DS7505Bus *bus;
+            DS7505Scheduler scheduler;
+            DS7505Ring<DS7505_ENGINE_RING_SIZE, ds7505_engine_sample_t> ring;
+            int timerFd;
+            int eventFd;
+            uint8_t index;
+            std::thread thread;
+        };
+
+        worker_t *_workers[DS7505_ENGINE_MAX_ADAPTERS];
+        uint8_t _count;
+        uint8_t _next;          // first adapter drained by the next wait()
+        int _epollFd;
+        int _stopFd;
+        bool _running;
+
+        void run(worker_t *worker);
+        uint16_t drain(ds7505_engine_sample_t *samples, uint16_t max);
+
+        DS7505Engine(const DS7505Engine &);
+        DS7505Engine &operator=(const DS7505Engine &);
+};
+
+#endif
@@ -0,0 +1,120 @@
+/**
+Bus policy of DS7505Core for an I2CDev adapter, see core/DS7505Core.h.
+writeRead is one I2C_RDWR ioctl with a repeated start, so is transfer.
+DS7505 has one per sensor over the shared adapter; with DS7505_INSTRUMENT
+it counts every ioctl made through it, a pointer write that goes out with
+the read in one I2C_RDWR is counted as OP_DATA_READ. NACKs are ENXIO,
+EREMOTEIO and EIO, timeouts ETIMEDOUT.
+ */
+
+#ifndef _DS7505LINUXBUS_H
+#define _DS7505LINUXBUS_H
+
+#include <errno.h>
+#include <string.h>
+#include <linux/i2c.h>
+
+#include "I2CDev.h"
+#include "DS7505Core.h"
+
+class DS7505LinuxBus {
+    public:
+        explicit DS7505LinuxBus(I2CDev &i2c): _i2c(i2c)
+        {
+#ifdef DS7505_INSTRUMENT
+            resetInstrumentation();
+#endif
+        }
+
+        // a single byte write is a command, the pointer only goes out with a read
+        int write(uint8_t addr, const uint8_t *data, int length) {
+            DS7505Protocol::eOp op = length > 1 ? DS7505Protocol::OP_CONFIG_WRITE : DS7505Protocol::OP_COMMAND;
+#ifdef DS7505_INSTRUMENT
+            uint32_t start = ds7505_now_us();
+            return record(op, start, _i2c.write(addr, (const char *)data, length));
+#else
+            (void)op;
+            return _i2c.write(addr, (const char *)data, length);
+#endif
+        }
+
+        int read(uint8_t addr, uint8_t *data, int length) {
+#ifdef DS7505_INSTRUMENT
+            uint32_t start = ds7505_now_us();
+            return record(DS7505Protocol::OP_DATA_READ, start, _i2c.read(addr, (char *)data, length));
+#else
+            return _i2c.read(addr, (char *)data, length);
+#endif
+        }
+
+        int writeRead(uint8_t addr, const uint8_t *wdata, int wlength, uint8_t *rdata, int rlength) {
+#ifdef DS7505_INSTRUMENT
+            uint32_t start = ds7505_now_us();
+            return record(DS7505Protocol::OP_DATA_READ, start,
+                          _i2c.writeRead(addr, (const char *)wdata, wlength, (char *)rdata, rlength));
+#else
+            return _i2c.writeRead(addr, (const char *)wdata, wlength, (char *)rdata, rlength);
+#endif
+        }
+
+        // counted as OP_DATA_READ when any message reads, as OP_CONFIG_WRITE otherwise
+        int transfer(uint8_t addr, DS7505Protocol::msg_t *msgs, int count) {
+            struct i2c_msg rdwr[DS7505Protocol::TRANSFER_MAX];
+            DS7505Protocol::eOp op = DS7505Protocol::OP_CONFIG_WRITE;
+            if(count > DS7505Protocol::TRANSFER_MAX) {
+                errno = EINVAL;
+                return -1;
+            }
+            for(int i = 0; i < count; i++) {
+                rdwr[i].addr = addr;
+                rdwr[i].flags = msgs[i].read ? I2C_M_RD : 0;
+                rdwr[i].len = msgs[i].length;
+                rdwr[i].buf = msgs[i].data;
+                if(msgs[i].read) {
+                    op = DS7505Protocol::OP_DATA_READ;
+                }
+            }
+#ifdef DS7505_INSTRUMENT
+            uint32_t start = ds7505_now_us();
+            return record(op, start, _i2c.transfer(rdwr, count));
+#else
+            (void)op;
+            return _i2c.transfer(rdwr, count);
+#endif
+        }
+
+#ifdef DS7505_INSTRUMENT
+        void instrumentation(ds7505_instr_t &snapshot) const {
+            snapshot = _instr;
+        }
+
+        void resetInstrumentation() {
+            memset(&_instr, 0, sizeof(_instr));
+        }
+
+        void retried(DS7505Protocol::eOp op) {
+            _instr.op[op].retries++;
+        }
+#endif
+    private:
+        I2CDev &_i2c;
+#ifdef DS7505_INSTRUMENT
+        ds7505_instr_t _instr;
+
+        // ret is passed through, errno still holds the reason of a failed ioctl
+        int record(DS7505Protocol::eOp op, uint32_t startUs, int ret) {
+            int error = errno;
+            DS7505Protocol::eFault fault = DS7505Protocol::FAULT_NONE;
+            if(ret != 0) {
+                fault = error == ETIMEDOUT ? DS7505Protocol::FAULT_TIMEOUT :
+                        (error == ENXIO || error == EREMOTEIO || error == EIO) ?
+                        DS7505Protocol::FAULT_NACK : DS7505Protocol::FAULT_ERROR;
+            }
+            ds7505_instr_record(_instr.op[op], ds7505_now_us() - startUs, fault);
+            errno = error;
+            return ret;
+        }
+#endif
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "DS7505OneShot.h"
+
+DS7505OneShot::DS7505OneShot(DS7505 &sensor): _sensor(&sensor),
+                                              _due(0),
+                                              _status(DS7505_SUCCESS)
+{
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505OneShot::start(uint32_t nowMs){
+    if(_status == DS7505_ONESHOT_PENDING) {
+        return DS7505_ERROR;
+    }
+    if(_sensor->wakeUp() != DS7505_SUCCESS || _sensor->shutDown() != DS7505_SUCCESS) {
+        _status = DS7505_ERROR;
+        return DS7505_ERROR;
+    }
+    // nowMs was taken before the writes and is truncated, one more ms keeps the read
+    // behind the end of the conversion
+    _status = DS7505_ONESHOT_PENDING;
+    _due = nowMs + DS7505::conversionTimeMs(_sensor->ds7505.config) + 1;
+    return DS7505_SUCCESS;
+};
+
+// the result is kept until the next start()
+int8_t DS7505OneShot::run(uint32_t nowMs){
+    if(_status != DS7505_ONESHOT_PENDING || (int32_t)(nowMs - _due) < 0) {
+        return _status;
+    }
+    _status = _sensor->getTemp();
+    return _status;
+};
+
+// time until the conversion is done, DS7505_ONESHOT_IDLE when nothing is pending
+uint32_t DS7505OneShot::nextDueMs(uint32_t nowMs) const {
+    if(_status != DS7505_ONESHOT_PENDING) {
+        return DS7505_ONESHOT_IDLE;
+    }
+    int32_t left = (int32_t)(_due - nowMs);
+    return left > 0 ? left : 0;
+};
+
+bool DS7505OneShot::busy() const {
+    return _status == DS7505_ONESHOT_PENDING;
+};
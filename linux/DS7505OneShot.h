@@ -0,0 +1,59 @@
+/**
+One-shot reads for a poll loop, for sensors kept in SHUTDOWN. start() wakes
+the sensor and shuts it down again at once (two CONFIG writes, the conversion
+that started still completes), run() reads TEMPER once the conversion time of
+the cached resolution has passed; until then it returns DS7505_ONESHOT_PENDING and nextDueMs() tells the loop how long it
+can sleep, so many sensors convert at the same time without blocking.
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c);
+DS7505OneShot oneShot(ds7505);
+
+// CLOCK_MONOTONIC in ms
+static uint32_t millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int main()
+{
+    ds7505.setConfigReg(DS7505::BITS_12);
+    ds7505.shutDown();
+    while(1) {
+        oneShot.start(millis());
+        while(oneShot.busy()) {
+            usleep(oneShot.nextDueMs(millis()) * 1000);
+            if(oneShot.run(millis()) == DS7505_SUCCESS) {
+                printf("value dec[C]: %f\n", ds7505.ds7505.temperature);
+            }
+        }
+        sleep(60);
+    }
+}
+ */
+
+#ifndef _DS7505ONESHOT_H
+#define _DS7505ONESHOT_H
+
+#include "DS7505.h"
+
+#define DS7505_ONESHOT_PENDING      1
+#define DS7505_ONESHOT_IDLE         0xFFFFFFFF
+
+class DS7505OneShot {
+    public:
+        DS7505OneShot(DS7505 &sensor);
+
+        int8_t start(uint32_t nowMs);
+        int8_t run(uint32_t nowMs);
+        uint32_t nextDueMs(uint32_t nowMs) const;
+        bool busy() const;
+    private:
+        DS7505 *_sensor;
+        uint32_t _due;
+        int8_t _status;
+};
+
+#endif
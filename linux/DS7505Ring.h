@@ -0,0 +1,100 @@
+/**
+Fixed size single-producer/single-consumer ring of timestamped samples.
+The acquisition thread pushes, one consumer thread drains in batches,
+neither side takes a lock. SIZE must be a power of two, the indices run
+freely and are masked on access. RECORD can be any copyable type,
+ds7505_record_t by default.
+example (millis() as in DS7505Scheduler.h):
+DS7505Ring<64> ring;
+
+void *acquisition(void *)
+{
+    while(1) {
+        if(ds7505.getTemp() == DS7505_SUCCESS) {
+            ring.push(ds7505, millis());
+        }
+        usleep(200000);
+    }
+}
+
+void *logger(void *)
+{
+    ds7505_record_t batch[16];
+    while(1) {
+        uint16_t n = ring.pop(batch, 16);
+        for(uint16_t i = 0; i < n; i++) {
+            printf("%u 0x%2x %d\n", batch[i].timestamp, batch[i].addr,
+                   DS7505Protocol::rawToCenti(batch[i].temperature_raw));
+        }
+        sleep(1);
+    }
+}
+ */
+
+#ifndef _DS7505RING_H
+#define _DS7505RING_H
+
+#include <atomic>
+
+#include "DS7505.h"
+
+struct ds7505_record_t {
+    uint32_t timestamp;     // ms
+    uint8_t addr;           // 7-bit address
+    int16_t temperature_raw;
+};
+
+template <uint16_t SIZE, typename RECORD = ds7505_record_t>
+class DS7505Ring {
+    static_assert((SIZE & (SIZE - 1)) == 0, "DS7505Ring size must be a power of two");
+
+    public:
+        DS7505Ring(): _head(0), _tail(0), _dropped(0) {}
+
+        // producer side, false when full (the sample is dropped and counted)
+        bool push(const RECORD &record) {
+            uint32_t head = _head.load(std::memory_order_relaxed);
+            if(head - _tail.load(std::memory_order_acquire) == SIZE) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            _buffer[head & (SIZE - 1)] = record;
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool push(const DS7505 &sensor, uint32_t timestamp) {
+            RECORD record;
+            record.timestamp = timestamp;
+            record.addr = sensor.ds7505.addr;
+            record.temperature_raw = sensor.ds7505.temperature_raw;
+            return push(record);
+        }
+
+        // consumer side, copies up to max records, returns how many
+        uint16_t pop(RECORD *records, uint16_t max) {
+            uint32_t tail = _tail.load(std::memory_order_relaxed);
+            uint32_t available = _head.load(std::memory_order_acquire) - tail;
+            uint16_t n = available < max ? available : max;
+            for(uint16_t i = 0; i < n; i++) {
+                records[i] = _buffer[(tail + i) & (SIZE - 1)];
+            }
+            _tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        uint16_t size() const {
+            return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+        }
+
+        uint32_t dropped() const {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+    private:
+        RECORD _buffer[SIZE];
+        std::atomic<uint32_t> _head;    // written by the producer only
+        std::atomic<uint32_t> _tail;    // written by the consumer only
+        std::atomic<uint32_t> _dropped;
+};
+
+#endif
@@ -0,0 +1,74 @@
+/**
+Reads each sensor only when a new conversion is ready. The conversion time is
+taken from the cached config of every sensor (25/50/100/200 ms for 9..12 bits),
+add() and restart() read CONFIG when the shadow is not valid, run() retries
+a sensor that did not answer every 200 ms and reports it as failed. Call restart()
+after setConfigReg()/wakeUp(), the DS7505 starts a new conversion then.
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505 ds7505(i2c);
+DS7505Scheduler scheduler;
+
+// CLOCK_MONOTONIC in ms
+static uint32_t millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int main()
+{
+    ds7505.setConfigReg(DS7505::BITS_11);
+    scheduler.add(ds7505);
+    scheduler.restart(millis());
+    printf("%u mHz per sensor, %u mHz on the bus\n",
+           scheduler.sampleRateMilliHz(0), scheduler.busSampleRateMilliHz());
+    while(1) {
+        uint32_t now = millis();
+        if(scheduler.run(now) & 0x01) {
+            printf("value dec[C]: %f\n", ds7505.ds7505.temperature);
+        }
+        usleep(scheduler.nextDueMs(millis()) * 1000);
+    }
+}
+ */
+
+#ifndef _DS7505SCHEDULER_H
+#define _DS7505SCHEDULER_H
+
+#include "DS7505.h"
+
+#define DS7505_SCHED_MAX_SENSORS    8
+// one temperature read with the pointer already at TEMPER:
+// START, address + ACK, two data bytes + ACK/NACK, STOP
+#define DS7505_SCHED_READ_BITS      29
+#define DS7505_SCHED_IDLE           0xFFFFFFFF
+
+class DS7505Scheduler {
+    public:
+        DS7505Scheduler(uint32_t busFrequency = 100000);
+
+        int8_t add(DS7505 &sensor);
+        uint8_t count() const;
+
+        void restart(uint32_t nowMs);
+        void restart(uint8_t index, uint32_t nowMs);
+
+        // bit mask of the sensors (by index) that got a new sample, failed gets the
+        // ones that were due and did not answer
+        uint8_t run(uint32_t nowMs, uint8_t *failed = NULL);
+        uint32_t nextDueMs(uint32_t nowMs) const;
+
+        uint32_t sampleRateMilliHz(uint8_t index) const;
+        uint32_t busSampleRateMilliHz() const;
+    private:
+        DS7505 *_sensors[DS7505_SCHED_MAX_SENSORS];
+        uint32_t _due[DS7505_SCHED_MAX_SENSORS];
+        uint8_t _count;
+        uint32_t _busFrequency;
+
+        bool converting(uint8_t index) const;
+};
+
+#endif
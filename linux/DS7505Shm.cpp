@@ -0,0 +1,247 @@
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DS7505Shm.h"
+
+static_assert((DS7505_SHM_SLOTS & (DS7505_SHM_SLOTS - 1)) == 0,
+              "DS7505_SHM_SLOTS must be a power of two");
+
+// a record that stays odd this often belongs to a writer that died in publish()
+#define DS7505_SHM_TRIES    64
+
+// the same object is reused when it exists, readers that still map it see the new
+// generation and reopen; magic is only set once the header is complete
+DS7505ShmWriter::DS7505ShmWriter(const char *name): _shm(NULL)
+{
+    snprintf(_name, sizeof(_name), "%s", name);
+    int fd = shm_open(_name, O_RDWR | O_CREAT, 0644);
+    if(fd < 0) {
+        return;
+    }
+    if(ftruncate(fd, sizeof(ds7505_shm_t)) == 0) {
+        void *map = mmap(NULL, sizeof(ds7505_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(map != MAP_FAILED) {
+            _shm = (ds7505_shm_t *)map;
+        }
+    }
+    close(fd);
+    if(_shm == NULL) {
+        return;
+    }
+    uint32_t generation = __atomic_load_n(&_shm->generation, __ATOMIC_RELAXED) + 1;
+    __atomic_store_n(&_shm->magic, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&_shm->generation, generation, __ATOMIC_RELEASE);
+    __atomic_store_n(&_shm->sensors, 0, __ATOMIC_RELEASE);
+    memset(_shm->sensor, 0, sizeof(_shm->sensor));
+    _shm->version = DS7505_SHM_VERSION;
+    _shm->slots = DS7505_SHM_SLOTS;
+    _shm->size = sizeof(ds7505_shm_t);
+    _shm->period_ms = 0;
+    __atomic_store_n(&_shm->magic, DS7505_SHM_MAGIC, __ATOMIC_RELEASE);
+}
+
+DS7505ShmWriter::~DS7505ShmWriter(){
+    if(_shm != NULL) {
+        __atomic_store_n(&_shm->magic, 0, __ATOMIC_RELEASE);
+        munmap(_shm, sizeof(ds7505_shm_t));
+        shm_unlink(_name);
+    }
+}
+
+//----------PUBLIC FUNCTION
+bool DS7505ShmWriter::isOpen() const {
+    return _shm != NULL;
+};
+
+// the slot is filled before sensors is raised, readers never see a half added sensor
+int8_t DS7505ShmWriter::add(uint8_t adapter, uint8_t addr){
+    if(_shm == NULL) {
+        return DS7505_ERROR;
+    }
+    uint32_t index = __atomic_load_n(&_shm->sensors, __ATOMIC_RELAXED);
+    if(index == DS7505_SHM_MAX_SENSORS) {
+        return DS7505_ERROR;
+    }
+    _shm->sensor[index].adapter = adapter;
+    _shm->sensor[index].addr = addr;
+    __atomic_store_n(&_shm->sensors, index + 1, __ATOMIC_RELEASE);
+    return index;
+};
+
+void DS7505ShmWriter::period(uint32_t ms){
+    if(_shm != NULL) {
+        __atomic_store_n(&_shm->period_ms, ms, __ATOMIC_RELAXED);
+    }
+};
+
+// seqlock write of the slot at head, then head is moved on; one writer per region
+void DS7505ShmWriter::publish(uint8_t index, int8_t status, int16_t raw, uint8_t config,
+                              uint64_t timeNs){
+    if(_shm == NULL || index >= DS7505_SHM_MAX_SENSORS) {
+        return;
+    }
+    ds7505_shm_sensor_t &sensor = _shm->sensor[index];
+    uint32_t head = __atomic_load_n(&sensor.head, __ATOMIC_RELAXED);
+    ds7505_shm_record_t &slot = sensor.slot[head & (DS7505_SHM_SLOTS - 1)];
+    uint32_t seq = __atomic_load_n(&slot.seq, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&slot.seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot.sample = head;
+    slot.time_ns = timeNs;
+    slot.temperature_raw = raw;
+    slot.status = status;
+    slot.config = config;
+    __atomic_store_n(&slot.seq, seq + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&sensor.head, head + 1, __ATOMIC_RELEASE);
+};
+
+void DS7505ShmWriter::publish(uint8_t index, int8_t status, const DS7505 &sensor, uint64_t timeNs){
+    publish(index, status, sensor.ds7505.temperature_raw, sensor.ds7505.config, timeNs);
+};
+
+DS7505ShmReader::DS7505ShmReader(const char *name): _shm(NULL),
+                                                    _generation(0)
+{
+    snprintf(_name, sizeof(_name), "%s", name);
+    reopen();
+}
+
+DS7505ShmReader::~DS7505ShmReader(){
+    close();
+}
+
+//----------PUBLIC FUNCTION
+bool DS7505ShmReader::isOpen() const {
+    return _shm != NULL;
+};
+
+bool DS7505ShmReader::valid() const {
+    return _shm != NULL &&
+           __atomic_load_n(&_shm->magic, __ATOMIC_ACQUIRE) == DS7505_SHM_MAGIC &&
+           __atomic_load_n(&_shm->generation, __ATOMIC_ACQUIRE) == _generation;
+};
+
+// read-only mapping, the layout must match this build exactly
+int8_t DS7505ShmReader::reopen(){
+    struct stat st;
+    close();
+    int fd = shm_open(_name, O_RDONLY, 0);
+    if(fd < 0) {
+        return DS7505_ERROR;
+    }
+    if(fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(ds7505_shm_t)) {
+        void *map = mmap(NULL, sizeof(ds7505_shm_t), PROT_READ, MAP_SHARED, fd, 0);
+        if(map != MAP_FAILED) {
+            _shm = (const ds7505_shm_t *)map;
+        }
+    }
+    ::close(fd);
+    if(_shm == NULL) {
+        return DS7505_ERROR;
+    }
+    if(__atomic_load_n(&_shm->magic, __ATOMIC_ACQUIRE) != DS7505_SHM_MAGIC ||
+       _shm->version != DS7505_SHM_VERSION || _shm->slots != DS7505_SHM_SLOTS ||
+       _shm->size != sizeof(ds7505_shm_t)) {
+        close();
+        return DS7505_ERROR;
+    }
+    _generation = __atomic_load_n(&_shm->generation, __ATOMIC_ACQUIRE);
+    return DS7505_SUCCESS;
+};
+
+uint8_t DS7505ShmReader::sensors() const {
+    if(_shm == NULL) {
+        return 0;
+    }
+    return __atomic_load_n(&_shm->sensors, __ATOMIC_ACQUIRE);
+};
+
+uint32_t DS7505ShmReader::periodMs() const {
+    if(_shm == NULL) {
+        return 0;
+    }
+    return __atomic_load_n(&_shm->period_ms, __ATOMIC_RELAXED);
+};
+
+int8_t DS7505ShmReader::address(uint8_t index, uint8_t &adapter, uint8_t &addr) const {
+    if(index >= sensors()) {
+        return DS7505_ERROR;
+    }
+    adapter = _shm->sensor[index].adapter;
+    addr = _shm->sensor[index].addr;
+    return DS7505_SUCCESS;
+};
+
+int8_t DS7505ShmReader::latest(uint8_t index, ds7505_shm_record_t &record) const {
+    if(index >= sensors()) {
+        return DS7505_ERROR;
+    }
+    const ds7505_shm_sensor_t &sensor = _shm->sensor[index];
+    for(int i = 0; i < DS7505_SHM_TRIES; i++) {
+        uint32_t head = __atomic_load_n(&sensor.head, __ATOMIC_ACQUIRE);
+        if(head == 0) {
+            return DS7505_ERROR;
+        }
+        if(copy(sensor.slot[(head - 1) & (DS7505_SHM_SLOTS - 1)], record)) {
+            return DS7505_SUCCESS;
+        }
+    }
+    return DS7505_ERROR;
+};
+
+// a slot that is being written or holds a newer sample than expected was
+// overwritten by the writer, that sample is lost
+uint16_t DS7505ShmReader::read(uint8_t index, uint32_t &cursor, ds7505_shm_record_t *records,
+                               uint16_t max, uint32_t *lost) const {
+    uint16_t n = 0;
+    uint32_t missed = 0;
+    if(index < sensors()) {
+        const ds7505_shm_sensor_t &sensor = _shm->sensor[index];
+        uint32_t head = __atomic_load_n(&sensor.head, __ATOMIC_ACQUIRE);
+        if(head - cursor > DS7505_SHM_SLOTS) {
+            missed = head - DS7505_SHM_SLOTS - cursor;
+            cursor = head - DS7505_SHM_SLOTS;
+        }
+        while(n < max && cursor != head) {
+            if(copy(sensor.slot[cursor & (DS7505_SHM_SLOTS - 1)], records[n]) &&
+               records[n].sample == cursor) {
+                n++;
+            } else {
+                missed++;
+            }
+            cursor++;
+        }
+    }
+    if(lost != NULL) {
+        *lost = missed;
+    }
+    return n;
+};
+
+//------------PRIVATE FUNCTION
+void DS7505ShmReader::close(){
+    if(_shm != NULL) {
+        munmap((void *)_shm, sizeof(ds7505_shm_t));
+        _shm = NULL;
+    }
+};
+
+bool DS7505ShmReader::copy(const ds7505_shm_record_t &slot, ds7505_shm_record_t &record) const {
+    uint32_t seq = __atomic_load_n(&slot.seq, __ATOMIC_ACQUIRE);
+    if((seq & 1) != 0) {
+        return false;
+    }
+    record.sample = slot.sample;
+    record.time_ns = slot.time_ns;
+    record.temperature_raw = slot.temperature_raw;
+    record.status = slot.status;
+    record.config = slot.config;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    record.seq = __atomic_load_n(&slot.seq, __ATOMIC_RELAXED);
+    return record.seq == seq;
+};
@@ -0,0 +1,139 @@
+/**
+Shared-memory telemetry: one process owns the adapters and publishes every
+sample into a POSIX shared-memory object (shm_open + mmap), any number of
+processes map it read-only and read without syscalls or locks, so the bus
+traffic does not depend on how many consumers attach.
+The region has a fixed layout (ds7505_shm_t), versioned by magic and
+DS7505_SHM_VERSION. Every sensor has a ring of DS7505_SHM_SLOTS records and a
+free running head; each record is a seqlock, odd seq while the writer fills
+it, so a reader that races the writer retries instead of seeing a torn
+sample. A reader that falls more than DS7505_SHM_SLOTS samples behind skips
+ahead and gets the number of lost samples.
+generation changes with every writer, the writer clears magic when it goes
+away; valid() turns false then and the reader can reopen().
+example (writer, see ds7505d.cpp for the daemon):
+I2CDev i2c("/dev/i2c-1");
+DS7505Bus bus(i2c);
+DS7505Bus::sample_t samples[DS7505_BUS_MAX_SENSORS];
+DS7505ShmWriter shm;
+
+int main()
+{
+    bus.scan();
+    for(uint8_t i = 0; i < bus.count(); i++) {
+        shm.add(1, bus.sensor(i)->ds7505.addr);
+    }
+    while(1) {
+        bus.poll(samples);
+        for(uint8_t i = 0; i < bus.count(); i++) {
+            shm.publish(i, samples[i].status, *bus.sensor(i), nowNs());
+        }
+        sleep(1);
+    }
+}
+
+reader in any other process:
+DS7505ShmReader shm;
+ds7505_shm_record_t record;
+if(shm.latest(0, record) == DS7505_SUCCESS) {
+    printf("%d centi C\n", DS7505Protocol::rawToCenti(record.temperature_raw));
+}
+ */
+
+#ifndef _DS7505SHM_H
+#define _DS7505SHM_H
+
+#include "DS7505.h"
+
+#define DS7505_SHM_NAME         "/ds7505"
+#define DS7505_SHM_MAGIC        0x35375344      // "DS75"
+#define DS7505_SHM_VERSION      1
+#define DS7505_SHM_MAX_SENSORS  32
+// records per sensor, power of two
+#ifndef DS7505_SHM_SLOTS
+#define DS7505_SHM_SLOTS        64
+#endif
+
+struct ds7505_shm_record_t {
+    uint32_t seq;               // odd while the writer fills the record
+    uint32_t sample;            // number of the sample, counts from 0
+    uint64_t time_ns;           // CLOCK_MONOTONIC
+    int16_t temperature_raw;    // 1/256 degC per LSB
+    int8_t status;              // DS7505_SUCCESS or the error of the read
+    uint8_t config;             // config register at the time of the read
+};
+
+struct ds7505_shm_sensor_t {
+    uint8_t adapter;            // N of /dev/i2c-N
+    uint8_t addr;               // 7-bit address
+    uint16_t reserved;
+    uint32_t head;              // samples published so far
+    ds7505_shm_record_t slot[DS7505_SHM_SLOTS];
+};
+
+struct ds7505_shm_t {
+    uint32_t magic;             // written last by the writer, cleared when it exits
+    uint16_t version;
+    uint16_t slots;
+    uint32_t size;              // sizeof(ds7505_shm_t) of the writer
+    uint32_t generation;
+    uint32_t period_ms;
+    uint32_t sensors;
+    ds7505_shm_sensor_t sensor[DS7505_SHM_MAX_SENSORS];
+};
+
+class DS7505ShmWriter {
+    public:
+        DS7505ShmWriter(const char *name = DS7505_SHM_NAME);
+        // clears magic and unlinks the object, mapped readers keep the old region
+        ~DS7505ShmWriter();
+
+        bool isOpen() const;
+
+        // index of the new sensor or DS7505_ERROR when the region is full
+        int8_t add(uint8_t adapter, uint8_t addr);
+        void period(uint32_t ms);
+
+        void publish(uint8_t index, int8_t status, int16_t raw, uint8_t config, uint64_t timeNs);
+        void publish(uint8_t index, int8_t status, const DS7505 &sensor, uint64_t timeNs);
+    private:
+        char _name[64];
+        ds7505_shm_t *_shm;
+
+        DS7505ShmWriter(const DS7505ShmWriter &);
+        DS7505ShmWriter &operator=(const DS7505ShmWriter &);
+};
+
+class DS7505ShmReader {
+    public:
+        DS7505ShmReader(const char *name = DS7505_SHM_NAME);
+        ~DS7505ShmReader();
+
+        bool isOpen() const;
+        // false when the writer is gone or was restarted
+        bool valid() const;
+        int8_t reopen();
+
+        uint8_t sensors() const;
+        uint32_t periodMs() const;
+        int8_t address(uint8_t index, uint8_t &adapter, uint8_t &addr) const;
+
+        // newest sample, DS7505_ERROR when there is none yet
+        int8_t latest(uint8_t index, ds7505_shm_record_t &record) const;
+        // samples from cursor on, cursor is advanced; lost counts the samples
+        // that were overwritten before they were read
+        uint16_t read(uint8_t index, uint32_t &cursor, ds7505_shm_record_t *records,
+                      uint16_t max, uint32_t *lost = NULL) const;
+    private:
+        char _name[64];
+        const ds7505_shm_t *_shm;
+        uint32_t _generation;
+
+        void close();
+        bool copy(const ds7505_shm_record_t &slot, ds7505_shm_record_t &record) const;
+
+        DS7505ShmReader(const DS7505ShmReader &);
+        DS7505ShmReader &operator=(const DS7505ShmReader &);
+};
+
+#endif
@@ -0,0 +1,115 @@
+#include <linux/i2c.h>
+
+#include "DS7505Trace.h"
+
+DS7505TraceWriter::DS7505TraceWriter(const char *path): _file(fopen(path, "wb")),
+                                                        _records(0),
+                                                        _transfers(0)
+{
+    uint8_t header[DS7505_TRACE_HEADER] = {
+        DS7505_TRACE_MAGIC & 0xFF, (DS7505_TRACE_MAGIC >> 8) & 0xFF,
+        (DS7505_TRACE_MAGIC >> 16) & 0xFF, DS7505_TRACE_MAGIC >> 24,
+        DS7505_TRACE_VERSION & 0xFF, DS7505_TRACE_VERSION >> 8, 0, 0
+    };
+    if(_file != NULL && fwrite(header, sizeof(header), 1, _file) != 1) {
+        fclose(_file);
+        _file = NULL;
+    }
+}
+
+DS7505TraceWriter::~DS7505TraceWriter(){
+    if(_file != NULL) {
+        fclose(_file);
+    }
+}
+
+//----------PUBLIC FUNCTION
+bool DS7505TraceWriter::isOpen() const {
+    return _file != NULL;
+};
+
+// stdio buffers the records, a transfer costs no extra syscall
+void DS7505TraceWriter::record(uint32_t startUs, uint32_t durationUs, const struct i2c_msg *msgs,
+                               int count, int error){
+    if(_file == NULL) {
+        return;
+    }
+    uint16_t duration = durationUs > 0xFFFF ? 0xFFFF : durationUs;
+    for(int i = 0; i < count; i++) {
+        uint8_t length = msgs[i].len > 0xFF ? 0xFF : msgs[i].len;
+        uint8_t head[DS7505_TRACE_RECORD] = {
+            (uint8_t)startUs, (uint8_t)(startUs >> 8), (uint8_t)(startUs >> 16),
+            (uint8_t)(startUs >> 24), (uint8_t)duration, (uint8_t)(duration >> 8),
+            (uint8_t)msgs[i].addr,
+            (uint8_t)(((msgs[i].flags & I2C_M_RD) ? DS7505_TRACE_READ : 0) |
+                      (i + 1 < count ? DS7505_TRACE_MORE : 0)),
+            (uint8_t)(error > 0xFF ? 0xFF : error), length
+        };
+        fwrite(head, sizeof(head), 1, _file);
+        fwrite(msgs[i].buf, 1, length, _file);
+        _records++;
+    }
+    _transfers++;
+};
+
+uint32_t DS7505TraceWriter::records() const {
+    return _records;
+};
+
+uint32_t DS7505TraceWriter::transfers() const {
+    return _transfers;
+};
+
+void DS7505TraceWriter::flush(){
+    if(_file != NULL) {
+        fflush(_file);
+    }
+};
+
+DS7505TraceReader::DS7505TraceReader(const char *path): _file(fopen(path, "rb"))
+{
+    rewind();
+}
+
+DS7505TraceReader::~DS7505TraceReader(){
+    if(_file != NULL) {
+        fclose(_file);
+    }
+}
+
+//----------PUBLIC FUNCTION
+bool DS7505TraceReader::isOpen() const {
+    return _file != NULL;
+};
+
+int8_t DS7505TraceReader::next(ds7505_trace_msg_t &msg){
+    uint8_t head[DS7505_TRACE_RECORD];
+    if(_file == NULL || fread(head, sizeof(head), 1, _file) != 1) {
+        return DS7505_ERROR;
+    }
+    msg.timestamp_us = head[0] | (head[1] << 8) | (head[2] << 16) | ((uint32_t)head[3] << 24);
+    msg.duration_us = head[4] | (head[5] << 8);
+    msg.addr = head[6];
+    msg.flags = head[7];
+    msg.error = head[8];
+    msg.length = head[9];
+    if(fread(msg.data, 1, msg.length, _file) != msg.length) {
+        return DS7505_ERROR;
+    }
+    return DS7505_SUCCESS;
+};
+
+// a file with another magic or version is closed, isOpen() turns false
+void DS7505TraceReader::rewind(){
+    uint8_t header[DS7505_TRACE_HEADER];
+    if(_file == NULL) {
+        return;
+    }
+    ::rewind(_file);
+    if(fread(header, sizeof(header), 1, _file) != 1 ||
+       (header[0] | (header[1] << 8) | (header[2] << 16) | ((uint32_t)header[3] << 24)) !=
+       DS7505_TRACE_MAGIC || (header[4] | (header[5] << 8)) != DS7505_TRACE_VERSION) {
+        fclose(_file);
+        _file = NULL;
+    }
+};
@@ -0,0 +1,114 @@
+/**
+Binary trace of the bus transactions, to reproduce field issues and measure
+regressions on a host without the hardware.
+Recording: I2CDev::trace() hands every transfer (one I2C_RDWR ioctl) to a
+DS7505TraceWriter, which covers all the driver's read/write helpers and the
+multi-sensor transfers of DS7505Bus. Every message of a transfer is one
+record: start time and duration of the transfer, address, direction, the
+bytes written or read and the errno of the transfer (0 on success).
+Replay: link I2CDevReplay.cpp instead of I2CDev.cpp and open the trace file
+as the adapter. Every transfer of the driver is matched against the next
+recorded one (address, direction, lengths and written bytes), the recorded
+read bytes and errno come back and ds7505_now_us() follows the recorded
+times, so the driver runs exactly as in the field. A transfer that does
+not match fails with EPROTO and counts as a mismatch in
+ds7505_replay_stats().
+ds7505trace prints the transactions, errors and latency of a trace.
+File: 8-byte header (magic "D5TR", version, reserved), then the records,
+little endian:
+    timestamp_us u32 | duration_us u16 | addr u8 | flags u8 | error u8 | length u8 | data
+example:
+I2CDev i2c("/dev/i2c-1");
+DS7505TraceWriter trace("/var/tmp/ds7505.trace");
+DS7505 ds7505(i2c);
+
+int main()
+{
+    i2c.trace(&trace);
+    while(1) {
+        ds7505.getTemp();
+        sleep(1);
+    }
+}
+ */
+
+#ifndef _DS7505TRACE_H
+#define _DS7505TRACE_H
+
+#include <stdio.h>
+
+#include "DS7505.h"
+
+#define DS7505_TRACE_MAGIC      0x52543544      // "D5TR"
+#define DS7505_TRACE_VERSION    1
+#define DS7505_TRACE_HEADER     8
+#define DS7505_TRACE_RECORD     10              // without data
+// message flags
+#define DS7505_TRACE_READ       0x01
+#define DS7505_TRACE_MORE       0x02            // next record is in the same transfer (repeated start)
+
+struct i2c_msg;
+
+struct ds7505_trace_msg_t {
+    uint32_t timestamp_us;      // start of the transfer
+    uint16_t duration_us;       // of the whole transfer, 0xFFFF when longer
+    uint8_t addr;               // 7-bit address
+    uint8_t flags;              // DS7505_TRACE_READ | DS7505_TRACE_MORE
+    uint8_t error;              // errno of the transfer, 0 on success
+    uint8_t length;
+    uint8_t data[255];
+};
+
+// what the replay did so far
+struct ds7505_replay_stats_t {
+    uint32_t transfers;         // matched the trace
+    uint32_t mismatches;        // failed with EPROTO, the driver left the recorded path
+    uint32_t errors;            // recorded failures handed back to the driver
+    uint32_t bus_us;            // recorded duration of the matched transfers
+    uint32_t left;              // records not replayed yet
+};
+
+class DS7505TraceWriter {
+    public:
+        DS7505TraceWriter(const char *path);
+        // flushes and closes the file
+        ~DS7505TraceWriter();
+
+        bool isOpen() const;
+        // one transfer, error is errno of a failed one or 0; not thread safe,
+        // one writer per I2CDev when the adapters run in their own threads
+        void record(uint32_t startUs, uint32_t durationUs, const struct i2c_msg *msgs, int count,
+                    int error);
+        uint32_t records() const;
+        uint32_t transfers() const;
+        void flush();
+    private:
+        FILE *_file;
+        uint32_t _records;
+        uint32_t _transfers;
+
+        DS7505TraceWriter(const DS7505TraceWriter &);
+        DS7505TraceWriter &operator=(const DS7505TraceWriter &);
+};
+
+class DS7505TraceReader {
+    public:
+        DS7505TraceReader(const char *path);
+        ~DS7505TraceReader();
+
+        // false when the file is missing or not a trace of this version
+        bool isOpen() const;
+        // next record, DS7505_ERROR at the end or on a truncated record
+        int8_t next(ds7505_trace_msg_t &msg);
+        void rewind();
+    private:
+        FILE *_file;
+
+        DS7505TraceReader(const DS7505TraceReader &);
+        DS7505TraceReader &operator=(const DS7505TraceReader &);
+};
+
+// defined by I2CDevReplay.cpp only
+void ds7505_replay_stats(ds7505_replay_stats_t &stats);
+
+#endif
@@ -0,0 +1,98 @@
+#include "I2CDev.h"
+#include "DS7505Trace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+static uint32_t nowUs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(now.tv_sec * 1000000ULL + now.tv_nsec / 1000);
+}
+
+I2CDev::I2CDev(const char *path): _fd(open(path, O_RDWR | O_CLOEXEC)),
+                                  _trace(NULL)
+{
+}
+
+I2CDev::~I2CDev(){
+    if(_fd >= 0) {
+        close(_fd);
+    }
+}
+
+bool I2CDev::isOpen() const {
+    return _fd >= 0;
+}
+
+int I2CDev::fd() const {
+    return _fd;
+}
+
+int I2CDev::setTimeout(uint32_t ms){
+    return ioctl(_fd, I2C_TIMEOUT, (unsigned long)((ms + 9) / 10)) == 0 ? 0 : -1;
+}
+
+void I2CDev::trace(DS7505TraceWriter *writer){
+    _trace = writer;
+}
+
+int I2CDev::write(uint8_t address, const char *data, int length){
+    struct i2c_msg msg;
+    msg.addr = address;
+    msg.flags = 0;
+    msg.len = length;
+    msg.buf = (uint8_t *)data;
+
+    return rdwr(&msg, 1);
+}
+
+int I2CDev::read(uint8_t address, char *data, int length){
+    struct i2c_msg msg;
+    msg.addr = address;
+    msg.flags = I2C_M_RD;
+    msg.len = length;
+    msg.buf = (uint8_t *)data;
+
+    return rdwr(&msg, 1);
+}
+
+int I2CDev::writeRead(uint8_t address, const char *wdata, int wlength,
+                      char *rdata, int rlength){
+    struct i2c_msg msgs[2];
+    msgs[0].addr = address;
+    msgs[0].flags = 0;
+    msgs[0].len = wlength;
+    msgs[0].buf = (uint8_t *)wdata;
+    msgs[1].addr = address;
+    msgs[1].flags = I2C_M_RD;
+    msgs[1].len = rlength;
+    msgs[1].buf = (uint8_t *)rdata;
+
+    return rdwr(msgs, 2);
+}
+
+int I2CDev::transfer(struct i2c_msg *msgs, int count){
+    return rdwr(msgs, count);
+}
+
+// every transfer is one ioctl, recorded with its duration when a trace is set;
+// errno is kept for the caller
+int I2CDev::rdwr(struct i2c_msg *msgs, int count){
+    struct i2c_rdwr_ioctl_data xfer = { msgs, (uint32_t)count };
+    if(_trace == NULL) {
+        return ioctl(_fd, I2C_RDWR, &xfer) == count ? 0 : -1;
+    }
+    uint32_t start = nowUs();
+    int ret = ioctl(_fd, I2C_RDWR, &xfer) == count ? 0 : -1;
+    int error = ret == 0 ? 0 : errno;
+    _trace->record(start, nowUs() - start, msgs, count, error);
+    errno = error;
+    return ret;
+}
@@ -0,0 +1,53 @@
+/**
+Thin wrapper around a Linux /dev/i2c-N adapter. Every transfer goes out as
+a single I2C_RDWR ioctl, so a pointer write followed by a data read is sent
+as one bus transaction with a repeated start and costs one syscall.
+One I2CDev can be shared by all sensors on the same adapter, the slave
+address is passed with every transfer.
+setTimeout() bounds how long the adapter waits for a transfer (I2C_TIMEOUT,
+10 ms steps, the default is one second on most adapters); it applies to the
+whole adapter, not to this file descriptor only.
+trace() records every transfer into a DS7505TraceWriter (DS7505Trace.h).
+ */
+
+#ifndef _I2CDEV_H
+#define _I2CDEV_H
+
+#include <stdint.h>
+
+struct i2c_msg;
+class DS7505TraceWriter;
+
+// CLOCK_MONOTONIC in us, weak so a test harness can supply its own clock
+uint32_t ds7505_now_us();
+// nanosleep(), weak like ds7505_now_us()
+void ds7505_sleep_ms(uint32_t ms);
+
+class I2CDev {
+    public:
+        I2CDev(const char *path);
+        ~I2CDev();
+
+        bool isOpen() const;
+        int fd() const;
+        int setTimeout(uint32_t ms);
+        // NULL stops the recording
+        void trace(DS7505TraceWriter *writer);
+
+        int write(uint8_t address, const char *data, int length);
+        int read(uint8_t address, char *data, int length);
+        int writeRead(uint8_t address, const char *wdata, int wlength,
+                      char *rdata, int rlength);
+        // any sequence of messages, repeated start in between, one STOP at the end
+        int transfer(struct i2c_msg *msgs, int count);
+    private:
+        int _fd;
+        DS7505TraceWriter *_trace;
+
+        int rdwr(struct i2c_msg *msgs, int count);
+
+        I2CDev(const I2CDev &);
+        I2CDev &operator=(const I2CDev &);
+};
+
+#endif
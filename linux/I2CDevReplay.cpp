@@ -0,0 +1,190 @@
+/**
+Replay implementation of I2CDev.h. Link this file instead of I2CDev.cpp and
+pass a trace file (DS7505Trace.h) as the adapter path: the driver runs on a
+host without hardware and sees exactly the answers, errors and timing of
+the recording. One trace per process, every I2CDev opened on it replays
+from the same position, as the sensors shared the adapter when recorded.
+Each transfer has to match the next recorded one (address, direction,
+lengths, written bytes); a transfer that does not match fails with EPROTO
+and leaves the trace where it is, so the driver can get back on the
+recorded path. At the end of the trace every transfer fails with ENODATA.
+ds7505_now_us() is the recorded time: the start of the last transfer plus
+its duration, moved on by ds7505_sleep_ms().
+ */
+
+#include "I2CDev.h"
+#include "DS7505Trace.h"
+
+#include <errno.h>
+#include <string.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+static DS7505TraceReader *reader = NULL;
+static int users = 0;
+static ds7505_trace_msg_t recorded[I2C_RDWR_IOCTL_MAX_MSGS];
+static int recordedCount = 0;      // messages of the next recorded transfer, 0 when not loaded
+static uint32_t clockUs = 0;
+static bool clockSet = false;
+static ds7505_replay_stats_t stats;
+
+// messages up to the first one without DS7505_TRACE_MORE
+static bool loadTransfer()
+{
+    if(recordedCount > 0) {
+        return true;
+    }
+    while(recordedCount < I2C_RDWR_IOCTL_MAX_MSGS &&
+          reader->next(recorded[recordedCount]) == DS7505_SUCCESS) {
+        if((recorded[recordedCount++].flags & DS7505_TRACE_MORE) == 0) {
+            return true;
+        }
+    }
+    recordedCount = 0;
+    return false;
+}
+
+static bool matches(const struct i2c_msg *msgs, int count)
+{
+    if(count != recordedCount) {
+        return false;
+    }
+    for(int i = 0; i < count; i++) {
+        bool read = (msgs[i].flags & I2C_M_RD) != 0;
+        if(msgs[i].addr != recorded[i].addr || msgs[i].len != recorded[i].length ||
+           read != ((recorded[i].flags & DS7505_TRACE_READ) != 0)) {
+            return false;
+        }
+        if(!read && memcmp(msgs[i].buf, recorded[i].data, msgs[i].len) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t ds7505_now_us()
+{
+    return clockUs;
+}
+
+void ds7505_sleep_ms(uint32_t ms)
+{
+    clockUs += ms * 1000;
+}
+
+void ds7505_replay_stats(ds7505_replay_stats_t &copy)
+{
+    copy = stats;
+}
+
+// the records are counted once, then the reader starts over
+I2CDev::I2CDev(const char *path): _fd(-1),
+                                  _trace(NULL)
+{
+    if(reader == NULL) {
+        ds7505_trace_msg_t msg;
+        reader = new DS7505TraceReader(path);
+        memset(&stats, 0, sizeof(stats));
+        while(reader->next(msg) == DS7505_SUCCESS) {
+            stats.left++;
+        }
+        reader->rewind();
+        recordedCount = 0;
+        clockSet = false;
+    }
+    users++;
+    if(reader->isOpen()) {
+        _fd = 0;
+    }
+}
+
+I2CDev::~I2CDev(){
+    if(--users == 0) {
+        delete reader;
+        reader = NULL;
+    }
+}
+
+bool I2CDev::isOpen() const {
+    return _fd >= 0;
+}
+
+int I2CDev::fd() const {
+    return _fd;
+}
+
+// the recorded transfers already carry the timeout of the field
+int I2CDev::setTimeout(uint32_t ms){
+    (void)ms;
+    return 0;
+}
+
+void I2CDev::trace(DS7505TraceWriter *writer){
+    _trace = writer;
+}
+
+int I2CDev::write(uint8_t address, const char *data, int length){
+    struct i2c_msg msg = { address, 0, (uint16_t)length, (uint8_t *)data };
+    return rdwr(&msg, 1);
+}
+
+int I2CDev::read(uint8_t address, char *data, int length){
+    struct i2c_msg msg = { address, I2C_M_RD, (uint16_t)length, (uint8_t *)data };
+    return rdwr(&msg, 1);
+}
+
+int I2CDev::writeRead(uint8_t address, const char *wdata, int wlength,
+                      char *rdata, int rlength){
+    struct i2c_msg msgs[2] = {
+        { address, 0, (uint16_t)wlength, (uint8_t *)wdata },
+        { address, I2C_M_RD, (uint16_t)rlength, (uint8_t *)rdata }
+    };
+    return rdwr(msgs, 2);
+}
+
+int I2CDev::transfer(struct i2c_msg *msgs, int count){
+    return rdwr(msgs, count);
+}
+
+// a trace set on the replay records the replayed transfers again, to compare two runs
+int I2CDev::rdwr(struct i2c_msg *msgs, int count){
+    if(_fd < 0) {
+        errno = EBADF;
+        return -1;
+    }
+    if(!loadTransfer()) {
+        stats.mismatches++;
+        errno = ENODATA;
+        return -1;
+    }
+    if(!matches(msgs, count)) {
+        stats.mismatches++;
+        errno = EPROTO;
+        return -1;
+    }
+    const ds7505_trace_msg_t &first = recorded[0];
+    if(!clockSet || (int32_t)(first.timestamp_us - clockUs) > 0) {
+        clockUs = first.timestamp_us;
+        clockSet = true;
+    }
+    uint32_t start = clockUs;
+    for(int i = 0; i < count; i++) {
+        if(msgs[i].flags & I2C_M_RD) {
+            memcpy(msgs[i].buf, recorded[i].data, msgs[i].len);
+        }
+    }
+    clockUs += first.duration_us;
+    int error = first.error;
+    stats.transfers++;
+    stats.bus_us += first.duration_us;
+    stats.left -= count;
+    if(error != 0) {
+        stats.errors++;
+    }
+    recordedCount = 0;
+    if(_trace != NULL) {
+        _trace->record(start, first.duration_us, msgs, count, error);
+    }
+    errno = error;
+    return error == 0 ? 0 : -1;
+}
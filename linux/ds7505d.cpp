@@ -0,0 +1,141 @@
+/**
+ds7505d - owns the DS7505 sensors of one or more i2c-dev adapters and
+publishes every sample into shared memory (DS7505Shm.h), so any number of
+processes read the temperatures without touching the bus.
+usage: ds7505d [-n /name] [-p period_ms] adapter...
+    ds7505d 1 3         sensors on /dev/i2c-1 and /dev/i2c-3
+Every adapter is scanned once (0x48..0x4F), all sensors of an adapter are
+read in one I2C_RDWR ioctl per cycle. The default period is the longest
+conversion time of the sensors found, so every cycle reads new conversions.
+SIGINT/SIGTERM remove the shared-memory object.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "I2CDev.h"
+#include "DS7505.h"
+#include "DS7505Bus.h"
+#include "DS7505Shm.h"
+
+#define DS7505D_MAX_ADAPTERS    (DS7505_SHM_MAX_SENSORS / DS7505_BUS_MAX_SENSORS)
+
+static volatile sig_atomic_t running = 1;
+
+static void onSignal(int sig)
+{
+    (void)sig;
+    running = 0;
+}
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void usage()
+{
+    fprintf(stderr, "usage: ds7505d [-n /name] [-p period_ms] adapter...\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = DS7505_SHM_NAME;
+    uint32_t periodMs = 0;
+    int opt;
+    while((opt = getopt(argc, argv, "n:p:h")) != -1) {
+        switch(opt) {
+            case 'n':
+                name = optarg;
+                break;
+            case 'p':
+                periodMs = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+    int adapters = argc - optind;
+    if(adapters < 1 || adapters > DS7505D_MAX_ADAPTERS) {
+        usage();
+        return 1;
+    }
+
+    DS7505ShmWriter shm(name);
+    if(!shm.isOpen()) {
+        perror("shm_open");
+        return 1;
+    }
+
+    I2CDev *i2c[DS7505D_MAX_ADAPTERS];
+    DS7505Bus *bus[DS7505D_MAX_ADAPTERS];
+    uint8_t first[DS7505D_MAX_ADAPTERS];
+    uint16_t longest = 0;
+    for(int a = 0; a < adapters; a++) {
+        char path[32];
+        uint8_t number = strtoul(argv[optind + a], NULL, 0);
+        snprintf(path, sizeof(path), "/dev/i2c-%u", number);
+        i2c[a] = new I2CDev(path);
+        bus[a] = new DS7505Bus(*i2c[a]);
+        if(!i2c[a]->isOpen()) {
+            perror(path);
+            continue;
+        }
+        bus[a]->scan();
+        for(uint8_t i = 0; i < bus[a]->count(); i++) {
+            DS7505 *sensor = bus[a]->sensor(i);
+            int8_t index = shm.add(number, sensor->ds7505.addr);
+            if(i == 0) {
+                first[a] = index;
+            }
+            // the resolution comes from CONFIG, read when the shadow is not valid
+            if(sensor->getConfigRegCached() == DS7505_SUCCESS) {
+                uint16_t ms = DS7505::conversionTimeMs(sensor->ds7505.config);
+                longest = ms > longest ? ms : longest;
+            }
+            printf("%s 0x%02x -> %s[%d]\n", path, sensor->ds7505.addr, name, index);
+        }
+    }
+    if(periodMs == 0) {
+        periodMs = longest ? longest : 1000;
+    }
+    shm.period(periodMs);
+
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    // absolute deadlines, the period does not drift with the time spent on the bus
+    DS7505Bus::sample_t samples[DS7505_BUS_MAX_SENSORS];
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while(running) {
+        for(int a = 0; a < adapters; a++) {
+            if(bus[a]->count() == 0) {
+                continue;
+            }
+            bus[a]->poll(samples);
+            uint64_t time = nowNs();
+            for(uint8_t i = 0; i < bus[a]->count(); i++) {
+                shm.publish(first[a] + i, samples[i].status, *bus[a]->sensor(i), time);
+            }
+        }
+        next.tv_nsec += (long)(periodMs % 1000) * 1000000L;
+        next.tv_sec += periodMs / 1000 + next.tv_nsec / 1000000000L;
+        next.tv_nsec %= 1000000000L;
+        while(running && clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR) {
+        }
+    }
+
+    for(int a = 0; a < adapters; a++) {
+        delete bus[a];
+        delete i2c[a];
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ds7505trace - summary of bus traces recorded with I2CDev::trace()
+(DS7505Trace.h), to compare captures of two driver versions or of a field
+unit against the bench.
+usage: ds7505trace [-d] trace...
+    -d      print every message as well
+Per trace: transfers, messages and bytes, failed transfers by errno, the
+messages per address, the bus time per transfer (mean, max and a
+histogram < 64 us, doubling up to >= 4 ms) and the transfer rate over the
+recorded time.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "DS7505Trace.h"
+
+#define DS7505TRACE_BUCKETS     8
+#define DS7505TRACE_BUCKET0_US  64
+
+struct summary_t {
+    uint32_t transfers;
+    uint32_t messages;
+    uint32_t bytes;
+    uint32_t failed;
+    uint32_t errors[256];               // by errno
+    uint32_t addresses[128];            // messages by 7-bit address
+    uint64_t totalUs;
+    uint32_t maxUs;
+    uint32_t latency[DS7505TRACE_BUCKETS];
+    uint32_t firstUs;
+    uint32_t lastUs;
+};
+
+static void usage()
+{
+    fprintf(stderr, "usage: ds7505trace [-d] trace...\n");
+}
+
+static void dump(const ds7505_trace_msg_t &msg)
+{
+    printf("%10u us %5u us 0x%02x %c%s err %3u:", msg.timestamp_us, msg.duration_us, msg.addr,
+           (msg.flags & DS7505_TRACE_READ) ? 'R' : 'W', (msg.flags & DS7505_TRACE_MORE) ? "+" : " ",
+           msg.error);
+    for(uint8_t i = 0; i < msg.length; i++) {
+        printf(" %02x", msg.data[i]);
+    }
+    printf("\n");
+}
+
+// the first message of a transfer carries its time and result
+static void add(summary_t &summary, const ds7505_trace_msg_t &msg, bool first)
+{
+    summary.messages++;
+    summary.bytes += msg.length;
+    summary.addresses[msg.addr & 0x7F]++;
+    if(!first) {
+        return;
+    }
+    if(summary.transfers == 0) {
+        summary.firstUs = msg.timestamp_us;
+    }
+    summary.lastUs = msg.timestamp_us + msg.duration_us;
+    summary.transfers++;
+    if(msg.error != 0) {
+        summary.failed++;
+        summary.errors[msg.error]++;
+    }
+    summary.totalUs += msg.duration_us;
+    if(msg.duration_us > summary.maxUs) {
+        summary.maxUs = msg.duration_us;
+    }
+    uint8_t bucket = 0;
+    for(uint32_t limit = DS7505TRACE_BUCKET0_US;
+        bucket < DS7505TRACE_BUCKETS - 1 && msg.duration_us >= limit; limit <<= 1) {
+        bucket++;
+    }
+    summary.latency[bucket]++;
+}
+
+static void print(const char *path, const summary_t &summary)
+{
+    uint32_t spanUs = summary.lastUs - summary.firstUs;
+    printf("%s: %u transfers, %u messages, %u bytes, %u failed\n", path, summary.transfers,
+           summary.messages, summary.bytes, summary.failed);
+    for(int e = 1; e < 256; e++) {
+        if(summary.errors[e] != 0) {
+            printf("  errno %d (%s): %u\n", e, strerror(e), summary.errors[e]);
+        }
+    }
+    for(int a = 0; a < 128; a++) {
+        if(summary.addresses[a] != 0) {
+            printf("  0x%02x: %u messages\n", a, summary.addresses[a]);
+        }
+    }
+    if(summary.transfers == 0) {
+        return;
+    }
+    printf("  bus time %.1f us mean, %u us max, histogram", (double)summary.totalUs / summary.transfers,
+           summary.maxUs);
+    for(int b = 0; b < DS7505TRACE_BUCKETS; b++) {
+        printf(" %u", summary.latency[b]);
+    }
+    printf("\n  %.3f s recorded, %.1f transfers/s\n", spanUs / 1e6,
+           spanUs ? summary.transfers * 1e6 / spanUs : 0.0);
+}
+
+int main(int argc, char **argv)
+{
+    bool verbose = false;
+    int opt;
+    while((opt = getopt(argc, argv, "dh")) != -1) {
+        switch(opt) {
+            case 'd':
+                verbose = true;
+                break;
+            default:
+                usage();
+                return 1;
+        }
+    }
+    if(optind == argc) {
+        usage();
+        return 1;
+    }
+
+    int ret = 0;
+    static summary_t summary;
+    for(int f = optind; f < argc; f++) {
+        DS7505TraceReader trace(argv[f]);
+        if(!trace.isOpen()) {
+            fprintf(stderr, "%s: not a trace\n", argv[f]);
+            ret = 1;
+            continue;
+        }
+        memset(&summary, 0, sizeof(summary));
+        ds7505_trace_msg_t msg;
+        bool first = true;
+        while(trace.next(msg) == DS7505_SUCCESS) {
+            if(verbose) {
+                dump(msg);
+            }
+            add(summary, msg, first);
+            first = (msg.flags & DS7505_TRACE_MORE) == 0;
+        }
+        print(argv[f], summary);
+    }
+    return ret;
+}
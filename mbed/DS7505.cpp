@@ -1,23 +1,37 @@
+#include <new>
+
 #include "DS7505.h"
 
 DS7505::DS7505(PinName sda, PinName scl, uint8_t addr): pI2C(new I2C(sda, scl)),
-                                                        _I2C(*pI2C)
+                                                        _I2C(*pI2C),
+                                                        _bus(_I2C),
+                                                        _core(_bus, addr),
+                                                        ds7505(_core.state()),
+                                                        _sda(sda),
+                                                        _scl(scl),
+                                                        _hz(100000)
 {
-    ds7505.addr = addr << 1;
-    ds7505.config = 0;
-    ds7505.temp_hyst = 0;
-    ds7505.temp_os = 0;
-    ds7505.temperature = 0;
+#if DEVICE_I2C_ASYNCH
+    core_util_atomic_flag_clear(&_asyncBusy);
+#endif
+    _seq = 0;
+    memset(&_latest, 0, sizeof(_latest));
 }
 
 DS7505::DS7505(I2C &i2c, uint8_t addr): pI2C(NULL),
-                                        _I2C(i2c)
+                                        _I2C(i2c),
+                                        _bus(_I2C),
+                                        _core(_bus, addr),
+                                        ds7505(_core.state()),
+                                        _sda(NC),
+                                        _scl(NC),
+                                        _hz(100000)
 {
-    ds7505.addr = addr << 1;
-    ds7505.config = 0;
-    ds7505.temp_hyst = 0;
-    ds7505.temp_os = 0;
-    ds7505.temperature = 0;
+#if DEVICE_I2C_ASYNCH
+    core_util_atomic_flag_clear(&_asyncBusy);
+#endif
+    _seq = 0;
+    memset(&_latest, 0, sizeof(_latest));
 }
 
 DS7505::~DS7505(){
@@ -27,180 +41,345 @@ DS7505::~DS7505(){
 }
 
 //----------PUBLIC FUNCTION
+// every call into the core holds the I2C lock, so the pointer cache and the
+// shadow move together with the bus calls
 int8_t DS7505::getConfigReg() {
-    char config = 0;
-    if(write(DS7505::CONFIG) == DS7505_SUCCESS) {
-        if(read(&config, 1) == DS7505_SUCCESS) {
-            ds7505.config = config;
-            return DS7505_SUCCESS;
-        }
-    }
-    return DS7505_ERROR;
+    ScopedLock<I2C> lock(_I2C);
+    return _core.getConfigReg();
+};
+
+int8_t DS7505::getConfigRegCached() {
+    ScopedLock<I2C> lock(_I2C);
+    return _core.getConfigRegCached();
 };
 
 int8_t DS7505::setConfigReg(DS7505::eResolution resolution, 
                             DS7505::eFault_Tolerance tolerance, 
                             DS7505::eTermostat_Out_Polarity polarity, 
                             DS7505::eTermostat_Mode mode) {
-    char data = resolution | tolerance | polarity | mode;
-    if(write(DS7505::CONFIG, &data, 2) == DS7505_SUCCESS) {
-        return getConfigReg();
-    }
-    return DS7505_ERROR;
+    uint8_t config = (uint8_t)resolution | (uint8_t)tolerance | (uint8_t)polarity | (uint8_t)mode;
+    ScopedLock<I2C> lock(_I2C);
+    return _core.setConfig(config);
+};
+
+int8_t DS7505::setResolution(DS7505::eResolution resolution){
+    ScopedLock<I2C> lock(_I2C);
+    return _core.setResolution(resolution);
 };
 
 int8_t DS7505::getTemp(){
-    if(getTemperatureReg(TEMPER) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
+    ScopedLock<I2C> lock(_I2C);
+    if(_core.getTemp() != DS7505_SUCCESS) {
+        return DS7505_ERROR;
     }
-    return DS7505_ERROR;
+    publish(ds7505.temperature_raw);
+    return DS7505_SUCCESS;
 };
 
-int8_t DS7505::getTempOS(){
-    if(getTemperatureReg(T_OS) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
+// the failed attempt is the estimate for the next one, the budget is checked before every
+// attempt and every recovery. After a failure SDA is sampled, the bus is only recovered when
+// a slave holds it low; a plain NACK (missing sensor) is just retried
+int8_t DS7505::getTempWithin(uint32_t budgetUs, uint8_t retries){
+    uint32_t start = us_ticker_read();
+    uint32_t attemptUs = 0;
+    for(uint8_t attempt = 0; ; attempt++) {
+        uint32_t attemptStart = us_ticker_read();
+        if(attemptStart - start + attemptUs > budgetUs) {
+            return DS7505_ERROR_DEADLINE;
+        }
+#ifdef DS7505_INSTRUMENT
+        if(attempt > 0) {
+            _bus.retried(DS7505Protocol::OP_DATA_READ);
+        }
+#endif
+        if(getTemp() == DS7505_SUCCESS) {
+            return DS7505_SUCCESS;
+        }
+        uint32_t now = us_ticker_read();
+        attemptUs = now - attemptStart;
+        if(pI2C != NULL && sdaHeld()) {
+            if(us_ticker_read() - start + DS7505_RECOVERY_US > budgetUs) {
+                return DS7505_ERROR_DEADLINE;
+            }
+            if(recoverBus() == DS7505_ERROR_BUS) {
+                return DS7505_ERROR_BUS;
+            }
+        }
+        if(attempt == retries) {
+            return DS7505_ERROR;
+        }
     }
-    return DS7505_ERROR;
+};
+
+int8_t DS7505::getTempOS(){
+    ScopedLock<I2C> lock(_I2C);
+    return _core.getTempOS();
 };
 
 int8_t DS7505::getTempHYST(){
-    if(getTemperatureReg(T_HYST) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
-    }
-    return DS7505_ERROR;
+    ScopedLock<I2C> lock(_I2C);
+    return _core.getTempHYST();
+};
+
+int8_t DS7505::setTempOSRaw(int16_t tempOS) {
+    ScopedLock<I2C> lock(_I2C);
+    return _core.setTempOSRaw(tempOS);
+};
+
+int8_t DS7505::setTempHystRaw(int16_t tempHYST){
+    ScopedLock<I2C> lock(_I2C);
+    return _core.setTempHystRaw(tempHYST);
+};
+
+int8_t DS7505::setTempOSCenti(int32_t tempOS) {
+    return setTempOSRaw(DS7505Protocol::centiToRaw(tempOS));
+};
+
+int8_t DS7505::setTempHystCenti(int32_t tempHYST){
+    return setTempHystRaw(DS7505Protocol::centiToRaw(tempHYST));
 };
 
+#ifndef DS7505_NO_FLOAT
 int8_t DS7505::setTempOS(float tempOS) {
-    if(setTOSorHYST(T_OS, tempOS) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
-    }
-    return DS7505_ERROR;
+    return setTempOSRaw(tempOS * 256);
 };
 
 int8_t DS7505::setTempHyst(float tempHYST){
-    if(setTOSorHYST(T_HYST, tempHYST) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
-    }
-    return DS7505_ERROR;
+    return setTempHystRaw(tempHYST * 256);
 };
+#endif
 
 int8_t DS7505::copySRAMtoEPRROM(){
-    if(write(COPY_DATA) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
-    }
-    return DS7505_ERROR;
+    ScopedLock<I2C> lock(_I2C);
+    return _core.copySRAMtoEPRROM();
 };
 
-void DS7505::softwarePOR(){
-    write(SOFTWARE_POR);
+int8_t DS7505::softwarePOR(){
+    ScopedLock<I2C> lock(_I2C);
+    return _core.softwarePOR();
 };
 
 int8_t DS7505::recallData(){
-    if(write(RECALL_DATA) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
-    }
-    return DS7505_ERROR;
+    ScopedLock<I2C> lock(_I2C);
+    return _core.recallData();
 };
 
 bool DS7505::memoryBusy(){
-    if(getConfigReg() == DS7505_SUCCESS) {
-        uint8_t temp = ds7505.config & WRITE_IN_PROGRESS;
-        if(temp == WRITE_IN_PROGRESS) {
-            return true;
-        }
-    }
-    return false;
+    ScopedLock<I2C> lock(_I2C);
+    return _core.memoryBusy();
+};
+
+int8_t DS7505::applyProfile(const profile_t &profile, bool commit){
+    ScopedLock<I2C> lock(_I2C);
+    return _core.applyProfile(profile, commit);
 };
 
 int8_t DS7505::shutDown(){
-    return shutMode(SHUTDOWN);
+    ScopedLock<I2C> lock(_I2C);
+    return _core.shutDown();
 };
 
 int8_t DS7505::wakeUp(){
-    return shutMode(ACTIVE_CONVER);
+    ScopedLock<I2C> lock(_I2C);
+    return _core.wakeUp();
 }
 
-//------------PRIVATE FUNCTION
-int8_t DS7505::shutMode(DS7505::eShutdown mode){
-    if(getConfigReg() == DS7505_SUCCESS) {
-        char newReg = 0;
-        if(mode == ACTIVE_CONVER) {
-            newReg = ds7505.config & 0xFE;
-        } else {
-            newReg = ds7505.config | 0x01;
-        }
-        if(write(DS7505::CONFIG, &newReg, 2) == DS7505_SUCCESS) {
-            return DS7505_SUCCESS;
-        }
-    }
-    return DS7505_ERROR;
-}
-int8_t DS7505::getTemperatureReg(DS7505::eReg tempReg){
-    uint8_t len = 2;
-    char data[len];
-
-    if(write(tempReg) == DS7505_SUCCESS){
-        if(read(data, len) == DS7505_SUCCESS) {
-            int16_t buf = (data[0] << 8) | data[1];
-            float temp = buf / 256.0;
-
-            if(tempReg == DS7505::TEMPER) {
-                ds7505.temperature = temp;
-            } else if(tempReg == DS7505::T_OS) {
-                ds7505.temp_os = temp;
-            } else {
-                ds7505.temp_hyst = temp;
-            }
-            return DS7505_SUCCESS;
-        }
+// SD is set again right after the wake: the conversion that started runs to the end
+// and the sensor stops after it, continuous mode would start a second one before the read
+int8_t DS7505::getTempOneShot(){
+    if(wakeUp() != DS7505_SUCCESS || shutDown() != DS7505_SUCCESS) {
+        return DS7505_ERROR;
     }
-    return DS7505_ERROR;
+    thread_sleep_for(conversionTimeMs(ds7505.config));
+    return getTemp();
 };
 
-int8_t DS7505::setTOSorHYST(DS7505::eReg tOS_HYST, float temp){
-    uint8_t len = 2;
-    char sendData[len];
-    int16_t buff = temp * 256;
+int8_t DS7505::recoverBus(){
+    _I2C.lock();
+    int8_t ret = recoverBusLocked();
+    _I2C.unlock();
+    return ret;
+};
 
-    sendData[0] = (buff & 0xFF00) >> 8 ;
-    sendData[1] = buff & 0xFF;
+void DS7505::frequency(int hz){
+    ScopedLock<I2C> lock(_I2C);
+    _hz = hz;
+    _I2C.frequency(hz);
+};
 
-    if(write(tOS_HYST, sendData, len) == DS7505_SUCCESS) {
-        if(tOS_HYST == DS7505::T_OS){
-            ds7505.temp_os = buff;
-        } else {
-            ds7505.temp_hyst = buff;
-        }
-        return DS7505_SUCCESS;
+#if DEVICE_I2C_ASYNCH
+int8_t DS7505::getTempAsync(read_callback_t callback){
+    if(core_util_atomic_flag_test_and_set(&_asyncBusy)) {
+        return DS7505_ERROR;
     }
-    return DS7505_ERROR;
-}
+    _asyncCallback = callback;
+    _asyncReg = DS7505::TEMPER;
 
-int8_t DS7505::read(char *data, const int length){
-    if(_I2C.read(DS7505_READ_ADDR(ds7505.addr), data, length) == DS7505_SUCCESS){
-        return DS7505_SUCCESS;
+    // the I2C stays reserved until asyncDone(), blocking calls of every sensor on it wait;
+    // same pointer cache as the blocking reads, no pointer write when already at TEMPER
+    _I2C.lock();
+    if(!_bus.asyncClaim()) {
+        _I2C.unlock();
+        core_util_atomic_flag_clear(&_asyncBusy);
+        return DS7505_ERROR;
+    }
+    int txLen = (ds7505.pointer == DS7505::TEMPER) ? 0 : 1;
+    ds7505.pointer = DS7505Protocol::POINTER_UNKNOWN;
+#ifdef DS7505_INSTRUMENT
+    _asyncStartUs = us_ticker_read();
+#endif
+    int ret = _I2C.transfer(DS7505_WRITE_ADDR(ds7505.addr << 1), &_asyncReg, txLen, _asyncData, 2,
+                            event_callback_t(this, &DS7505::asyncDone), I2C_EVENT_ALL);
+    if(ret != DS7505_SUCCESS) {
+        _bus.asyncRelease();
     }
-    return DS7505_ERROR;
+    _I2C.unlock();
+    if(ret != DS7505_SUCCESS) {
+        core_util_atomic_flag_clear(&_asyncBusy);
+        return DS7505_ERROR;
+    }
+    return DS7505_SUCCESS;
+};
+
+bool DS7505::asyncBusy() const {
+    return core_util_atomic_load_u8(&_asyncBusy._flag) != 0;
+};
+#endif
+
+#ifdef DS7505_INSTRUMENT
+void DS7505::instrumentation(ds7505_instr_t &snapshot) const {
+    _bus.instrumentation(snapshot);
+};
+
+void DS7505::resetInstrumentation(){
+    _bus.resetInstrumentation();
+};
+#endif
+
+__attribute__((weak)) uint32_t ds7505_now_us(){
+    return us_ticker_read();
+};
+
+__attribute__((weak)) void ds7505_sleep_ms(uint32_t ms){
+    thread_sleep_for(ms);
 };
 
-int8_t DS7505::write(const char reg){
-    if(_I2C.write(DS7505_WRITE_ADDR(ds7505.addr), &reg, 1) == DS7505_SUCCESS){
-        return DS7505_SUCCESS;
+uint16_t DS7505::conversionTimeMs(uint8_t config){
+    return DS7505Protocol::conversionTimeMs(config);
+};
+
+void DS7505::latest(reading_t &reading) const {
+    uint32_t seq;
+    do {
+        seq = core_util_atomic_load_u32(&_seq);
+        reading = _latest;
+    } while((seq & 1) != 0 || core_util_atomic_load_u32(&_seq) != seq);
+};
+
+//------------PRIVATE FUNCTION
+// SCL is clocked until the slave lets go of SDA (at most one byte and its ACK), the STOP
+// resets the slaves; DigitalInOut takes the pins from the I2C peripheral, constructing
+// the I2C object again gives them back (the I2C lock is static, it survives that). Only
+// done to the I2C created by the driver, a shared one may be a derived type and has
+// settings the driver does not know
+int8_t DS7505::recoverBusLocked(){
+    if(pI2C == NULL) {
+        return DS7505_ERROR;
     }
-    return DS7505_ERROR;
+    bool released;
+    _bus.waitAsync();
+    {
+        DigitalInOut sda(_sda, PIN_INPUT, PullNone, 1);
+        DigitalInOut scl(_scl, PIN_OUTPUT, OpenDrain, 1);
+        for(uint8_t i = 0; i < 9 && sda.read() == 0; i++) {
+            scl = 0;
+            wait_us(5);
+            scl = 1;
+            wait_us(5);
+        }
+        released = sda.read() != 0;
+        sda.output();
+        sda.mode(OpenDrain);
+        scl = 0;
+        wait_us(5);
+        sda = 0;
+        wait_us(5);
+        scl = 1;
+        wait_us(5);
+        sda = 1;
+        wait_us(5);
+    }
+    restoreI2CLocked();
+    ds7505.pointer = DS7505Protocol::POINTER_UNKNOWN;
+    return released ? DS7505_SUCCESS : DS7505_ERROR_BUS;
 };
 
-int8_t DS7505::write(const char reg, const char *data, const uint8_t len){
-    uint8_t newLen = len + 1;
-    char sendData[newLen];
-    sendData[0] = reg;
-    for(uint8_t i = 1; i <= len; i++) {
-            sendData[i] = *(data + i - 1);
+// one GPIO read of SDA, no clocks; the pin goes back to the I2C afterwards. Only for the
+// I2C the driver owns, like recoverBusLocked()
+bool DS7505::sdaHeld(){
+    ScopedLock<I2C> lock(_I2C);
+    if(pI2C == NULL) {
+        return false;
     }
-    if(_I2C.write(DS7505_WRITE_ADDR(ds7505.addr), sendData, newLen) == DS7505_SUCCESS) {
-        return DS7505_SUCCESS;
+    _bus.waitAsync();
+    int level;
+    {
+        DigitalInOut sda(_sda, PIN_INPUT, PullNone, 1);
+        level = sda.read();
     }
-    return DS7505_ERROR;
+    restoreI2CLocked();
+    return level == 0;
 };
 
+// constructing the I2C object again gives the pins back to the peripheral
+void DS7505::restoreI2CLocked(){
+    pI2C->~I2C();
+    new (pI2C) I2C(_sda, _scl);
+    pI2C->frequency(_hz);
+};
+
+// writers are the reading thread and the async completion, the critical section keeps
+// them apart; the counter is odd while _latest is written
+void DS7505::publish(int16_t raw){
+    CriticalSectionLock lock;
+    uint32_t seq = _seq;
+    core_util_atomic_store_u32(&_seq, seq + 1);
+    _latest.temperature_raw = raw;
+#ifndef DS7505_NO_FLOAT
+    _latest.temperature = raw / 256.0f;
+#endif
+    _latest.count++;
+    _latest.timestamp_us = us_ticker_read();
+    core_util_atomic_store_u32(&_seq, seq + 2);
+};
 
+#if DEVICE_I2C_ASYNCH
+void DS7505::asyncDone(int event){
+    int8_t status = DS7505_ERROR;
+    if((event & I2C_EVENT_ALL) == I2C_EVENT_TRANSFER_COMPLETE) {
+        int16_t raw = DS7505Protocol::decode(_asyncData[0], _asyncData[1]);
+        DS7505Protocol::store(ds7505, DS7505::TEMPER, raw);
+        publish(raw);
+        ds7505.pointer = DS7505::TEMPER;
+        status = DS7505_SUCCESS;
+    }
+#ifdef DS7505_INSTRUMENT
+    if(status == DS7505_SUCCESS) {
+        _bus.record(DS7505Protocol::OP_DATA_READ, _asyncStartUs, DS7505Protocol::FAULT_NONE);
+    } else if(event & (I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)) {
+        _bus.record(DS7505Protocol::OP_DATA_READ, _asyncStartUs, DS7505Protocol::FAULT_NACK);
+    } else {
+        _bus.record(DS7505Protocol::OP_DATA_READ, _asyncStartUs, DS7505Protocol::FAULT_TIMEOUT);
+    }
+#endif
+    _bus.asyncRelease();
+    core_util_atomic_flag_clear(&_asyncBusy);
+    if(_asyncCallback) {
+#ifdef DS7505_NO_FLOAT
+        _asyncCallback(status, ds7505.temperature_raw);
+#else
+        _asyncCallback(status, ds7505.temperature);
+#endif
+    }
+};
+#endif
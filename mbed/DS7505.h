@@ -73,8 +73,8 @@ int main()
     status = ds7505.copySRAMtoEPRROM();
     tr_info("copy status -> status %d", status);
     
-    ds7505.softwarePOR();
-    tr_info("softreset status");
+    status = ds7505.softwarePOR();
+    tr_info("softreset status %d", status);
 
     status = ds7505.setTempOS(30.0);
     tr_info("TOS reg write -> status %d", status);
@@ -110,9 +110,9 @@ int main()
                             ds7505.ds7505.temp_hyst);
     status = ds7505.shutDown();
     tr_info("shutdown mode status %d", status);
-    uint8_t i =0;
     while(1) {
-        status = ds7505.getTemp();
+        // one conversion per loop, the sensor stays in SHUTDOWN in between
+        status = ds7505.getTempOneShot();
         tr_info("temperature reg read -> status %d, value hex: 0x%2x, value dec[C]: %f",
                                 status,
                                 int(ds7505.ds7505.temperature * 256.0), 
@@ -121,11 +121,6 @@ int main()
         tr_info("input OS %d", OS.read());
         led = !led;
         thread_sleep_for(BLINKING_RATE_MS);
-        i++;
-        if(i == 5) {
-            i=0;
-            ds7505.wakeUp();
-        }
     }
 }
  */
@@ -141,6 +136,25 @@ int main()
 
 #define DS7505_SUCCESS  0
 #define DS7505_ERROR    -1
+// only returned by getTempWithin() and recoverBus(); the mbed I2C API does not tell a
+// NACK from a busy bus, every attempt failing is DS7505_ERROR
+#define DS7505_ERROR_BUS        -3  // SDA is still held low after bus recovery
+#define DS7505_ERROR_DEADLINE   -4  // the next attempt or recovery would not fit the budget
+
+// attempts after the first one in getTempWithin()
+#define DS7505_RETRIES  2
+// what getTempWithin() reserves for recoverBus(): nine SCL clocks and a STOP at
+// 100 kHz and the I2C set up again
+#define DS7505_RECOVERY_US  150
+
+// the protocol, the register state and the DS7505_INSTRUMENT counters are shared
+// with the Linux port in core/DS7505Core.h
+#include "DS7505MbedBus.h"
+
+// us_ticker_read() and thread_sleep_for(), the clock of the helpers shared with the
+// Linux port (I2CDev.h there); weak so a test harness can supply its own
+uint32_t ds7505_now_us();
+void ds7505_sleep_ms(uint32_t ms);
 
 #define DS7505_READ_ADDR(addr)   (addr | DIR_BIT_READ)
 #define DS7505_WRITE_ADDR(addr)   (addr | DIR_BIT_WRITE)
@@ -195,14 +209,31 @@ class DS7505 {
             SOFTWARE_POR    =   0x54
         };
 
-        struct ds7505_t {
-            uint8_t addr;
-            uint8_t config;
-            float temp_hyst;
-            float temp_os;
+        // addr (7-bit), pointer cache, CONFIG shadow and the register values, kept by
+        // DS7505Core, see DS7505Protocol::state_t
+        typedef DS7505Protocol::state_t ds7505_t;
+        // complete desired state for applyProfile()
+        typedef DS7505Protocol::profile_t profile_t;
+
+        // latest TEMPER reading, see latest()
+        struct reading_t {
+            int16_t temperature_raw;    // 1/256 degC per LSB
+#ifndef DS7505_NO_FLOAT
             float temperature;
+#endif
+            uint32_t count;             // readings published so far, 0 before the first one
+            uint32_t timestamp_us;      // us_ticker_read() when it was published
         };
-        ds7505_t ds7505;
+    private:
+        typedef DS7505Core<DS7505MbedBus, DS7505Protocol::ADDR_RUNTIME, DS7505Protocol::BITS_9> core_t;
+
+        // declared before ds7505, which refers into the core
+        I2C *pI2C;
+        I2C &_I2C;
+        DS7505MbedBus _bus;
+        core_t _core;
+    public:
+        ds7505_t &ds7505;
 
         DS7505(PinName sda, PinName scl, uint8_t addr = DS7505_I2C_ADDRESS);
         DS7505(I2C &i2c, uint8_t addr = DS7505_I2C_ADDRESS);
@@ -210,37 +241,119 @@ class DS7505 {
         ~DS7505();
 
         int8_t getConfigReg();
+        // reads CONFIG only when the shadow is not valid
+        int8_t getConfigRegCached();
         int8_t setConfigReg(DS7505::eResolution resolution = BITS_9,
                             DS7505::eFault_Tolerance tolerance = OUT_OF_LIMITS_TRIG_1,
                             DS7505::eTermostat_Out_Polarity polarity = ACTIVE_LOW,
                             DS7505::eTermostat_Mode mode = COMPARATOR);
 
+        // only R1:R0 change, one CONFIG write from the shadow (read first when not valid)
+        int8_t setResolution(DS7505::eResolution resolution);
+
         int8_t getTemp();
+        // getTemp() retried for at most retries more attempts while another one fits
+        // in budgetUs; when the driver owns the I2C and a failed attempt left SDA low,
+        // recoverBus() in between if the recovery fits too. The blocking mbed I2C calls have no timeout, the
+        // first attempt is not bounded by budgetUs (a held SDA blocks it for the bus-busy
+        // timeout of the target)
+        int8_t getTempWithin(uint32_t budgetUs, uint8_t retries = DS7505_RETRIES);
         int8_t getTempOS();
         int8_t getTempHYST();
 
+        // integer setters, no float code is pulled in with DS7505_NO_FLOAT
+        int8_t setTempOSRaw(int16_t tempOS);
+        int8_t setTempHystRaw(int16_t tempHYST);
+        int8_t setTempOSCenti(int32_t tempOS);
+        int8_t setTempHystCenti(int32_t tempHYST);
+#ifndef DS7505_NO_FLOAT
         int8_t setTempOS(float tempOS);
         int8_t setTempHyst(float tempHYST);
+#endif
 
         int8_t copySRAMtoEPRROM();
-        void softwarePOR();
+        int8_t softwarePOR();
         int8_t recallData();
         bool memoryBusy();
+        // CONFIG, T_HYST and T_OS written back to back and verified with one read pass,
+        // then COPY_DATA when commit is set and everything matched
+        int8_t applyProfile(const profile_t &profile, bool commit = false);
 
         int8_t shutDown();
         int8_t wakeUp();
+        // one conversion for a sensor kept in SHUTDOWN: wake and shut down at once (the
+        // started conversion still completes), sleep the conversion time of the cached
+        // resolution, read TEMPER. Two CONFIG writes and one read, CONFIG is only read
+        // when the shadow is not valid;
+        // DS7505OneShot does the same from an EventQueue without blocking the thread
+        int8_t getTempOneShot();
+
+        // nine SCL clocks and a STOP to free a slave that holds SDA low, then the I2C
+        // object is constructed again on the same pins. Only for the I2C the driver owns
+        // (PinName constructor), DS7505_ERROR on a shared one: that object belongs to the
+        // caller, who recovers it
+        int8_t recoverBus();
+        // clock of the I2C the driver owns, kept across recoverBus()
+        void frequency(int hz);
+
+        // 25/50/100/200 ms for the R1:R0 bits of config
+        static uint16_t conversionTimeMs(uint8_t config);
+
+        // Every TEMPER read is published with a sequence counter: any thread gets a
+        // consistent copy without a lock and without holding up the reads, it retries
+        // while a new one is written. The bus calls of one driver call (pointer write
+        // and read, read-modify-write of CONFIG, profile and verify, bus recovery) are
+        // made under I2C::lock(), shared by every device on that I2C object and never
+        // held while a conversion runs.
+        void latest(reading_t &reading) const;
+
+#ifdef DS7505_INSTRUMENT
+        // copy of the counters, consistent against the async completion
+        void instrumentation(ds7505_instr_t &snapshot) const;
+        void resetInstrumentation();
+#endif
+
+#if DEVICE_I2C_ASYNCH
+#ifdef DS7505_NO_FLOAT
+        typedef mbed::Callback<void(int8_t status, int16_t temperature)> read_callback_t;
+#else
+        typedef mbed::Callback<void(int8_t status, float temperature)> read_callback_t;
+#endif
+
+        // starts a temperature read and returns at once, the callback runs from
+        // the I2C interrupt when the transfer is done (defer heavy work to an EventQueue).
+        // The I2C stays reserved until then: blocking calls of every DS7505 on it wait,
+        // a second async read on the same I2C fails with DS7505_ERROR
+        int8_t getTempAsync(read_callback_t callback);
+        bool asyncBusy() const;
+#endif
     private:
-        I2C *pI2C;
-        I2C &_I2C;
-
-        int8_t shutMode(DS7505::eShutdown mode);
-        int8_t getTemperatureReg(DS7505::eReg tempReg);
-        int8_t setTOSorHYST(DS7505::eReg tOS_HYST, float tempOS);
-
-        int8_t read(char *data, const int length);
-        int8_t write(const char reg);
-        int8_t write(const char reg, const char *data, const uint8_t len);
+        PinName _sda;
+        PinName _scl;
+        int _hz;
+        volatile uint32_t _seq;     // odd while _latest is written
+        reading_t _latest;
+
+#if DEVICE_I2C_ASYNCH
+        char _asyncReg;
+        char _asyncData[2];
+        read_callback_t _asyncCallback;
+        core_util_atomic_flag _asyncBusy;
+#ifdef DS7505_INSTRUMENT
+        uint32_t _asyncStartUs;
+#endif
+
+        void asyncDone(int event);
+#endif
+
+        DS7505(const DS7505 &);
+        DS7505 &operator=(const DS7505 &);
+
+        void publish(int16_t raw);
+        int8_t recoverBusLocked();
+        bool sdaHeld();
+        void restoreI2CLocked();
         
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,48 @@
+#include "DS7505Alert.h"
+
+DS7505Alert::DS7505Alert(DS7505 &sensor, PinName os, EventQueue &queue): _sensor(sensor),
+                                                                          _os(os, PullUp),
+                                                                          _queue(queue)
+{
+}
+
+DS7505Alert::~DS7505Alert(){
+    detach();
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505Alert::attach(alert_callback_t callback, DS7505::eTermostat_Out_Polarity polarity){
+    _callback = callback;
+    if(polarity == DS7505::ACTIVE_LOW) {
+        _os.rise(nullptr);
+        _os.fall(mbed::callback(this, &DS7505Alert::isr));
+    } else {
+        _os.fall(nullptr);
+        _os.rise(mbed::callback(this, &DS7505Alert::isr));
+    }
+
+    if(_sensor.getConfigRegCached() == DS7505_SUCCESS) {
+        uint8_t config = _sensor.ds7505.config;
+        return _sensor.setConfigReg((DS7505::eResolution)(config & DS7505::BITS_12),
+                                    (DS7505::eFault_Tolerance)(config & DS7505::OUT_OF_LIMITS_TRIG_6),
+                                    polarity, DS7505::INTERRUPT);
+    }
+    return DS7505_ERROR;
+};
+
+void DS7505Alert::detach(){
+    _os.rise(nullptr);
+    _os.fall(nullptr);
+};
+
+//------------PRIVATE FUNCTION
+void DS7505Alert::isr(){
+    _queue.call(mbed::callback(this, &DS7505Alert::handle));
+};
+
+void DS7505Alert::handle(){
+    int8_t status = _sensor.getTemp();
+    if(_callback) {
+        _callback(&_sensor, status);
+    }
+};
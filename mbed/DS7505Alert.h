@@ -0,0 +1,55 @@
+/**
+O.S. alert of one sensor. Every instance owns its InterruptIn, the ISR only
+posts to the EventQueue and the temperature is read from the queue thread,
+so nothing touches the bus from interrupt context. Reading the temperature
+also clears O.S. in interrupt mode.
+example:
+I2C i2c(PB_9, PB_8);
+DS7505 ds7505(i2c, 0x48);
+DS7505 ds7505b(i2c, 0x49);
+EventQueue queue;
+DS7505Alert alert(ds7505, PA_8, queue);
+DS7505Alert alertB(ds7505b, PA_9, queue);
+
+void onAlert(DS7505 *sensor, int8_t status)
+{
+    tr_info("alert 0x%2x -> status %d, value dec[C]: %f",
+            sensor->ds7505.addr, status, sensor->ds7505.temperature);
+}
+
+int main()
+{
+    alert.attach(callback(onAlert));
+    alertB.attach(callback(onAlert));
+    queue.dispatch_forever();
+}
+ */
+
+#ifndef _DS7505ALERT_H
+#define _DS7505ALERT_H
+
+#include "mbed.h"
+#include "DS7505.h"
+
+class DS7505Alert {
+    public:
+        typedef mbed::Callback<void(DS7505 *sensor, int8_t status)> alert_callback_t;
+
+        DS7505Alert(DS7505 &sensor, PinName os, EventQueue &queue);
+        ~DS7505Alert();
+
+        // switches the sensor to interrupt mode, resolution and fault tolerance are kept
+        int8_t attach(alert_callback_t callback,
+                      DS7505::eTermostat_Out_Polarity polarity = DS7505::ACTIVE_LOW);
+        void detach();
+    private:
+        DS7505 &_sensor;
+        InterruptIn _os;
+        EventQueue &_queue;
+        alert_callback_t _callback;
+
+        void isr();
+        void handle();
+};
+
+#endif
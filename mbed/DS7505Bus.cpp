@@ -0,0 +1,106 @@
+#include "DS7505Bus.h"
+
+DS7505Bus::DS7505Bus(I2C &i2c): _I2C(i2c),
+                                _count(0)
+{
+}
+
+DS7505Bus::~DS7505Bus(){
+    for(uint8_t i = 0; i < _count; i++) {
+        delete _sensors[i];
+    }
+}
+
+//----------PUBLIC FUNCTION
+// sensors are kept in address order, polling walks the bus from 0x48 up
+int8_t DS7505Bus::add(uint8_t addr){
+    if(addr < DS7505_BUS_FIRST_ADDR || addr > DS7505_BUS_LAST_ADDR) {
+        return DS7505_ERROR;
+    }
+    uint8_t pos = position(addr);
+    if(pos < _count && _sensors[pos]->ds7505.addr == addr) {
+        return DS7505_SUCCESS;
+    }
+    if(_count == DS7505_BUS_MAX_SENSORS) {
+        return DS7505_ERROR;
+    }
+    insert(pos, new DS7505(_I2C, addr));
+    return DS7505_SUCCESS;
+};
+
+// adds every address that answers a CONFIG read, returns the number of sensors.
+// Every address is probed through the sensor that keeps it, so the pointer cache
+// follows the CONFIG read and a new sensor starts with a valid config shadow
+uint8_t DS7505Bus::scan(){
+    _I2C.lock();
+    for(uint8_t addr = DS7505_BUS_FIRST_ADDR; addr <= DS7505_BUS_LAST_ADDR; addr++) {
+        uint8_t pos = position(addr);
+        if(pos < _count && _sensors[pos]->ds7505.addr == addr) {
+            _sensors[pos]->getConfigReg();
+            continue;
+        }
+        if(_count == DS7505_BUS_MAX_SENSORS) {
+            continue;
+        }
+        DS7505 *sensor = new DS7505(_I2C, addr);
+        if(sensor->getConfigReg() == DS7505_SUCCESS) {
+            insert(pos, sensor);
+        } else {
+            delete sensor;
+        }
+    }
+    _I2C.unlock();
+    return _count;
+};
+
+uint8_t DS7505Bus::count() const {
+    return _count;
+};
+
+DS7505 *DS7505Bus::sensor(uint8_t index){
+    if(index < _count) {
+        return _sensors[index];
+    }
+    return NULL;
+};
+
+// one polling cycle, the bus is held for the whole cycle so the reads go out
+// back to back; samples must have room for count() entries, a sensor that
+// NACKs gets DS7505_ERROR and the cycle moves on. Returns the number of
+// sensors that answered.
+uint8_t DS7505Bus::poll(sample_t *samples){
+    uint8_t ok = 0;
+    _I2C.lock();
+    for(uint8_t i = 0; i < _count; i++) {
+        DS7505 *sensor = _sensors[i];
+        samples[i].addr = sensor->ds7505.addr;
+        samples[i].status = sensor->getTemp();
+        samples[i].temperature_raw = sensor->ds7505.temperature_raw;
+#ifndef DS7505_NO_FLOAT
+        samples[i].temperature = sensor->ds7505.temperature;
+#endif
+        if(samples[i].status == DS7505_SUCCESS) {
+            ok++;
+        }
+    }
+    _I2C.unlock();
+    return ok;
+};
+
+//------------PRIVATE FUNCTION
+// index of addr, or where it goes to keep the address order
+uint8_t DS7505Bus::position(uint8_t addr) const {
+    uint8_t pos = 0;
+    while(pos < _count && _sensors[pos]->ds7505.addr < addr) {
+        pos++;
+    }
+    return pos;
+};
+
+void DS7505Bus::insert(uint8_t pos, DS7505 *sensor){
+    for(uint8_t i = _count; i > pos; i--) {
+        _sensors[i] = _sensors[i - 1];
+    }
+    _sensors[pos] = sensor;
+    _count++;
+};
@@ -0,0 +1,65 @@
+/**
+Owns all DS7505 sensors on one I2C bus and polls them as one batch.
+example:
+I2C i2c(PB_9, PB_8);
+DS7505Bus bus(i2c);
+DS7505Bus::sample_t samples[DS7505_BUS_MAX_SENSORS];
+
+int main()
+{
+    bus.scan();
+    while(1) {
+        uint8_t n = bus.poll(samples);
+        for(uint8_t i = 0; i < bus.count(); i++) {
+            tr_info("0x%2x -> status %d, value dec[C]: %f",
+                    samples[i].addr, samples[i].status, samples[i].temperature);
+        }
+        thread_sleep_for(1000);
+    }
+}
+ */
+
+#ifndef _DS7505BUS_H
+#define _DS7505BUS_H
+
+#include "mbed.h"
+#include "DS7505.h"
+
+#define DS7505_BUS_MAX_SENSORS  8
+#define DS7505_BUS_FIRST_ADDR   0x48
+#define DS7505_BUS_LAST_ADDR    0x4F
+
+class DS7505Bus {
+    public:
+        struct sample_t {
+            uint8_t addr;
+            int8_t status;
+            int16_t temperature_raw;
+#ifndef DS7505_NO_FLOAT
+            float temperature;
+#endif
+        };
+
+        DS7505Bus(I2C &i2c);
+        ~DS7505Bus();
+
+        int8_t add(uint8_t addr);
+        uint8_t scan();
+
+        uint8_t count() const;
+        DS7505 *sensor(uint8_t index);
+
+        uint8_t poll(sample_t *samples);
+    private:
+        I2C &_I2C;
+        DS7505 *_sensors[DS7505_BUS_MAX_SENSORS];
+        uint8_t _count;
+
+        uint8_t position(uint8_t addr) const;
+        void insert(uint8_t pos, DS7505 *sensor);
+
+        DS7505Bus(const DS7505Bus &);
+        DS7505Bus &operator=(const DS7505Bus &);
+};
+
+#endif
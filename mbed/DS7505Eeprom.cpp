@@ -0,0 +1,121 @@
+#include "DS7505Eeprom.h"
+
+DS7505Eeprom::DS7505Eeprom(DS7505 &sensor): _sensor(&sensor),
+                                            _queue(NULL),
+                                            _due(0),
+                                            _waitedMs(0),
+                                            _delayMs(0),
+                                            _status(DS7505_SUCCESS)
+{
+}
+
+DS7505Eeprom::DS7505Eeprom(DS7505 &sensor, EventQueue &queue): _sensor(&sensor),
+                                                               _queue(&queue),
+                                                               _due(0),
+                                                               _waitedMs(0),
+                                                               _delayMs(0),
+                                                               _status(DS7505_SUCCESS)
+{
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505Eeprom::commit(uint32_t nowMs){
+    return start(&DS7505::copySRAMtoEPRROM, nowMs, DS7505_EEPROM_WRITE_MS);
+};
+
+int8_t DS7505Eeprom::recall(uint32_t nowMs){
+    return start(&DS7505::recallData, nowMs, DS7505_EEPROM_RECALL_MS);
+};
+
+// one CONFIG read per due check, NVB stays set while the EEPROM is written,
+// the result of the last operation is kept until the next one starts
+int8_t DS7505Eeprom::run(uint32_t nowMs){
+    if(_status != DS7505_EEPROM_PENDING || (int32_t)(nowMs - _due) < 0) {
+        return _status;
+    }
+    if(_sensor->getConfigReg() != DS7505_SUCCESS) {
+        _status = DS7505_ERROR;
+    } else if((_sensor->ds7505.config & DS7505::WRITE_IN_PROGRESS) == 0) {
+        _status = DS7505_SUCCESS;
+    } else if(_waitedMs >= DS7505_EEPROM_TIMEOUT_MS) {
+        _status = DS7505_ERROR;
+    } else {
+        _due = nowMs + _delayMs;
+        _waitedMs += _delayMs;
+        if(_delayMs < DS7505_EEPROM_MAX_POLL_MS) {
+            _delayMs *= 2;
+        }
+    }
+    return _status;
+};
+
+// time until the next NVB check, DS7505_EEPROM_IDLE when nothing is pending
+uint32_t DS7505Eeprom::nextDueMs(uint32_t nowMs) const {
+    if(_status != DS7505_EEPROM_PENDING) {
+        return DS7505_EEPROM_IDLE;
+    }
+    int32_t left = (int32_t)(_due - nowMs);
+    return left > 0 ? left : 0;
+};
+
+int8_t DS7505Eeprom::commit(done_callback_t done){
+    return start(&DS7505::copySRAMtoEPRROM, DS7505_EEPROM_WRITE_MS, done);
+};
+
+int8_t DS7505Eeprom::recall(done_callback_t done){
+    return start(&DS7505::recallData, DS7505_EEPROM_RECALL_MS, done);
+};
+
+bool DS7505Eeprom::busy() const {
+    return _status == DS7505_EEPROM_PENDING;
+};
+
+//------------PRIVATE FUNCTION
+int8_t DS7505Eeprom::start(int8_t (DS7505::*command)(), uint32_t nowMs, uint16_t firstCheckMs){
+    if(_status == DS7505_EEPROM_PENDING) {
+        return DS7505_ERROR;
+    }
+    if((_sensor->*command)() != DS7505_SUCCESS) {
+        _status = DS7505_ERROR;
+        return DS7505_ERROR;
+    }
+    _status = DS7505_EEPROM_PENDING;
+    _due = nowMs + firstCheckMs;
+    _waitedMs = firstCheckMs;
+    _delayMs = 1;
+    return DS7505_SUCCESS;
+};
+
+// the queue keeps the time: a check runs when it is due, so the clock of run()
+// starts at 0 and is the due time of every check
+int8_t DS7505Eeprom::start(int8_t (DS7505::*command)(), uint16_t firstCheckMs, done_callback_t done){
+    if(_queue == NULL || start(command, 0, firstCheckMs) != DS7505_SUCCESS) {
+        return DS7505_ERROR;
+    }
+    _done = done;
+    schedule(firstCheckMs);
+    return DS7505_SUCCESS;
+};
+
+void DS7505Eeprom::schedule(uint32_t delayMs){
+    if(_queue->call_in(std::chrono::milliseconds(delayMs),
+                       mbed::callback(this, &DS7505Eeprom::check)) == 0) {
+        _status = DS7505_ERROR;
+        finish();
+    }
+};
+
+void DS7505Eeprom::check(){
+    uint32_t now = _due;
+    if(run(now) == DS7505_EEPROM_PENDING) {
+        schedule(nextDueMs(now));
+    } else {
+        finish();
+    }
+};
+
+void DS7505Eeprom::finish(){
+    if(_done) {
+        _done(_sensor, _status);
+    }
+};
@@ -0,0 +1,77 @@
+/**
+Non-blocking COPY_DATA / RECALL_DATA. The command is sent at once, NVB is
+checked first after the typical EEPROM write time and then with a growing
+interval, the bus is free for other sensors in between. The checks run from a
+poll loop (commit(nowMs), run(), nextDueMs(), as on Linux) or from an
+EventQueue, then the callback runs on the queue thread when NVB is clear or
+the timeout passed.
+example:
+I2C i2c(PB_9, PB_8);
+DS7505 ds7505(i2c, 0x48);
+DS7505 ds7505b(i2c, 0x49);
+EventQueue queue;
+DS7505Eeprom eeprom(ds7505, queue);
+DS7505Eeprom eepromB(ds7505b, queue);
+
+void onCommit(DS7505 *sensor, int8_t status)
+{
+    tr_info("commit 0x%2x -> status %d", sensor->ds7505.addr, status);
+}
+
+int main()
+{
+    ds7505.setTempOS(30.0);
+    ds7505b.setTempOS(30.0);
+    eeprom.commit(callback(onCommit));
+    eepromB.commit(callback(onCommit));
+    queue.dispatch_forever();
+}
+ */
+
+#ifndef _DS7505EEPROM_H
+#define _DS7505EEPROM_H
+
+#include "mbed.h"
+#include "DS7505.h"
+
+#define DS7505_EEPROM_PENDING       1
+#define DS7505_EEPROM_IDLE          0xFFFFFFFF
+#define DS7505_EEPROM_WRITE_MS      10  // typical tWR, first NVB check after COPY_DATA
+#define DS7505_EEPROM_RECALL_MS     1
+#define DS7505_EEPROM_MAX_POLL_MS   8   // the check interval doubles up to this
+#define DS7505_EEPROM_TIMEOUT_MS    100
+
+class DS7505Eeprom {
+    public:
+        typedef mbed::Callback<void(DS7505 *sensor, int8_t status)> done_callback_t;
+
+        // poll loop only
+        explicit DS7505Eeprom(DS7505 &sensor);
+        DS7505Eeprom(DS7505 &sensor, EventQueue &queue);
+
+        int8_t commit(uint32_t nowMs);
+        int8_t recall(uint32_t nowMs);
+        int8_t run(uint32_t nowMs);
+        uint32_t nextDueMs(uint32_t nowMs) const;
+
+        // DS7505_ERROR without a queue
+        int8_t commit(done_callback_t done);
+        int8_t recall(done_callback_t done);
+        bool busy() const;
+    private:
+        DS7505 *_sensor;
+        EventQueue *_queue;
+        done_callback_t _done;
+        uint32_t _due;
+        uint16_t _waitedMs;
+        uint16_t _delayMs;
+        int8_t _status;
+
+        int8_t start(int8_t (DS7505::*command)(), uint32_t nowMs, uint16_t firstCheckMs);
+        int8_t start(int8_t (DS7505::*command)(), uint16_t firstCheckMs, done_callback_t done);
+        void schedule(uint32_t delayMs);
+        void check();
+        void finish();
+};
+
+#endif
@@ -0,0 +1,169 @@
+/**
+Bus policy of DS7505Core for mbed I2C, see core/DS7505Core.h. The pointer
+write and the read go out with a repeated start. DS7505 has one per sensor
+over the shared I2C; with DS7505_INSTRUMENT it counts every call made
+through it, the pointer write before a read is its own bus call here. The
+blocking mbed I2C calls report a failure without its reason (NACK, bus
+error or timeout look the same), so those count in errors only; the async
+read of DS7505 tells a NACK from the transfer events.
+asyncClaim() reserves the I2C object for an async read until asyncRelease()
+from the completion; every blocking call through any DS7505MbedBus on that
+I2C waits for it, the caller holds the I2C lock so no new one starts meanwhile.
+ */
+
+#ifndef _DS7505MBEDBUS_H
+#define _DS7505MBEDBUS_H
+
+#include "mbed.h"
+#include "DS7505Core.h"
+
+#ifndef DS7505_ASYNC_BUSES
+// I2C objects that can have an async read in flight at the same time
+#define DS7505_ASYNC_BUSES  4
+#endif
+
+class DS7505MbedBus {
+    public:
+        explicit DS7505MbedBus(I2C &i2c): _i2c(i2c)
+        {
+#ifdef DS7505_INSTRUMENT
+            resetInstrumentation();
+#endif
+        }
+
+        // a single byte is the pointer of a read that follows (repeated) or a command
+        int write(uint8_t addr, const uint8_t *data, int length, bool repeated = false) {
+            DS7505Protocol::eOp op = length > 1 ? DS7505Protocol::OP_CONFIG_WRITE :
+                                     repeated ? DS7505Protocol::OP_POINTER_WRITE : DS7505Protocol::OP_COMMAND;
+            waitAsync();
+#ifdef DS7505_INSTRUMENT
+            uint32_t start = us_ticker_read();
+            int ret = _i2c.write(addr << 1, (const char *)data, length, repeated);
+            record(op, start, ret == 0 ? DS7505Protocol::FAULT_NONE : DS7505Protocol::FAULT_ERROR);
+            return ret;
+#else
+            (void)op;
+            return _i2c.write(addr << 1, (const char *)data, length, repeated);
+#endif
+        }
+
+        int read(uint8_t addr, uint8_t *data, int length, bool repeated = false) {
+            waitAsync();
+#ifdef DS7505_INSTRUMENT
+            uint32_t start = us_ticker_read();
+            int ret = _i2c.read((addr << 1) | 0x01, (char *)data, length, repeated);
+            record(DS7505Protocol::OP_DATA_READ, start,
+                   ret == 0 ? DS7505Protocol::FAULT_NONE : DS7505Protocol::FAULT_ERROR);
+            return ret;
+#else
+            return _i2c.read((addr << 1) | 0x01, (char *)data, length, repeated);
+#endif
+        }
+
+        int writeRead(uint8_t addr, const uint8_t *wdata, int wlength, uint8_t *rdata, int rlength) {
+            if(write(addr, wdata, wlength, true) != 0) {
+                return -1;
+            }
+            return read(addr, rdata, rlength);
+        }
+
+        // one call per message, repeated starts up to the last one
+        int transfer(uint8_t addr, DS7505Protocol::msg_t *msgs, int count) {
+            for(int i = 0; i < count; i++) {
+                bool repeated = i + 1 < count;
+                int ret = msgs[i].read ? read(addr, msgs[i].data, msgs[i].length, repeated) :
+                                         write(addr, msgs[i].data, msgs[i].length, repeated);
+                if(ret != 0) {
+                    return -1;
+                }
+            }
+            return 0;
+        }
+
+        // false when an async read is already in flight on this I2C or no slot is free
+        bool asyncClaim() {
+            CriticalSectionLock lock;
+            I2C **slots = asyncSlots();
+            int slot = -1;
+            for(int i = 0; i < DS7505_ASYNC_BUSES; i++) {
+                if(slots[i] == &_i2c) {
+                    return false;
+                }
+                if(slots[i] == NULL && slot < 0) {
+                    slot = i;
+                }
+            }
+            if(slot < 0) {
+                return false;
+            }
+            slots[slot] = &_i2c;
+            return true;
+        }
+
+        // from the completion, interrupt context
+        void asyncRelease() {
+            CriticalSectionLock lock;
+            I2C **slots = asyncSlots();
+            for(int i = 0; i < DS7505_ASYNC_BUSES; i++) {
+                if(slots[i] == &_i2c) {
+                    slots[i] = NULL;
+                }
+            }
+        }
+
+        bool asyncInFlight() const {
+            CriticalSectionLock lock;
+            I2C **slots = asyncSlots();
+            for(int i = 0; i < DS7505_ASYNC_BUSES; i++) {
+                if(slots[i] == &_i2c) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // a transfer takes a few hundred us, not worth a context switch
+        void waitAsync() const {
+            while(asyncInFlight()) {
+                wait_us(10);
+            }
+        }
+
+#ifdef DS7505_INSTRUMENT
+        // copy of the counters, consistent against an async completion
+        void instrumentation(ds7505_instr_t &snapshot) const {
+            CriticalSectionLock lock;
+            snapshot = _instr;
+        }
+
+        void resetInstrumentation() {
+            CriticalSectionLock lock;
+            memset(&_instr, 0, sizeof(_instr));
+        }
+
+        void retried(DS7505Protocol::eOp op) {
+            CriticalSectionLock lock;
+            _instr.op[op].retries++;
+        }
+
+        // also for transfers made around the policy, the async read of DS7505
+        void record(DS7505Protocol::eOp op, uint32_t startUs, DS7505Protocol::eFault fault) {
+            uint32_t us = us_ticker_read() - startUs;
+            CriticalSectionLock lock;
+            ds7505_instr_record(_instr.op[op], us, fault);
+        }
+#endif
+    private:
+        I2C &_i2c;
+
+        // shared by every policy, keyed by the I2C object
+        static I2C **asyncSlots() {
+            static I2C *slots[DS7505_ASYNC_BUSES];
+            return slots;
+        }
+#ifdef DS7505_INSTRUMENT
+        ds7505_instr_t _instr;
+#endif
+};
+
+#endif
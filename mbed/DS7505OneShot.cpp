@@ -0,0 +1,42 @@
+#include "DS7505OneShot.h"
+
+DS7505OneShot::DS7505OneShot(DS7505 &sensor, EventQueue &queue): _sensor(sensor),
+                                                                 _queue(queue),
+                                                                 _busy(false)
+{
+}
+
+//----------PUBLIC FUNCTION
+int8_t DS7505OneShot::start(done_callback_t done){
+    if(_busy) {
+        return DS7505_ERROR;
+    }
+    if(_sensor.wakeUp() != DS7505_SUCCESS || _sensor.shutDown() != DS7505_SUCCESS) {
+        return DS7505_ERROR;
+    }
+    _busy = true;
+    _done = done;
+    uint16_t delayMs = DS7505::conversionTimeMs(_sensor.ds7505.config);
+    if(_queue.call_in(std::chrono::milliseconds(delayMs),
+                      mbed::callback(this, &DS7505OneShot::read)) == 0) {
+        _busy = false;
+        return DS7505_ERROR;
+    }
+    return DS7505_SUCCESS;
+};
+
+bool DS7505OneShot::busy() const {
+    return _busy;
+};
+
+//------------PRIVATE FUNCTION
+void DS7505OneShot::read(){
+    finish(_sensor.getTemp());
+};
+
+void DS7505OneShot::finish(int8_t status){
+    _busy = false;
+    if(_done) {
+        _done(&_sensor, status);
+    }
+};
@@ -0,0 +1,51 @@
+/**
+One-shot reads from the EventQueue for sensors kept in SHUTDOWN. start() wakes
+the sensor and shuts it down again at once (two CONFIG writes, the conversion
+that started still completes), the queue reads TEMPER after the conversion
+time of the cached resolution and the callback runs on the queue thread.
+Nothing runs during the conversion, the MCU sleeps while the queue waits.
+example:
+I2C i2c(PB_9, PB_8);
+DS7505 ds7505(i2c);
+EventQueue queue;
+DS7505OneShot oneShot(ds7505, queue);
+
+void onTemp(DS7505 *sensor, int8_t status)
+{
+    tr_info("status %d, %d centi C", status, DS7505Protocol::rawToCenti(sensor->ds7505.temperature_raw));
+}
+
+int main()
+{
+    ds7505.setConfigReg(DS7505::BITS_12);
+    ds7505.shutDown();
+    queue.call_every(60s, []() { oneShot.start(callback(onTemp)); });
+    queue.dispatch_forever();
+}
+ */
+
+#ifndef _DS7505ONESHOT_H
+#define _DS7505ONESHOT_H
+
+#include "mbed.h"
+#include "DS7505.h"
+
+class DS7505OneShot {
+    public:
+        typedef mbed::Callback<void(DS7505 *sensor, int8_t status)> done_callback_t;
+
+        DS7505OneShot(DS7505 &sensor, EventQueue &queue);
+
+        int8_t start(done_callback_t done);
+        bool busy() const;
+    private:
+        DS7505 &_sensor;
+        EventQueue &_queue;
+        done_callback_t _done;
+        bool _busy;
+
+        void read();
+        void finish(int8_t status);
+};
+
+#endif
@@ -0,0 +1,98 @@
+/**
+Fixed size single-producer/single-consumer ring of timestamped samples.
+The acquisition thread (or work deferred from an ISR) pushes, one consumer
+thread drains in batches, neither side takes a lock. SIZE must be a power
+of two, the indices run freely and are masked on access.
+example:
+DS7505Ring<64> ring;
+
+void acquisition()
+{
+    while(1) {
+        if(ds7505.getTemp() == DS7505_SUCCESS) {
+            ring.push(ds7505, Kernel::get_ms_count());
+        }
+        thread_sleep_for(200);
+    }
+}
+
+void logger()
+{
+    ds7505_record_t batch[16];
+    while(1) {
+        uint16_t n = ring.pop(batch, 16);
+        for(uint16_t i = 0; i < n; i++) {
+            tr_info("%lu 0x%2x %ld", batch[i].timestamp, batch[i].addr,
+                    DS7505Protocol::rawToCenti(batch[i].temperature_raw));
+        }
+        thread_sleep_for(1000);
+    }
+}
+ */
+
+#ifndef _DS7505RING_H
+#define _DS7505RING_H
+
+#include "mbed.h"
+#include "DS7505.h"
+
+struct ds7505_record_t {
+    uint32_t timestamp;     // ms
+    uint8_t addr;           // 7-bit address
+    int16_t temperature_raw;
+};
+
+template <uint16_t SIZE>
+class DS7505Ring {
+    MBED_STATIC_ASSERT((SIZE & (SIZE - 1)) == 0, "DS7505Ring size must be a power of two");
+
+    public:
+        DS7505Ring(): _head(0), _tail(0), _dropped(0) {}
+
+        // producer side, false when full (the sample is dropped and counted)
+        bool push(const ds7505_record_t &record) {
+            uint32_t head = _head;
+            if(head - core_util_atomic_load_u32(&_tail) == SIZE) {
+                _dropped++;
+                return false;
+            }
+            _buffer[head & (SIZE - 1)] = record;
+            core_util_atomic_store_u32(&_head, head + 1);
+            return true;
+        }
+
+        bool push(const DS7505 &sensor, uint32_t timestamp) {
+            ds7505_record_t record;
+            record.timestamp = timestamp;
+            record.addr = sensor.ds7505.addr;
+            record.temperature_raw = sensor.ds7505.temperature_raw;
+            return push(record);
+        }
+
+        // consumer side, copies up to max records, returns how many
+        uint16_t pop(ds7505_record_t *records, uint16_t max) {
+            uint32_t tail = _tail;
+            uint32_t available = core_util_atomic_load_u32(&_head) - tail;
+            uint16_t n = available < max ? available : max;
+            for(uint16_t i = 0; i < n; i++) {
+                records[i] = _buffer[(tail + i) & (SIZE - 1)];
+            }
+            core_util_atomic_store_u32(&_tail, tail + n);
+            return n;
+        }
+
+        uint16_t size() const {
+            return core_util_atomic_load_u32(&_head) - core_util_atomic_load_u32(&_tail);
+        }
+
+        uint32_t dropped() const {
+            return _dropped;
+        }
+    private:
+        ds7505_record_t _buffer[SIZE];
+        volatile uint32_t _head;    // written by the producer only
+        volatile uint32_t _tail;    // written by the consumer only
+        uint32_t _dropped;
+};
+
+#endif
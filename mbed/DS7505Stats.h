@@ -0,0 +1,87 @@
+/**
+Running statistics of one sensor, updated in O(1) with every new sample so the
+application ships aggregates instead of sample arrays. Samples are grouped in
+windows of a fixed number of reads; when a window is full its min/max/mean,
+the EMA and the p50/p90/p99 of a histogram sketch are frozen in snapshot() and
+the next window starts. The EMA runs across windows.
+The sketch has one 16-bit counter per 0.5 degC (DS7505_STATS_BIN_SHIFT) from
+-55 to +125 degC, percentiles are the bin centres. It is scanned once per
+window and by current(), never on update().
+example:
+I2C i2c(PB_9, PB_8);
+DS7505 ds7505(i2c);
+DS7505Stats stats(60);
+
+int main()
+{
+    while(1) {
+        if(ds7505.getTemp() == DS7505_SUCCESS && stats.update(ds7505)) {
+            const ds7505_summary_t &s = stats.snapshot();
+            tr_info("min %ld max %ld mean %ld p99 %ld centi C", DS7505Protocol::rawToCenti(s.min_raw),
+                    DS7505Protocol::rawToCenti(s.max_raw), DS7505Protocol::rawToCenti(s.mean_raw),
+                    DS7505Protocol::rawToCenti(s.p99_raw));
+        }
+        thread_sleep_for(1000);
+    }
+}
+ */
+
+#ifndef _DS7505STATS_H
+#define _DS7505STATS_H
+
+#include "DS7505.h"
+
+// histogram bin width in raw LSB (1/256 degC), 7 -> 0.5 degC, 361 bins
+#ifndef DS7505_STATS_BIN_SHIFT
+#define DS7505_STATS_BIN_SHIFT      7
+#endif
+// EMA weight of a new sample is 1/2^DS7505_STATS_EMA_SHIFT
+#ifndef DS7505_STATS_EMA_SHIFT
+#define DS7505_STATS_EMA_SHIFT      3
+#endif
+#define DS7505_STATS_MIN_RAW        (-55 * 256)
+#define DS7505_STATS_MAX_RAW        (125 * 256)
+#define DS7505_STATS_BINS           \
+    (((DS7505_STATS_MAX_RAW - DS7505_STATS_MIN_RAW) >> DS7505_STATS_BIN_SHIFT) + 1)
+
+struct ds7505_summary_t {
+    uint32_t window;        // number of the window, counts from 1
+    uint16_t count;         // samples in the window
+    int16_t min_raw;        // 1/256 degC per LSB like temperature_raw
+    int16_t max_raw;
+    int16_t mean_raw;
+    int16_t ema_raw;
+    int16_t p50_raw;
+    int16_t p90_raw;
+    int16_t p99_raw;
+};
+
+class DS7505Stats {
+    public:
+        DS7505Stats(uint16_t window);
+
+        // true when the sample closed a window and snapshot() changed
+        bool update(int16_t raw);
+        bool update(const DS7505 &sensor);
+
+        const ds7505_summary_t &snapshot() const;
+        // the window in progress, scans the histogram
+        void current(ds7505_summary_t &summary) const;
+        void reset();
+    private:
+        uint16_t _window;
+        uint16_t _count;
+        uint32_t _windows;
+        int16_t _min;
+        int16_t _max;
+        int32_t _sum;       // 65535 samples of 0x7FF0 still fit
+        int32_t _ema;       // raw << DS7505_STATS_EMA_SHIFT
+        bool _emaValid;
+        uint16_t _bins[DS7505_STATS_BINS];
+        ds7505_summary_t _snapshot;
+
+        int16_t percentile(uint16_t perMille) const;
+        void fill(ds7505_summary_t &summary) const;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "DS7505Sim.h"
+
+#include <math.h>
+
+#define CFG_NVB     0x80
+#define CFG_RES     0x60
+#define CFG_FAULT   0x18
+#define CFG_POL     0x04
+#define CFG_TM      0x02
+#define CFG_SD      0x01
+
+#define REG_TEMPER  0x00
+#define REG_CONFIG  0x01
+#define REG_T_HYST  0x02
+#define REG_T_OS    0x03
+
+#define CMD_RECALL_DATA     0xB8
+#define CMD_COPY_DATA       0x48
+#define CMD_SOFTWARE_POR    0x54
+
+// TOS and THYST keep 9 significant bits (0.5 degC)
+#define LIMIT_MASK  0xFF80
+
+DS7505Sim::DS7505Sim(uint8_t addr, float ambient): _addr(addr),
+                                                   _ambient(ambient),
+                                                   _rate(0),
+                                                   _ambientAt(0),
+                                                   _eeConfig(0x00),
+                                                   _eeTos(80 << 8),
+                                                   _eeThyst(75 << 8),
+                                                   _eepromDoneAt(0),
+                                                   _conversions(0)
+{
+    powerOn(0);
+}
+
+uint8_t DS7505Sim::address() const {
+    return _addr;
+}
+
+void DS7505Sim::setAmbient(float ambient, float ratePerSecond){
+    _ambient = ambient;
+    _rate = ratePerSecond;
+    _ambientAt = 0;
+}
+
+float DS7505Sim::ambient(uint64_t nowNs) const {
+    return _ambient + _rate * ((nowNs - _ambientAt) / 1e9f);
+}
+
+void DS7505Sim::powerOn(uint64_t nowNs){
+    _pointer = REG_TEMPER;
+    _temperature = 0;
+    _os = false;
+    _tripped = false;
+    _faults = 0;
+    loadEEPROM();
+    _converting = (_config & CFG_SD) == 0;
+    _conversionDoneAt = nowNs + conversionTimeNs(_config);
+}
+
+uint64_t DS7505Sim::conversionTimeNs(uint8_t config){
+    return 25000000ULL << ((config & CFG_RES) >> 5);
+}
+
+void DS7505Sim::update(uint64_t nowNs){
+    if(_eepromDoneAt != 0 && nowNs >= _eepromDoneAt) {
+        _eepromDoneAt = 0;
+        _config &= ~CFG_NVB;
+    }
+    while(_converting && nowNs >= _conversionDoneAt) {
+        finishConversion(_conversionDoneAt);
+        if(_config & CFG_SD) {
+            _converting = false;
+        } else {
+            _conversionDoneAt += conversionTimeNs(_config);
+        }
+    }
+}
+
+void DS7505Sim::finishConversion(uint64_t atNs){
+    static const uint16_t resMask[4] = { 0xFF80, 0xFFC0, 0xFFE0, 0xFFF0 };
+    float t = ambient(atNs);
+    if(t > 125.0f) {
+        t = 125.0f;
+    } else if(t < -55.0f) {
+        t = -55.0f;
+    }
+    int32_t raw = (int32_t)floorf(t * 256.0f);
+    _temperature = (int16_t)(raw & resMask[(_config & CFG_RES) >> 5]);
+    _conversions++;
+
+    // O.S. fault queue: 1, 2, 4 or 6 consecutive conversions
+    static const uint8_t queue[4] = { 1, 2, 4, 6 };
+    uint8_t needed = queue[(_config & CFG_FAULT) >> 3];
+    bool fault = _tripped ? (_temperature < _thyst) : (_temperature >= _tos);
+    if(fault) {
+        if(++_faults >= needed) {
+            _faults = 0;
+            _tripped = !_tripped;
+            // interrupt mode: asserted on every crossing, cleared by any read
+            _os = (_config & CFG_TM) ? true : _tripped;
+        }
+    } else {
+        _faults = 0;
+    }
+}
+
+void DS7505Sim::loadEEPROM(){
+    _config = _eeConfig;
+    _tos = _eeTos;
+    _thyst = _eeThyst;
+}
+
+void DS7505Sim::command(uint8_t cmd, uint64_t nowNs){
+    switch(cmd) {
+        case CMD_COPY_DATA:
+            _eeConfig = _config & ~CFG_NVB;
+            _eeTos = _tos;
+            _eeThyst = _thyst;
+            _config |= CFG_NVB;
+            _eepromDoneAt = nowNs + DS7505SIM_EEPROM_WRITE_NS;
+            break;
+        case CMD_RECALL_DATA:
+            loadEEPROM();
+            break;
+        case CMD_SOFTWARE_POR:
+            powerOn(nowNs);
+            break;
+    }
+}
+
+void DS7505Sim::write(const uint8_t *data, int length, uint64_t nowNs){
+    update(nowNs);
+    if(length <= 0) {
+        return;
+    }
+    if(_config & CFG_NVB) {
+        return;
+    }
+    if(length == 1 && (data[0] == CMD_COPY_DATA || data[0] == CMD_RECALL_DATA ||
+                       data[0] == CMD_SOFTWARE_POR)) {
+        command(data[0], nowNs);
+        return;
+    }
+    _pointer = data[0] & 0x03;
+    if(length == 1) {
+        return;
+    }
+    switch(_pointer) {
+        case REG_CONFIG: {
+            bool wasShutdown = (_config & CFG_SD) != 0;
+            _config = (_config & CFG_NVB) | (data[1] & ~CFG_NVB);
+            if(wasShutdown && !(_config & CFG_SD) && !_converting) {
+                _converting = true;
+                _conversionDoneAt = nowNs + conversionTimeNs(_config);
+            }
+            break;
+        }
+        case REG_T_HYST:
+        case REG_T_OS: {
+            int16_t value = (int16_t)(data[1] << 8);
+            if(length > 2) {
+                value |= data[2];
+            }
+            value &= LIMIT_MASK;
+            if(_pointer == REG_T_OS) {
+                _tos = value;
+            } else {
+                _thyst = value;
+            }
+            break;
+        }
+        default:
+            // temperature register is read only
+            break;
+    }
+}
+
+void DS7505Sim::read(uint8_t *data, int length, uint64_t nowNs){
+    update(nowNs);
+    for(int i = 0; i < length; i++) {
+        switch(_pointer) {
+            case REG_CONFIG:
+                data[i] = _config;
+                break;
+            case REG_TEMPER:
+                data[i] = (i % 2) ? (_temperature & 0xFF) : ((uint16_t)_temperature >> 8);
+                break;
+            case REG_T_HYST:
+                data[i] = (i % 2) ? (_thyst & 0xFF) : ((uint16_t)_thyst >> 8);
+                break;
+            default:
+                data[i] = (i % 2) ? (_tos & 0xFF) : ((uint16_t)_tos >> 8);
+                break;
+        }
+    }
+    if(_config & CFG_TM) {
+        _os = false;
+    }
+}
+
+uint8_t DS7505Sim::pointer() const {
+    return _pointer;
+}
+
+uint8_t DS7505Sim::config() const {
+    return _config;
+}
+
+int16_t DS7505Sim::temperatureRaw() const {
+    return _temperature;
+}
+
+int16_t DS7505Sim::tosRaw() const {
+    return _tos;
+}
+
+int16_t DS7505Sim::thystRaw() const {
+    return _thyst;
+}
+
+bool DS7505Sim::os() const {
+    // POL = 0: O.S. is active low
+    return (_config & CFG_POL) ? _os : !_os;
+}
+
+bool DS7505Sim::eepromBusy() const {
+    return (_config & CFG_NVB) != 0;
+}
+
+uint32_t DS7505Sim::conversions() const {
+    return _conversions;
+}
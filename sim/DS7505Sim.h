@@ -0,0 +1,80 @@
+/**
+Register model of one DS7505 for host-side testing. It follows the datasheet
+closely enough to exercise the driver:
+- pointer register kept between transactions, 1-byte writes of 0xB8/0x48/0x54
+  are executed as commands,
+- CONFIG with NVB (read only), R1:R0, F1:F0, POL, TM and SD bits,
+- conversions finish every 25/50/100/200 ms depending on R1:R0, the result is
+  truncated to the selected resolution,
+- SHUTDOWN lets the conversion in progress finish and then stops converting,
+- COPY_DATA keeps NVB set for the EEPROM write time, register writes and
+  commands are ignored while NVB is set,
+- O.S. output in comparator and interrupt mode with the fault queue.
+Time is virtual and owned by the SimBus the device is attached to.
+ */
+
+#ifndef _DS7505SIM_H
+#define _DS7505SIM_H
+
+#include <stdint.h>
+
+#define DS7505SIM_EEPROM_WRITE_NS   10000000ULL  // tWR, 10ms
+
+class DS7505Sim {
+    public:
+        DS7505Sim(uint8_t addr = 0x48, float ambient = 21.5f);
+
+        uint8_t address() const;
+
+        // ambient temperature seen by the ADC, rate in degC per second
+        void setAmbient(float ambient, float ratePerSecond = 0.0f);
+        float ambient(uint64_t nowNs) const;
+
+        // bus side, called by SimBus with the current virtual time
+        void powerOn(uint64_t nowNs);
+        void update(uint64_t nowNs);
+        void write(const uint8_t *data, int length, uint64_t nowNs);
+        void read(uint8_t *data, int length, uint64_t nowNs);
+
+        // state inspection
+        uint8_t pointer() const;
+        uint8_t config() const;
+        int16_t temperatureRaw() const;
+        int16_t tosRaw() const;
+        int16_t thystRaw() const;
+        bool os() const;
+        bool eepromBusy() const;
+        uint32_t conversions() const;
+
+        static uint64_t conversionTimeNs(uint8_t config);
+    private:
+        uint8_t _addr;
+        float _ambient;
+        float _rate;
+        uint64_t _ambientAt;
+
+        uint8_t _pointer;
+        uint8_t _config;
+        int16_t _temperature;
+        int16_t _tos;
+        int16_t _thyst;
+
+        uint8_t _eeConfig;
+        int16_t _eeTos;
+        int16_t _eeThyst;
+        uint64_t _eepromDoneAt;
+
+        bool _converting;
+        uint64_t _conversionDoneAt;
+        uint32_t _conversions;
+
+        bool _os;
+        bool _tripped;
+        uint8_t _faults;
+
+        void finishConversion(uint64_t atNs);
+        void command(uint8_t cmd, uint64_t nowNs);
+        void loadEEPROM();
+};
+
+#endif
@@ -0,0 +1,50 @@
+/**
+Bus policy of DS7505Core straight on a SimBus, see core/DS7505Core.h.
+ */
+
+#ifndef _DS7505SIMBUS_H
+#define _DS7505SIMBUS_H
+
+#include "SimBus.h"
+#include "DS7505Core.h"
+
+class DS7505SimBus {
+    public:
+        explicit DS7505SimBus(SimBus &bus): _bus(bus) {}
+
+        int write(uint8_t addr, const uint8_t *data, int length) {
+            SimBus::Msg msg = { addr, false, (uint8_t *)data, length };
+            return _bus.transfer(&msg, 1);
+        }
+
+        int read(uint8_t addr, uint8_t *data, int length) {
+            SimBus::Msg msg = { addr, true, data, length };
+            return _bus.transfer(&msg, 1);
+        }
+
+        int writeRead(uint8_t addr, const uint8_t *wdata, int wlength, uint8_t *rdata, int rlength) {
+            SimBus::Msg msgs[2] = {
+                { addr, false, (uint8_t *)wdata, wlength },
+                { addr, true, rdata, rlength }
+            };
+            return _bus.transfer(msgs, 2);
+        }
+
+        int transfer(uint8_t addr, DS7505Protocol::msg_t *msgs, int count) {
+            SimBus::Msg simMsgs[DS7505Protocol::TRANSFER_MAX];
+            if(count > DS7505Protocol::TRANSFER_MAX) {
+                return -1;
+            }
+            for(int i = 0; i < count; i++) {
+                simMsgs[i].addr = addr;
+                simMsgs[i].read = msgs[i].read;
+                simMsgs[i].buf = msgs[i].data;
+                simMsgs[i].len = msgs[i].length;
+            }
+            return _bus.transfer(simMsgs, count);
+        }
+    private:
+        SimBus &_bus;
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "SimBus.h"
+
+#include <stdio.h>
+#include <string.h>
+
+SimBus::SimBus(uint32_t frequency): _now(0),
+                                    _bitNs(1000000000ULL / frequency),
+                                    _callNs(0),
+                                    _busyNs(SIMBUS_BUSY_TIMEOUT_NS),
+                                    _failNext(0),
+                                    _holdPulses(0),
+                                    _open(false)
+{
+    memset(_devices, 0, sizeof(_devices));
+    resetStats();
+}
+
+SimBus &SimBus::defaultBus(){
+    static SimBus bus;
+    return bus;
+}
+
+int SimBus::attach(DS7505Sim &dev){
+    for(int i = 0; i < SIMBUS_MAX_DEVICES; i++) {
+        if(_devices[i] == NULL || _devices[i]->address() == dev.address()) {
+            _devices[i] = &dev;
+            dev.powerOn(_now);
+            return SIMBUS_SUCCESS;
+        }
+    }
+    return SIMBUS_NACK;
+}
+
+void SimBus::detach(uint8_t addr){
+    for(int i = 0; i < SIMBUS_MAX_DEVICES; i++) {
+        if(_devices[i] != NULL && _devices[i]->address() == addr) {
+            _devices[i] = NULL;
+        }
+    }
+}
+
+DS7505Sim *SimBus::device(uint8_t addr){
+    for(int i = 0; i < SIMBUS_MAX_DEVICES; i++) {
+        if(_devices[i] != NULL && _devices[i]->address() == addr) {
+            return _devices[i];
+        }
+    }
+    return NULL;
+}
+
+void SimBus::frequency(uint32_t hz){
+    _bitNs = 1000000000ULL / hz;
+}
+
+void SimBus::callOverhead(uint64_t ns){
+    _callNs = ns;
+}
+
+void SimBus::busyTimeout(uint64_t ns){
+    _busyNs = ns;
+}
+
+void SimBus::failNext(uint32_t count){
+    _failNext = count;
+}
+
+void SimBus::holdSda(uint8_t pulses){
+    _holdPulses = pulses;
+}
+
+bool SimBus::sdaHeld() const {
+    return _holdPulses != 0;
+}
+
+void SimBus::clockScl(){
+    clock(1);
+    if(_holdPulses != 0) {
+        _holdPulses--;
+    }
+}
+
+void SimBus::stopCondition(){
+    clock(1);
+    _open = false;
+}
+
+void SimBus::recover(){
+    for(int i = 0; i < 9; i++) {
+        clockScl();
+    }
+    stopCondition();
+}
+
+int SimBus::transfer(const Msg *msgs, int count){
+    _stats.calls++;
+    _now += _callNs;
+    int ret = fault();
+    if(ret != SIMBUS_SUCCESS) {
+        return ret;
+    }
+    for(int i = 0; i < count && ret == SIMBUS_SUCCESS; i++) {
+        ret = message(msgs[i]);
+    }
+    stop();
+    return ret;
+}
+
+int SimBus::write(uint8_t addr, const uint8_t *data, int length, bool repeated){
+    Msg msg = { addr, false, (uint8_t *)data, length };
+    _stats.calls++;
+    _now += _callNs;
+    int ret = fault();
+    if(ret == SIMBUS_SUCCESS) {
+        ret = message(msg);
+    }
+    if(!repeated || ret != SIMBUS_SUCCESS) {
+        stop();
+    }
+    return ret;
+}
+
+int SimBus::read(uint8_t addr, uint8_t *data, int length, bool repeated){
+    Msg msg = { addr, true, data, length };
+    _stats.calls++;
+    _now += _callNs;
+    int ret = fault();
+    if(ret == SIMBUS_SUCCESS) {
+        ret = message(msg);
+    }
+    if(!repeated || ret != SIMBUS_SUCCESS) {
+        stop();
+    }
+    return ret;
+}
+
+// a held SDA blocks the START until the master gives up, an injected NACK
+// costs the address byte
+int SimBus::fault(){
+    if(_holdPulses != 0) {
+        _now += _busyNs;
+        _stats.busErrors++;
+        _open = false;
+        return SIMBUS_BUS_ERROR;
+    }
+    if(_failNext != 0) {
+        _failNext--;
+        if(!_open) {
+            _stats.transactions++;
+        }
+        clock(1 + 9 + 1);
+        _open = false;
+        _stats.nacks++;
+        return SIMBUS_NACK;
+    }
+    return SIMBUS_SUCCESS;
+}
+
+int SimBus::message(const Msg &msg){
+    if(!_open) {
+        _stats.transactions++;
+        _open = true;
+    }
+    _stats.messages++;
+    // START or Sr, address byte and its ACK
+    clock(1 + 9);
+
+    DS7505Sim *dev = device(msg.addr);
+    if(dev == NULL) {
+        _stats.nacks++;
+        return SIMBUS_NACK;
+    }
+    clock(9 * msg.len);
+    _stats.bytes += msg.len;
+    if(msg.read) {
+        dev->read(msg.buf, msg.len, _now);
+    } else {
+        dev->write(msg.buf, msg.len, _now);
+    }
+    return SIMBUS_SUCCESS;
+}
+
+void SimBus::stop(){
+    if(_open) {
+        clock(1);
+        _open = false;
+    }
+}
+
+void SimBus::clock(uint32_t bits){
+    uint64_t ns = bits * _bitNs;
+    _now += ns;
+    _stats.busTimeNs += ns;
+}
+
+uint64_t SimBus::now() const {
+    return _now;
+}
+
+void SimBus::sleep(uint64_t ns){
+    _now += ns;
+}
+
+const SimBus::Stats &SimBus::stats() const {
+    return _stats;
+}
+
+void SimBus::resetStats(){
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void SimBus::printStats(const char *label, uint32_t samples) const {
+    if(samples == 0) {
+        samples = 1;
+    }
+    printf("%s: %u samples, %.2f calls/sample, %.2f transactions/sample, "
+           "%.2f bytes/sample, %.1f us bus time/sample, %u nacks, %u bus errors\n",
+           label, samples,
+           (double)_stats.calls / samples,
+           (double)_stats.transactions / samples,
+           (double)_stats.bytes / samples,
+           _stats.busTimeNs / 1000.0 / samples,
+           _stats.nacks,
+           _stats.busErrors);
+}
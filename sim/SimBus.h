@@ -0,0 +1,103 @@
+/**
+Simulated I2C bus with a virtual clock. Up to eight DS7505Sim devices are
+attached by their 7-bit address. Every message advances the clock by its
+wire time at the configured SCL frequency (START/Sr, address byte, data bytes,
+ACK bits, STOP), so the statistics give transactions, bytes and bus time per
+driver call without any hardware.
+
+A transaction is everything between START and STOP, a repeated start keeps
+the current transaction open. A call is one entry from the driver into the
+bus layer (one mbed I2C::read/write, one Zephyr i2c_transfer, one ioctl).
+
+Faults for the retry paths: failNext() NACKs the next transfers, holdSda()
+models a slave that keeps SDA low. While SDA is held every call fails with
+SIMBUS_BUS_ERROR after the bus-busy timeout of the master; the slave lets go
+after the given number of SCL pulses from clockScl() (bit-banged recovery) or
+recover() (recovery done by the bus driver).
+ */
+
+#ifndef _SIMBUS_H
+#define _SIMBUS_H
+
+#include <stdint.h>
+
+#include "DS7505Sim.h"
+
+#define SIMBUS_MAX_DEVICES  8
+
+#define SIMBUS_SUCCESS  0
+#define SIMBUS_NACK     -1
+#define SIMBUS_BUS_ERROR    -2
+
+// bus-busy timeout of a typical MCU driver
+#define SIMBUS_BUSY_TIMEOUT_NS  25000000ULL
+
+class SimBus {
+    public:
+        struct Msg {
+            uint8_t addr;
+            bool read;
+            uint8_t *buf;
+            int len;
+        };
+
+        struct Stats {
+            uint32_t calls;
+            uint32_t transactions;
+            uint32_t messages;
+            uint32_t bytes;
+            uint32_t nacks;
+            uint32_t busErrors;
+            uint64_t busTimeNs;
+        };
+
+        SimBus(uint32_t frequency = 100000);
+
+        static SimBus &defaultBus();
+
+        int attach(DS7505Sim &dev);
+        void detach(uint8_t addr);
+        DS7505Sim *device(uint8_t addr);
+
+        void frequency(uint32_t hz);
+        void callOverhead(uint64_t ns);
+        void busyTimeout(uint64_t ns);
+
+        void failNext(uint32_t count);
+        void holdSda(uint8_t pulses);
+        bool sdaHeld() const;
+        void clockScl();
+        void stopCondition();
+        // nine SCL pulses and a STOP, what an adapter driver does
+        void recover();
+
+        // one driver call, messages separated by repeated starts, STOP at the end
+        int transfer(const Msg *msgs, int count);
+        // mbed style, repeated = true leaves the transaction open (no STOP)
+        int write(uint8_t addr, const uint8_t *data, int length, bool repeated = false);
+        int read(uint8_t addr, uint8_t *data, int length, bool repeated = false);
+
+        uint64_t now() const;
+        void sleep(uint64_t ns);
+
+        const Stats &stats() const;
+        void resetStats();
+        void printStats(const char *label, uint32_t samples) const;
+    private:
+        DS7505Sim *_devices[SIMBUS_MAX_DEVICES];
+        uint64_t _now;
+        uint64_t _bitNs;
+        uint64_t _callNs;
+        uint64_t _busyNs;
+        uint32_t _failNext;
+        uint8_t _holdPulses;
+        bool _open;
+        Stats _stats;
+
+        int fault();
+        int message(const Msg &msg);
+        void stop();
+        void clock(uint32_t bits);
+};
+
+#endif
@@ -0,0 +1,660 @@
+/**
+Host benchmark of the C++ ports on the simulated bus. Build against the mbed
+port (default) or the Linux port (-DSIM_LINUX), see README.md.
+ */
+
+#include <stdio.h>
+#include <chrono>
+
+#include "DS7505.h"
+#include "DS7505Bus.h"
+#include "DS7505Scheduler.h"
+#include "DS7505Eeprom.h"
+#include "DS7505Stats.h"
+#include "DS7505Codec.h"
+#include "DS7505OneShot.h"
+#include "DS7505Adaptive.h"
+#include "DS7505Co.h"
+#ifndef SIM_LINUX
+#include "DS7505Alert.h"
+#endif
+#include "DS7505Sim.h"
+#include "SimBus.h"
+#include "DS7505Core.h"
+#include "DS7505SimBus.h"
+#ifdef SIM_LINUX
+#include "DS7505LinuxBus.h"
+#include "DS7505Shm.h"
+#include "DS7505Engine.h"
+#else
+#include "DS7505MbedBus.h"
+#endif
+
+#define SAMPLES 1000
+
+#ifdef SIM_LINUX
+I2CDev i2c("/dev/i2c-sim");
+DS7505LinuxBus portBus(i2c);
+typedef DS7505Core<DS7505LinuxBus, 0x48, DS7505Protocol::BITS_12> PortCore;
+#define PORT_NAME "linux"
+#else
+I2C i2c(PB_9, PB_8);
+DS7505MbedBus portBus(i2c);
+typedef DS7505Core<DS7505MbedBus, 0x48, DS7505Protocol::BITS_12> PortCore;
+#define PORT_NAME "mbed"
+#endif
+
+DS7505Sim sensor(0x48, 21.5f);
+DS7505 ds7505(i2c);
+
+DS7505Sim others[6] = {
+    DS7505Sim(0x49), DS7505Sim(0x4A), DS7505Sim(0x4B),
+    DS7505Sim(0x4C), DS7505Sim(0x4D), DS7505Sim(0x4E)
+};
+DS7505Bus sensors(i2c);
+DS7505Bus::sample_t samples[DS7505_BUS_MAX_SENSORS];
+
+#if DEVICE_I2C_ASYNCH
+static uint32_t asyncDone = 0;
+
+static void onTemp(int8_t status, float temperature)
+{
+    (void)temperature;
+    if(status == DS7505_SUCCESS) {
+        asyncDone++;
+    }
+}
+#endif
+
+#ifndef SIM_LINUX
+EventQueue queue;
+static uint32_t alerts = 0;
+static int8_t committed = DS7505_ERROR;
+static uint64_t committedAt = 0;
+
+static void onCommit(DS7505 *sensor, int8_t status)
+{
+    (void)sensor;
+    committed = status;
+    committedAt = SimBus::defaultBus().now();
+}
+
+static uint32_t oneShots = 0;
+
+static void onOneShot(DS7505 *sensor, int8_t status)
+{
+    (void)sensor;
+    if(status == DS7505_SUCCESS) {
+        oneShots++;
+    }
+}
+
+static void onAlert(DS7505 *sensor, int8_t status)
+{
+    (void)sensor;
+    if(status == DS7505_SUCCESS) {
+        alerts++;
+    }
+}
+#endif
+
+#ifdef DS7505_INSTRUMENT
+static void printInstrumentation(const char *label, const DS7505 &sensor)
+{
+    static const char *const names[DS7505_INSTR_OPS] = { "pointer", "read", "config", "command" };
+    ds7505_instr_t instr;
+    sensor.instrumentation(instr);
+    for(int op = 0; op < DS7505_INSTR_OPS; op++) {
+        const ds7505_op_stats_t &stats = instr.op[op];
+        if(stats.count == 0) {
+            continue;
+        }
+        printf("%s %-7s: %6u calls, %u errors (%u nacks, %u timeouts), %u retries, %.1f us mean, "
+               "%u us max, histogram", label, names[op], stats.count, stats.errors, stats.nacks,
+               stats.timeouts, stats.retries, (double)stats.total_us / stats.count, stats.max_us);
+        for(int b = 0; b < DS7505_INSTR_BUCKETS; b++) {
+            printf(" %u", stats.latency[b]);
+        }
+        printf("\n");
+    }
+}
+#endif
+
+// runs the scheduler for ms of virtual time, returns the new samples of sensor 0;
+// fineMs gets the time the adaptive sensor spent at the fine resolution
+static uint32_t runScheduled(DS7505Scheduler &scheduler, DS7505Adaptive *adaptive, uint64_t ms,
+                             uint64_t &fineMs)
+{
+    SimBus &bus = SimBus::defaultBus();
+    uint64_t end = bus.now() + ms * 1000000ULL;
+    uint32_t fresh = 0;
+    while(bus.now() < end) {
+        uint32_t nowMs = bus.now() / 1000000;
+        if(scheduler.run(nowMs) & 0x01) {
+            fresh++;
+            if(adaptive != NULL) {
+                adaptive->update(nowMs);
+            }
+        }
+        uint64_t wait = scheduler.nextDueMs(bus.now() / 1000000) * 1000000ULL;
+        if(wait > end - bus.now()) {
+            wait = end - bus.now();
+        }
+        if(adaptive != NULL && adaptive->fine()) {
+            fineMs += wait / 1000000;
+        }
+        bus.sleep(wait ? wait : 1000000ULL);
+    }
+    return fresh;
+}
+
+// the blocking sequence as one coroutine: reads at 12 bits, one-shot reads, EEPROM commit
+static DS7505CoTask coAcquire(DS7505 &sensor, DS7505CoSensor &co, int reads, uint32_t &fresh,
+                              uint32_t &shots, int8_t &commit)
+{
+    sensor.setResolution(DS7505::BITS_12);
+    co.restart();
+    for(int i = 0; i < reads; i++) {
+        if(co_await co.readTemperature() == DS7505_SUCCESS) {
+            fresh++;
+        }
+    }
+    for(int i = 0; i < 10; i++) {
+        if(co_await co.readOneShot() == DS7505_SUCCESS) {
+            shots++;
+        }
+    }
+    sensor.setTempOSCenti(5000);
+    commit = co_await co.commitEeprom();
+    co_return commit;
+}
+
+static DS7505CoTask coTicker(DS7505CoLoop &loop, uint32_t periodMs, int ticks, uint32_t &done)
+{
+    for(int i = 0; i < ticks; i++) {
+        co_await loop.sleep(periodMs);
+        done++;
+    }
+    co_return DS7505_SUCCESS;
+}
+
+int main()
+{
+    SimBus &bus = SimBus::defaultBus();
+    bus.attach(sensor);
+    sensor.setAmbient(21.5f, 0.1f);
+
+    ds7505.setConfigReg(DS7505::BITS_12);
+
+    // back-to-back reads, the bus cost of one getTemp()
+    bus.resetStats();
+    uint64_t start = bus.now();
+    for(int i = 0; i < SAMPLES; i++) {
+        ds7505.getTemp();
+    }
+    uint64_t latency = (bus.now() - start) / SAMPLES;
+    bus.printStats(PORT_NAME " getTemp", SAMPLES);
+    printf("%s getTemp: %.1f us latency/sample\n", PORT_NAME, latency / 1000.0);
+#ifndef SIM_LINUX
+    DS7505::reading_t reading;
+    ds7505.latest(reading);
+    printf("%s latest: %u published, last %d centi C\n", PORT_NAME, reading.count,
+           DS7505Protocol::rawToCenti(reading.temperature_raw));
+#endif
+
+    // the header-only core on the port's bus and straight on SimBus
+    PortCore core(portBus);
+    core.init();
+    bus.resetStats();
+    for(int i = 0; i < SAMPLES; i++) {
+        core.getTemp();
+    }
+    bus.printStats(PORT_NAME " DS7505Core", SAMPLES);
+    DS7505SimBus simBus(bus);
+    DS7505Core<DS7505SimBus, 0x48, DS7505Protocol::BITS_12> simCore(simBus);
+    simCore.init();
+    bus.resetStats();
+    for(int i = 0; i < SAMPLES; i++) {
+        simCore.getTemp();
+        simCore.shutDown();
+        simCore.wakeUp();
+    }
+    bus.printStats(PORT_NAME " DS7505Core<SimBus> getTemp+shutDown+wakeUp", SAMPLES);
+    printf("%s DS7505Core: %ld centi C, %u ms conversion, raw mask 0x%04x\n", PORT_NAME,
+           (long)DS7505Protocol::rawToCenti(simCore.temperatureRaw()), PortCore::conversionTimeMs,
+           (uint16_t)PortCore::rawMask);
+
+#if DEVICE_I2C_ASYNCH
+    bus.resetStats();
+    for(int i = 0; i < SAMPLES; i++) {
+        ds7505.getTempAsync(onTemp);
+    }
+    bus.printStats(PORT_NAME " getTempAsync", SAMPLES);
+    printf("%s getTempAsync: %u callbacks\n", PORT_NAME, asyncDone);
+#endif
+
+    // one read per conversion, aggregated in windows of 100 samples
+    static DS7505Stats stats(100);
+    uint32_t windows = 0;
+    bus.resetStats();
+    uint32_t conversions = sensor.conversions();
+    for(int i = 0; i < SAMPLES; i++) {
+        bus.sleep(DS7505Sim::conversionTimeNs(sensor.config()));
+        if(ds7505.getTemp() == DS7505_SUCCESS && stats.update(ds7505)) {
+            windows++;
+        }
+    }
+    bus.printStats(PORT_NAME " paced getTemp", SAMPLES);
+    printf("%s paced getTemp: %u conversions, last %f C\n", PORT_NAME,
+           sensor.conversions() - conversions, ds7505.ds7505.temperature);
+    const ds7505_summary_t &summary = stats.snapshot();
+    printf("%s DS7505Stats: %u windows, window %u: min %ld max %ld mean %ld ema %ld "
+           "p50 %ld p90 %ld p99 %ld centi C\n", PORT_NAME, windows, summary.window,
+           (long)DS7505Protocol::rawToCenti(summary.min_raw), (long)DS7505Protocol::rawToCenti(summary.max_raw),
+           (long)DS7505Protocol::rawToCenti(summary.mean_raw), (long)DS7505Protocol::rawToCenti(summary.ema_raw),
+           (long)DS7505Protocol::rawToCenti(summary.p50_raw), (long)DS7505Protocol::rawToCenti(summary.p90_raw),
+           (long)DS7505Protocol::rawToCenti(summary.p99_raw));
+
+    // the same kind of paced stream on a 0.1 C/s ramp, encoded and decoded back
+    static uint8_t page[4096];
+    static int16_t logged[SAMPLES];
+    static int16_t decoded[SAMPLES];
+    DS7505Encoder encoder(page, sizeof(page));
+    sensor.setAmbient(21.5f, 0.1f);
+    for(int i = 0; i < SAMPLES; i++) {
+        bus.sleep(DS7505Sim::conversionTimeNs(sensor.config()));
+        ds7505.getTemp();
+        logged[i] = ds7505.ds7505.temperature_raw;
+        encoder.push(ds7505);
+    }
+    uint16_t used = encoder.flush();
+    uint32_t mismatches = 0;
+    uint16_t count = 0;
+    const int rounds = 1000;
+    auto decodeStart = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; r++) {
+        DS7505Decoder decoder(page, sizeof(page));
+        count = decoder.decode(decoded, SAMPLES);
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                               decodeStart).count();
+    for(int i = 0; i < SAMPLES; i++) {
+        if(i >= count || decoded[i] != logged[i]) {
+            mismatches++;
+        }
+    }
+    printf("%s DS7505Codec: %u samples in %u bytes, %.2f bits/sample, %.1fx smaller than float, "
+           "%u mismatches, decode %.1f ns/sample\n", PORT_NAME, count, used, used * 8.0 / SAMPLES,
+           SAMPLES * 4.0 / used, mismatches, decodeNs / rounds / SAMPLES);
+
+    // shutdown/wake cycle
+    bus.resetStats();
+    for(int i = 0; i < SAMPLES; i++) {
+        ds7505.shutDown();
+        ds7505.wakeUp();
+    }
+    bus.printStats(PORT_NAME " shutDown+wakeUp", SAMPLES);
+
+    // EEPROM commit
+    bus.resetStats();
+    start = bus.now();
+    ds7505.copySRAMtoEPRROM();
+    uint32_t polls = 0;
+    while(ds7505.memoryBusy()) {
+        polls++;
+    }
+    printf("%s copySRAMtoEPRROM: busy for %.2f ms, %u polls\n", PORT_NAME,
+           (bus.now() - start) / 1e6, polls);
+
+    // the same commit with NVB checks on a backoff
+    DS7505Eeprom eeprom(ds7505
+#ifndef SIM_LINUX
+                        , queue
+#endif
+                        );
+    bus.resetStats();
+    start = bus.now();
+#ifdef SIM_LINUX
+    eeprom.commit(bus.now() / 1000000);
+    int8_t committed;
+    while((committed = eeprom.run(bus.now() / 1000000)) == DS7505_EEPROM_PENDING) {
+        bus.sleep(eeprom.nextDueMs(bus.now() / 1000000) * 1000000ULL);
+    }
+    uint64_t committedAt = bus.now();
+#else
+    eeprom.commit(callback(onCommit));
+    queue.dispatch_for(std::chrono::milliseconds(200));
+#endif
+    printf("%s DS7505Eeprom commit: status %d after %.2f ms, %u bus calls\n", PORT_NAME,
+           committed, (committedAt - start) / 1e6, bus.stats().calls);
+
+    // provisioning: setters with read-back, then one batched profile
+    bus.resetStats();
+    ds7505.setConfigReg(DS7505::BITS_12, DS7505::OUT_OF_LIMITS_TRIG_4, DS7505::ACTIVE_LOW, DS7505::COMPARATOR);
+    ds7505.setTempOS(60.0f);
+    ds7505.setTempHyst(55.0f);
+    ds7505.getConfigReg();
+    ds7505.getTempOS();
+    ds7505.getTempHYST();
+    ds7505.copySRAMtoEPRROM();
+    bus.printStats(PORT_NAME " provisioning by setters", 1);
+    bus.sleep(10000000ULL);
+    const DS7505::profile_t profile = { (uint8_t)DS7505::BITS_12 | (uint8_t)DS7505::OUT_OF_LIMITS_TRIG_4 |
+                                        (uint8_t)DS7505::ACTIVE_LOW,
+                                        (int16_t)(55 * 256), (int16_t)(60 * 256) };
+    bus.resetStats();
+    int8_t applied = ds7505.applyProfile(profile, true);
+    bus.printStats(PORT_NAME " applyProfile", 1);
+    printf("%s applyProfile: status %d, T_OS %f C, T_HYST %f C\n", PORT_NAME, applied,
+           ds7505.ds7505.temp_os, ds7505.ds7505.temp_hyst);
+    bus.sleep(10000000ULL);
+
+    // a slave holding SDA low blocks a plain getTemp() for the bus-busy timeout
+    bus.holdSda(4);
+    bus.resetStats();
+    start = bus.now();
+    int8_t held = ds7505.getTemp();
+    printf("%s getTemp SDA held: status %d after %.1f us\n", PORT_NAME, held,
+           (bus.now() - start) / 1000.0);
+#ifdef SIM_LINUX
+    i2c.setTimeout(10);
+    DS7505 &owner = ds7505;
+#else
+    // only a driver that owns its I2C recovers the bus
+    DS7505 owner(PB_9, PB_8);
+    owner.recoverBus();
+#endif
+
+    // a flaky sensor, a held SDA with a 60 ms and a 2 ms budget, a missing sensor
+    DS7505 absent(i2c, 0x4F);
+    const char *const faults[4] = { "one NACK", "SDA held 60 ms", "SDA held 2 ms", "missing sensor" };
+    const uint32_t budgets[4] = { 2000, 60000, 2000, 2000 };
+    for(int f = 0; f < 4; f++) {
+        DS7505 &target = f == 3 ? absent : owner;
+        if(f == 0) {
+            bus.failNext(1);
+        } else if(f < 3) {
+            bus.holdSda(4);
+        }
+        bus.resetStats();
+        uint64_t t0 = bus.now();
+        int8_t status = target.getTempWithin(budgets[f]);
+        printf("%s getTempWithin %s: status %d after %.1f us, %u calls, SDA %s\n", PORT_NAME,
+               faults[f], status, (bus.now() - t0) / 1000.0, bus.stats().calls,
+               bus.sdaHeld() ? "held" : "free");
+#ifndef SIM_LINUX
+        if(bus.sdaHeld()) {
+            // the budget ran out before the recovery
+            owner.recoverBus();
+        }
+#endif
+    }
+
+#ifdef DS7505_INSTRUMENT
+    // everything the main sensor did so far, and a sensor that is not on the bus
+    DS7505 missing(i2c, 0x4F);
+    missing.getTemp();
+    printf("%s softwarePOR on a missing sensor: status %d\n", PORT_NAME, missing.softwarePOR());
+    printInstrumentation(PORT_NAME " instr 0x48", ds7505);
+    printInstrumentation(PORT_NAME " instr 0x4F", missing);
+#endif
+
+    // seven sensors answer, 0x4F is added by hand and NACKs
+    for(int i = 0; i < 6; i++) {
+        bus.attach(others[i]);
+    }
+    sensors.scan();
+    sensors.add(0x4F);
+    bus.resetStats();
+    uint32_t answered = 0;
+    for(int i = 0; i < SAMPLES; i++) {
+        answered += sensors.poll(samples);
+    }
+    bus.printStats(PORT_NAME " bus poll", answered);
+    printf("%s bus poll: %u sensors, %.2f answered/cycle\n", PORT_NAME,
+           sensors.count(), (double)answered / SAMPLES);
+
+    // a rescan reads CONFIG of the sensors already added, the next poll points them back at TEMPER
+    int16_t before = samples[1].temperature_raw;
+    sensors.scan();
+    sensors.poll(samples);
+    printf("%s bus rescan: 0x%2x %d centi C before, %d after, %u sensors\n", PORT_NAME,
+           samples[1].addr, DS7505Protocol::rawToCenti(before),
+           DS7505Protocol::rawToCenti(samples[1].temperature_raw), sensors.count());
+
+    // 12-bit and 9-bit sensor for 10 s, every read must see a new conversion
+    DS7505 fast(i2c, 0x49);
+    DS7505Scheduler scheduler;
+    ds7505.setConfigReg(DS7505::BITS_12);
+    fast.setConfigReg(DS7505::BITS_9);
+    scheduler.add(ds7505);
+    scheduler.add(fast);
+    scheduler.restart(bus.now() / 1000000);
+    bus.resetStats();
+    uint32_t conv12 = sensor.conversions();
+    uint32_t conv9 = others[0].conversions();
+    uint32_t reads = 0;
+    uint64_t end = bus.now() + 10000000000ULL;
+    while(bus.now() < end) {
+        uint8_t fresh = scheduler.run(bus.now() / 1000000);
+        reads += (fresh & 1) + ((fresh >> 1) & 1);
+        uint32_t wait = scheduler.nextDueMs(bus.now() / 1000000);
+        bus.sleep(wait * 1000000ULL);
+    }
+    bus.printStats(PORT_NAME " scheduler", reads);
+    printf("%s scheduler: %u reads, %u conversions, rates %u/%u mHz, bus %u mHz\n", PORT_NAME,
+           reads, sensor.conversions() - conv12 + others[0].conversions() - conv9,
+           scheduler.sampleRateMilliHz(0), scheduler.sampleRateMilliHz(1),
+           scheduler.busSampleRateMilliHz());
+
+#ifdef SIM_LINUX
+    // the bus poll goes into shared memory, two readers drain it every 50 cycles, a third
+    // only looks at the end and has lost what did not fit the ring; the bus cost per
+    // cycle is the one of the plain bus poll above
+    {
+        DS7505ShmWriter writer("/ds7505-bench");
+        for(uint8_t i = 0; i < sensors.count(); i++) {
+            writer.add(1, sensors.sensor(i)->ds7505.addr);
+        }
+        DS7505ShmReader reader0("/ds7505-bench"), reader1("/ds7505-bench"), reader2("/ds7505-bench");
+        DS7505ShmReader *readers[3] = { &reader0, &reader1, &reader2 };
+        uint32_t cursor[3][DS7505_BUS_MAX_SENSORS] = {};
+        uint32_t got[3] = {}, lost[3] = {};
+        ds7505_shm_record_t records[DS7505_SHM_SLOTS];
+        bus.resetStats();
+        answered = 0;
+        for(int c = 1; c <= 200; c++) {
+            answered += sensors.poll(samples);
+            for(uint8_t i = 0; i < sensors.count(); i++) {
+                writer.publish(i, samples[i].status, *sensors.sensor(i), bus.now());
+            }
+            for(int r = 0; r < 3; r++) {
+                if((r < 2 && c % 50 == 0) || (r == 2 && c == 200)) {
+                    for(uint8_t i = 0; i < readers[r]->sensors(); i++) {
+                        uint32_t missed;
+                        got[r] += readers[r]->read(i, cursor[r][i], records, DS7505_SHM_SLOTS, &missed);
+                        lost[r] += missed;
+                    }
+                }
+            }
+        }
+        bus.printStats(PORT_NAME " shm", answered);
+        ds7505_shm_record_t record;
+        auto t0 = std::chrono::steady_clock::now();
+        for(int i = 0; i < 1000000; i++) {
+            reader0.latest(i & 7, record);
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        printf("%s shm: %u sensors, readers got %u/%u/%u, lost %u/%u/%u, latest() %.1f ns, valid %d\n",
+               PORT_NAME, reader0.sensors(), got[0], got[1], got[2], lost[0], lost[1], lost[2],
+               ns / 1000000, reader0.valid());
+    }
+    DS7505ShmReader gone("/ds7505-bench");
+    printf("%s shm: writer gone, reopen %s\n", PORT_NAME, gone.isOpen() ? "mapped" : "failed");
+
+    // the engine on the simulated adapter for one second of wall time, the sensors keep their
+    // resolution (0x48 at 12 bits, the others at 9): every sensor is read once per conversion,
+    // paced by the timerfd
+    {
+        DS7505Engine engine;
+        engine.addAdapter("/dev/i2c-sim");
+        ds7505_engine_sample_t batch[64];
+        uint32_t received = 0;
+        uint32_t failed = 0;
+        bus.resetStats();
+        auto t0 = std::chrono::steady_clock::now();
+        engine.start();
+        while(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(1)) {
+            uint16_t n = engine.wait(batch, 64, 100);
+            for(uint16_t i = 0; i < n; i++) {
+                failed += batch[i].status != DS7505_SUCCESS;
+            }
+            received += n;
+        }
+        engine.stop();
+        uint32_t expected = 0;
+        for(uint8_t i = 0; i < engine.bus(0)->count(); i++) {
+            expected += 1000 / DS7505::conversionTimeMs(engine.bus(0)->sensor(i)->ds7505.config);
+        }
+        bus.printStats(PORT_NAME " engine", received);
+        printf("%s engine: %u sensors, %u samples in 1 s (%u expected), %u failed, %u dropped\n",
+               PORT_NAME, engine.bus(0)->count(), received, expected, failed, engine.dropped());
+    }
+#endif
+
+#ifndef SIM_LINUX
+    // alert mode, the temperature rises 0.1 C/s through TOS for 60 s,
+    // the bus is only used when O.S. fires
+    DS7505Alert alert(ds7505, PA_8, queue);
+    ds7505.getTemp();
+    ds7505.setTempOSCenti(DS7505Protocol::rawToCenti(ds7505.ds7505.temperature_raw) + 200);
+    ds7505.setTempHystCenti(DS7505Protocol::rawToCenti(ds7505.ds7505.temperature_raw) + 100);
+    alert.attach(callback(onAlert));
+    bus.resetStats();
+    bool level = true;
+    end = bus.now() + 60000000000ULL;
+    while(bus.now() < end) {
+        sensor.update(bus.now());
+        bool now = sensor.os();
+        if(level && !now) {
+            InterruptIn::fire(PA_8, false);
+        }
+        level = now;
+        queue.dispatch_once();
+        bus.sleep(5000000ULL);
+    }
+    alert.detach();
+    bus.printStats(PORT_NAME " alert", alerts);
+    printf("%s alert: %u alerts in 60 s, last %f C\n", PORT_NAME, alerts,
+           DS7505Protocol::rawToCenti(ds7505.ds7505.temperature_raw) / 100.0);
+#endif
+
+    // one sample a minute for 100 minutes, the sensor only converts once per sample;
+    // blocking and from the poll loop / EventQueue
+    const int shots = 100;
+    ds7505.shutDown();
+    bus.resetStats();
+    uint32_t shotConversions = sensor.conversions();
+    uint32_t fresh = 0;
+    for(int i = 0; i < shots; i++) {
+        sensor.setAmbient(20.0f + i, 0.0f);
+        if(ds7505.getTempOneShot() == DS7505_SUCCESS && ds7505.ds7505.temperature == 20.0f + i) {
+            fresh++;
+        }
+        bus.sleep(60000000000ULL);
+    }
+    bus.printStats(PORT_NAME " getTempOneShot", shots);
+    printf("%s getTempOneShot: %u fresh, %u conversions (continuous: %u)\n", PORT_NAME, fresh,
+           sensor.conversions() - shotConversions, shots * 60000 / DS7505::conversionTimeMs(ds7505.ds7505.config));
+#ifdef SIM_LINUX
+    DS7505OneShot oneShot(ds7505);
+    uint32_t oneShots = 0;
+#else
+    DS7505OneShot oneShot(ds7505, queue);
+#endif
+    bus.resetStats();
+    shotConversions = sensor.conversions();
+    for(int i = 0; i < shots; i++) {
+#ifdef SIM_LINUX
+        oneShot.start(bus.now() / 1000000);
+        while(oneShot.busy()) {
+            bus.sleep(oneShot.nextDueMs(bus.now() / 1000000) * 1000000ULL);
+            if(oneShot.run(bus.now() / 1000000) == DS7505_SUCCESS) {
+                oneShots++;
+            }
+        }
+        bus.sleep(60000000000ULL);
+#else
+        oneShot.start(callback(onOneShot));
+        queue.dispatch_for(std::chrono::seconds(60));
+#endif
+    }
+    bus.printStats(PORT_NAME " DS7505OneShot", shots);
+    printf("%s DS7505OneShot: %u done, %u conversions\n", PORT_NAME, oneShots,
+           sensor.conversions() - shotConversions);
+
+    // adaptive resolution: 60 s at a steady 25 C, fixed 12 bits against 9 bits raised
+    // on demand; then 10 s at +1 C/s, 20 s steady and a 0.1 C/s ramp into T_HYST
+    ds7505.wakeUp();
+    ds7505.setTempOSCenti(4500);
+    ds7505.setTempHystCenti(4000);
+    sensor.setAmbient(25.0f, 0.0f);
+    uint64_t fineMs = 0;
+    ds7505.setResolution(DS7505::BITS_12);
+    DS7505Scheduler fixed;
+    fixed.add(ds7505);
+    fixed.restart(bus.now() / 1000000);
+    bus.resetStats();
+    uint32_t fixedSamples = runScheduled(fixed, NULL, 60000, fineMs);
+    bus.printStats(PORT_NAME " fixed 12 bits", fixedSamples);
+
+    ds7505.setResolution(DS7505::BITS_9);
+    DS7505Scheduler adaptiveScheduler;
+    adaptiveScheduler.add(ds7505);
+    adaptiveScheduler.restart(bus.now() / 1000000);
+    DS7505Adaptive adaptive(ds7505, adaptiveScheduler, 0);
+    bus.resetStats();
+    uint32_t adaptiveSamples = runScheduled(adaptiveScheduler, &adaptive, 60000, fineMs);
+    bus.printStats(PORT_NAME " adaptive steady", adaptiveSamples);
+    printf("%s adaptive steady: %u samples (fixed 12 bits: %u), %u switches, %u ms at 12 bits\n",
+           PORT_NAME, adaptiveSamples, fixedSamples, adaptive.switches(), (uint32_t)fineMs);
+
+    fineMs = 0;
+    uint32_t switches = adaptive.switches();
+    bus.resetStats();
+    sensor.setAmbient(25.0f - bus.now() / 1e9f, 1.0f);
+    adaptiveSamples = runScheduled(adaptiveScheduler, &adaptive, 10000, fineMs);
+    sensor.setAmbient(35.0f, 0.0f);
+    adaptiveSamples += runScheduled(adaptiveScheduler, &adaptive, 20000, fineMs);
+    sensor.setAmbient(35.0f - 0.1f * (bus.now() / 1e9f), 0.1f);
+    adaptiveSamples += runScheduled(adaptiveScheduler, &adaptive, 60000, fineMs);
+    bus.printStats(PORT_NAME " adaptive ramp", adaptiveSamples);
+    printf("%s adaptive ramp: %u samples, %u switches, %u ms at 12 bits, last %f C (%s)\n",
+           PORT_NAME, adaptiveSamples, adaptive.switches() - switches, (uint32_t)fineMs,
+           ds7505.ds7505.temperature, adaptive.fine() ? "12 bits" : "9 bits");
+
+    // coroutines: the acquisition sequence as one task next to 1000 timer tasks on one
+    // thread, runUntilDone() on the simulated clock
+    DS7505CoLoop loop;
+    DS7505CoSensor coSensor(ds7505, loop);
+    uint32_t coReads = 0;
+    uint32_t coShots = 0;
+    uint32_t ticks = 0;
+    int8_t coCommit = DS7505_ERROR;
+    loop.spawn(coAcquire(ds7505, coSensor, 300, coReads, coShots, coCommit));
+    for(int i = 0; i < 1000; i++) {
+        loop.spawn(coTicker(loop, 10 + i % 90, 100, ticks));
+    }
+    uint32_t coTasks = loop.tasks();
+    bus.resetStats();
+    uint64_t coStart = bus.now();
+    auto coWall = std::chrono::steady_clock::now();
+    loop.runUntilDone();
+    double coNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - coWall).count();
+    bus.printStats(PORT_NAME " coroutines", coReads + coShots);
+    printf("%s coroutines: %u tasks, %u reads in %.1f s (scheduler at 12 bits: 5/s), %u one-shot, "
+           "commit %d, %u timer resumes, %.0f ns/resume, %u tasks left\n", PORT_NAME, coTasks,
+           coReads, (bus.now() - coStart) / 1e9, coShots, coCommit, ticks,
+           coNs / (ticks + coReads + coShots), loop.tasks());
+    return 0;
+}
@@ -0,0 +1,534 @@
+/*
+ * Host benchmark of the Zephyr port on the simulated bus, see README.md.
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include <drivers/sensor.h>
+#ifdef CONFIG_SENSOR_ASYNC_API
+#include <drivers/sensor_data_types.h>
+#endif
+
+#include "ds7505.h"
+#include "ds7505_bus.h"
+#include "ds7505_sched.h"
+#include "ds7505_alert.h"
+#include "ds7505_sensor.h"
+#include "ds7505_eeprom.h"
+#include "ds7505_oneshot.h"
+#include "ds7505_adaptive.h"
+#include "ds7505_stats.h"
+#include "ds7505_codec.h"
+#include <sim.h>
+
+#define SAMPLES 1000
+
+/* raw frames of all sensors and cycles, decoded after the bus work */
+static uint8_t frames[SAMPLES][DS7505_BUS_MAX_SENSORS * DS7505_FRAME_SIZE];
+static int16_t frames_raw[SAMPLES * DS7505_BUS_MAX_SENSORS];
+static uint8_t page[4096];
+static int16_t logged[SAMPLES];
+
+static int8_t committed = DS7505_ERROR;
+static uint64_t committed_at;
+static uint32_t async_done;
+static uint32_t alerts;
+static uint32_t oneshots;
+static uint32_t triggers;
+
+extern const struct device sim_ds7505_0;
+
+static void on_trigger(const struct device *dev, const struct sensor_trigger *trigger)
+{
+	triggers++;
+}
+
+static void on_commit(struct ds7505_t *ds7505, int8_t status, void *user_data)
+{
+	committed = status;
+	committed_at = sim_uptime_ns();
+}
+
+static void on_oneshot(struct ds7505_t *ds7505, int8_t status, void *user_data)
+{
+	if (status == DS7505_SUCCESS) {
+		oneshots++;
+	}
+}
+
+static void on_alert(struct ds7505_t *ds7505, int8_t status, void *user_data)
+{
+	if (status == DS7505_SUCCESS) {
+		alerts++;
+	}
+}
+
+static void on_temp(struct ds7505_t *ds7505, int8_t status, float temperature, void *user_data)
+{
+	if (status == DS7505_SUCCESS) {
+		async_done++;
+	}
+}
+
+static void sensor_bench(const struct device *dev)
+{
+	struct sensor_trigger trig = { SENSOR_TRIG_THRESHOLD, SENSOR_CHAN_AMBIENT_TEMP };
+	struct sensor_value val;
+	bool level = true;
+	uint64_t start;
+	int i;
+
+	if (sim_device_init(dev) != 0) {
+		printk("zephyr sensor: init failed\n");
+		return;
+	}
+
+#ifdef CONFIG_SENSOR_ASYNC_API
+	{
+		SIM_SENSOR_READ_IODEV(iodev, &sim_ds7505_0, SENSOR_CHAN_AMBIENT_TEMP);
+		RTIO_DEFINE(ctx, 1, 1);
+		static uint8_t bufs[SAMPLES][16];
+		const struct sensor_decoder_api *decoder;
+		struct sensor_chan_spec chan = { SENSOR_CHAN_AMBIENT_TEMP, 0 };
+		struct sensor_q31_data q31;
+		int ok = 0;
+
+		sim_reset_stats();
+		for (i = 0; i < SAMPLES; i++) {
+			ok += sensor_read(&iodev, &ctx, bufs[i], sizeof(bufs[i])) == 0;
+		}
+		sim_print_stats("zephyr sensor_read", ok);
+		sensor_get_decoder(dev, &decoder);
+		for (i = 0; i < SAMPLES; i++) {
+			uint32_t fit = 0;
+
+			decoder->decode(bufs[i], chan, &fit, 1, &q31);
+		}
+		printk("zephyr sensor_read: %u submitted, last %f C\n", ctx.submitted,
+		       q31.readings[0].temperature * (double)(1 << q31.shift) / 2147483648.0);
+	}
+#endif
+
+	sim_reset_stats();
+	for (i = 0; i < SAMPLES; i++) {
+		sensor_sample_fetch(dev);
+		sensor_channel_get(dev, SENSOR_CHAN_AMBIENT_TEMP, &val);
+	}
+	sim_print_stats("zephyr sensor_sample_fetch", SAMPLES);
+	printk("zephyr sensor_sample_fetch: %d.%06d C\n", val.val1, val.val2);
+
+	val.val1 += 2;
+	sensor_attr_set(dev, SENSOR_CHAN_AMBIENT_TEMP, SENSOR_ATTR_UPPER_THRESH, &val);
+	val.val1 -= 1;
+	sensor_attr_set(dev, SENSOR_CHAN_AMBIENT_TEMP, SENSOR_ATTR_HYSTERESIS, &val);
+	sensor_trigger_set(dev, &trig, on_trigger);
+	start = sim_uptime_ns();
+	while (sim_uptime_ns() - start < 60000000000ULL) {
+		bool now = sim_sensor_os(ADDR_48);
+
+		if (level && !now) {
+			sim_gpio_fire(sim_gpio_device(), 3);
+		}
+		level = now;
+		k_msleep(5);
+	}
+	sensor_trigger_set(dev, &trig, NULL);
+	sensor_channel_get(dev, SENSOR_CHAN_AMBIENT_TEMP, &val);
+	printk("zephyr sensor trigger: %u triggers in 60 s, last %f C\n", triggers,
+	       sensor_value_to_double(&val));
+}
+
+#ifdef DS7505_INSTRUMENT
+static void print_instr(const char *label, const struct ds7505_t *ds7505)
+{
+	static const char *const names[DS7505_INSTR_OPS] = { "pointer", "read", "config",
+							     "command" };
+	struct ds7505_instr_t instr;
+	const struct ds7505_op_stats_t *stats;
+	int op;
+	int b;
+
+	ds7505_instr_snapshot(ds7505, &instr);
+	for (op = 0; op < DS7505_INSTR_OPS; op++) {
+		stats = &instr.op[op];
+		if (stats->count == 0) {
+			continue;
+		}
+		printk("%s %-7s: %6u calls, %u errors (%u nacks, %u timeouts), %u retries, "
+		       "%.1f us mean, %u us max, histogram",
+		       label, names[op], stats->count, stats->errors, stats->nacks, stats->timeouts,
+		       stats->retries, (double)stats->total_us / stats->count, stats->max_us);
+		for (b = 0; b < DS7505_INSTR_BUCKETS; b++) {
+			printk(" %u", stats->latency[b]);
+		}
+		printk("\n");
+	}
+};
+#endif
+
+/* runs the scheduler for ms, returns the new samples of sensor 0; fine_ms gets the time
+ * the adaptive sensor spent at the fine resolution
+ */
+static uint32_t run_scheduled(struct ds7505_sched_t *sched, struct ds7505_adaptive_t *adaptive,
+			      uint32_t ms, uint32_t *fine_ms)
+{
+	uint64_t end = sim_uptime_ns() + ms * 1000000ULL;
+	uint32_t fresh = 0;
+
+	while (sim_uptime_ns() < end) {
+		uint32_t wait;
+
+		if (ds7505_sched_run(sched, k_uptime_get()) & BIT(0)) {
+			fresh++;
+			if (adaptive != NULL) {
+				ds7505_adaptive_update(adaptive, k_uptime_get());
+			}
+		}
+		wait = ds7505_sched_next_due_ms(sched, k_uptime_get());
+		if (wait > (end - sim_uptime_ns()) / 1000000) {
+			wait = (end - sim_uptime_ns()) / 1000000;
+		}
+		if (adaptive != NULL && ds7505_adaptive_fine(adaptive)) {
+			*fine_ms += wait;
+		}
+		k_msleep(wait ? wait : 1);
+	}
+	return fresh;
+}
+
+static void bench(void)
+{
+	static struct ds7505_alert_t alert;
+	static struct ds7505_eeprom_t eeprom;
+	static struct ds7505_oneshot_t oneshot;
+	static struct ds7505_adaptive_t adaptive;
+	static struct ds7505_stats_t stats;
+	static struct ds7505_encoder_t encoder;
+	struct ds7505_decoder_t decoder;
+	uint32_t mismatches = 0;
+	uint16_t used;
+	int k;
+	struct gpio_dt_spec os = { sim_gpio_device(), 2, GPIO_ACTIVE_LOW };
+	bool level = true;
+	struct ds7505_sched_t sched;
+	uint32_t reads = 0;
+	uint32_t windows = 0;
+	struct ds7505_bus_t bus;
+	struct ds7505_sample_t samples[DS7505_BUS_MAX_SENSORS];
+	uint32_t answered = 0;
+	struct ds7505_t ds7505;
+	struct ds7505_async_t req = { 0 };
+	struct ds7505_reading_t reading;
+	struct ds7505_profile_t profile;
+	uint64_t start;
+	uint32_t fixed_samples;
+	uint32_t adaptive_samples;
+	uint32_t fine_ms = 0;
+	uint32_t switches;
+	int i;
+
+	sim_add_sensor(ADDR_48, 21.5f, 0.1f);
+	ds7505_init(&ds7505, sim_i2c_device(), ADDR_48);
+
+	ds7505_set_config_reg(&ds7505, BITS_12, OUT_OF_LIMITS_TRIG_1, ACTIVE_LOW, COMPARATOR);
+
+	sim_reset_stats();
+	start = sim_uptime_ns();
+	for (i = 0; i < SAMPLES; i++) {
+		ds7505_get_temp(&ds7505);
+	}
+	sim_print_stats("zephyr ds7505_get_temp", SAMPLES);
+	printk("zephyr ds7505_get_temp: %.1f us latency/sample\n",
+	       (sim_uptime_ns() - start) / 1000.0 / SAMPLES);
+	ds7505_latest(&ds7505, &reading);
+	printk("zephyr ds7505_latest: %u published, last %d centi C\n", reading.count,
+	       DS7505_RAW_TO_CENTI(reading.temperature_raw));
+
+	/* one read per conversion, aggregated in windows of 100 samples */
+	ds7505_stats_init(&stats, 100);
+	ds7505_encoder_init(&encoder, page, sizeof(page), 64);
+	sim_reset_stats();
+	for (i = 0; i < SAMPLES; i++) {
+		k_msleep(ds7505_conversion_time_ms(ds7505.config));
+		if (ds7505_get_temp(&ds7505) == DS7505_SUCCESS &&
+		    ds7505_stats_update_sensor(&stats, &ds7505)) {
+			windows++;
+		}
+		logged[i] = ds7505.temperature_raw;
+		ds7505_encoder_push_sensor(&encoder, &ds7505);
+	}
+	sim_print_stats("zephyr paced ds7505_get_temp", SAMPLES);
+	printk("zephyr ds7505_stats: %u windows, window %u: min %d max %d mean %d ema %d "
+	       "p50 %d p90 %d p99 %d centi C\n",
+	       windows, stats.snapshot.window, DS7505_RAW_TO_CENTI(stats.snapshot.min_raw),
+	       DS7505_RAW_TO_CENTI(stats.snapshot.max_raw),
+	       DS7505_RAW_TO_CENTI(stats.snapshot.mean_raw),
+	       DS7505_RAW_TO_CENTI(stats.snapshot.ema_raw),
+	       DS7505_RAW_TO_CENTI(stats.snapshot.p50_raw),
+	       DS7505_RAW_TO_CENTI(stats.snapshot.p90_raw),
+	       DS7505_RAW_TO_CENTI(stats.snapshot.p99_raw));
+
+	/* the same stream encoded and decoded back */
+	used = ds7505_encoder_flush(&encoder);
+	ds7505_decoder_init(&decoder, page, sizeof(page));
+	i = ds7505_decoder_decode(&decoder, frames_raw, SAMPLES);
+	for (k = 0; k < SAMPLES; k++) {
+		if (k >= i || frames_raw[k] != logged[k]) {
+			mismatches++;
+		}
+	}
+	printk("zephyr ds7505_codec: %d samples in %u bytes, %.2f bits/sample, %.1fx smaller than "
+	       "float, %u mismatches\n",
+	       i, used, used * 8.0 / SAMPLES, SAMPLES * 4.0 / used, mismatches);
+
+	sim_reset_stats();
+	for (i = 0; i < SAMPLES; i++) {
+		ds7505_get_temp_async(&ds7505, &req, on_temp, NULL);
+	}
+	sim_print_stats("zephyr ds7505_get_temp_async", SAMPLES);
+	printk("zephyr ds7505_get_temp_async: %u callbacks\n", async_done);
+
+	sim_reset_stats();
+	for (i = 0; i < SAMPLES; i++) {
+		ds7505_shutdown(&ds7505);
+		ds7505_wake_up(&ds7505);
+	}
+	sim_print_stats("zephyr shutdown+wake_up", SAMPLES);
+	printk("zephyr last temp %f C\n", ds7505.temperature);
+
+	/* EEPROM commit, spinning on NVB and with checks on a backoff */
+	sim_reset_stats();
+	start = sim_uptime_ns();
+	ds7505_copy_SRAM_to_EPRROM(&ds7505);
+	i = 0;
+	while (ds7505_memory_busy(&ds7505)) {
+		i++;
+	}
+	printk("zephyr ds7505_copy_SRAM_to_EPRROM: busy for %.2f ms, %d polls\n",
+	       (sim_uptime_ns() - start) / 1e6, i);
+
+	ds7505_eeprom_init(&eeprom, &ds7505);
+	sim_reset_stats();
+	start = sim_uptime_ns();
+	ds7505_eeprom_commit(&eeprom, on_commit, NULL);
+	k_msleep(200);
+	printk("zephyr ds7505_eeprom_commit: status %d after %.2f ms, %u bus calls\n", committed,
+	       (committed_at - start) / 1e6, sim_stats_calls());
+
+	/* provisioning: setters with read-back, then one batched profile */
+	sim_reset_stats();
+	ds7505_set_config_reg(&ds7505, BITS_12, OUT_OF_LIMITS_TRIG_4, ACTIVE_LOW, COMPARATOR);
+	ds7505_set_temp_OS(&ds7505, 60.0f);
+	ds7505_set_temp_HYST(&ds7505, 55.0f);
+	ds7505_get_config_reg(&ds7505);
+	ds7505_get_temp_OS(&ds7505);
+	ds7505_get_temp_HYST(&ds7505);
+	ds7505_copy_SRAM_to_EPRROM(&ds7505);
+	sim_print_stats("zephyr provisioning by setters", 1);
+	k_msleep(10);
+	profile.config = BITS_12 | OUT_OF_LIMITS_TRIG_4 | ACTIVE_LOW;
+	profile.temp_hyst_raw = 55 * 256;
+	profile.temp_os_raw = 60 * 256;
+	sim_reset_stats();
+	i = ds7505_apply_profile(&ds7505, &profile, true);
+	sim_print_stats("zephyr ds7505_apply_profile", 1);
+	printk("zephyr ds7505_apply_profile: status %d, T_OS %f C, T_HYST %f C\n", i,
+	       ds7505.temp_os, ds7505.temp_hyst);
+	k_msleep(10);
+
+	/* a slave holding SDA low blocks a plain read for the bus-busy timeout */
+	sim_hold_sda(4);
+	start = sim_uptime_ns();
+	i = ds7505_get_temp(&ds7505);
+	printk("zephyr ds7505_get_temp SDA held: status %d after %.1f us\n", i,
+	       (sim_uptime_ns() - start) / 1000.0);
+	i2c_recover_bus(sim_i2c_device());
+
+	/* a flaky sensor, a held SDA with a 60 ms and a 2 ms budget, a missing sensor */
+	{
+		static const char *const faults[4] = { "one NACK", "SDA held 60 ms", "SDA held 2 ms",
+						       "missing sensor" };
+		static const uint32_t budgets[4] = { 2000, 60000, 2000, 2000 };
+		struct ds7505_t absent;
+
+		ds7505_init(&absent, sim_i2c_device(), ADDR_4F);
+		for (k = 0; k < 4; k++) {
+			if (k == 0) {
+				sim_fail_next(1);
+			} else if (k < 3) {
+				sim_hold_sda(4);
+			}
+			sim_reset_stats();
+			start = sim_uptime_ns();
+			i = ds7505_get_temp_within(k == 3 ? &absent : &ds7505, budgets[k], DS7505_RETRIES);
+			printk("zephyr ds7505_get_temp_within %s: status %d after %.1f us, %u calls, SDA %s\n",
+			       faults[k], i, (sim_uptime_ns() - start) / 1000.0, sim_stats_calls(),
+			       sim_sda_held() ? "held" : "free");
+			if (sim_sda_held()) {
+				/* the budget ran out before the recovery */
+				i2c_recover_bus(sim_i2c_device());
+			}
+		}
+	}
+
+#ifdef DS7505_INSTRUMENT
+	/* everything the main sensor did so far, and a sensor that is not on the bus */
+	{
+		struct ds7505_t missing;
+
+		ds7505_init(&missing, sim_i2c_device(), ADDR_4F);
+		ds7505_get_temp(&missing);
+		printk("zephyr ds7505_software_POR on a missing sensor: status %d\n",
+		       ds7505_software_POR(&missing));
+		print_instr("zephyr instr 0x48", &ds7505);
+		print_instr("zephyr instr 0x4F", &missing);
+	}
+#endif
+
+	/* seven sensors answer, ADDR_4F is added by hand and NACKs */
+	for (i = ADDR_49; i <= ADDR_4E; i++) {
+		sim_add_sensor(i, 21.5f, 0.0f);
+	}
+	ds7505_bus_init(&bus, sim_i2c_device());
+	ds7505_bus_scan(&bus);
+	ds7505_bus_add(&bus, ADDR_4F);
+	sim_reset_stats();
+	for (i = 0; i < SAMPLES; i++) {
+		answered += ds7505_bus_poll(&bus, samples);
+	}
+	sim_print_stats("zephyr bus poll", answered);
+	printk("zephyr bus poll: %u sensors, %.2f answered/cycle\n", bus.count,
+	       (double)answered / SAMPLES);
+
+	/* a rescan reads CONFIG of the sensors already added, the next poll points them back at TEMPER */
+	{
+		int16_t before = samples[1].temperature_raw;
+
+		ds7505_bus_scan(&bus);
+		ds7505_bus_poll(&bus, samples);
+		printk("zephyr bus rescan: 0x%2x %d centi C before, %d after, %u sensors\n",
+		       samples[1].addr, DS7505_RAW_TO_CENTI(before),
+		       DS7505_RAW_TO_CENTI(samples[1].temperature_raw), bus.count);
+	}
+
+	/* same cycles with the bus work and the conversion split */
+	answered = 0;
+	sim_reset_stats();
+	for (i = 0; i < SAMPLES; i++) {
+		int8_t status[DS7505_BUS_MAX_SENSORS];
+
+		answered += ds7505_bus_read_frames(&bus, frames[i], status);
+	}
+	ds7505_decode_frames(&frames[0][0], SAMPLES * DS7505_BUS_MAX_SENSORS, frames_raw);
+	sim_print_stats("zephyr bus frames", answered);
+	printk("zephyr bus frames: %u decoded, first %d, last %d centi C\n",
+	       SAMPLES * DS7505_BUS_MAX_SENSORS, DS7505_RAW_TO_CENTI(frames_raw[0]),
+	       DS7505_RAW_TO_CENTI(frames_raw[SAMPLES * DS7505_BUS_MAX_SENSORS - 2]));
+
+	/* 12-bit sensor and 9-bit sensor for 10 s */
+	ds7505_set_config_reg(ds7505_bus_sensor(&bus, 0), BITS_9, OUT_OF_LIMITS_TRIG_1, ACTIVE_LOW, COMPARATOR);
+	ds7505_sched_init(&sched, 100000);
+	ds7505_sched_add(&sched, &ds7505);
+	ds7505_sched_add(&sched, ds7505_bus_sensor(&bus, 0));
+	ds7505_sched_restart(&sched, k_uptime_get());
+	sim_reset_stats();
+	start = sim_uptime_ns();
+	while (sim_uptime_ns() - start < 10000000000ULL) {
+		uint8_t fresh = ds7505_sched_run(&sched, k_uptime_get());
+
+		reads += (fresh & 1) + ((fresh >> 1) & 1);
+		k_msleep(ds7505_sched_next_due_ms(&sched, k_uptime_get()));
+	}
+	sim_print_stats("zephyr scheduler", reads);
+	printk("zephyr scheduler: rates %u/%u mHz, bus %u mHz\n",
+	       ds7505_sched_sample_rate_milli_hz(&sched, 0), ds7505_sched_sample_rate_milli_hz(&sched, 1),
+	       ds7505_sched_bus_sample_rate_milli_hz(&sched));
+
+	/* alert mode, the temperature rises 0.1 C/s through TOS for 60 s,
+	 * the bus is only used when O.S. fires
+	 */
+	ds7505_get_temp(&ds7505);
+	ds7505_set_temp_OS_centi(&ds7505, DS7505_RAW_TO_CENTI(ds7505.temperature_raw) + 200);
+	ds7505_set_temp_HYST_centi(&ds7505, DS7505_RAW_TO_CENTI(ds7505.temperature_raw) + 100);
+	ds7505_alert_attach(&alert, &ds7505, &os, ACTIVE_LOW, on_alert, NULL);
+	sim_reset_stats();
+	start = sim_uptime_ns();
+	while (sim_uptime_ns() - start < 60000000000ULL) {
+		bool now = sim_sensor_os(ADDR_48);
+
+		if (level && !now) {
+			sim_gpio_fire(os.port, os.pin);
+		}
+		level = now;
+		k_msleep(5);
+	}
+	ds7505_alert_detach(&alert);
+	sim_print_stats("zephyr alert", alerts);
+	printk("zephyr alert: %u alerts in 60 s, last %f C\n", alerts, ds7505.temperature);
+
+	/* the same sensor through the sensor API, devicetree instance 0 */
+	sensor_bench(&sim_ds7505_0);
+
+	/* one sample a minute, blocking and from the work queue */
+	ds7505_shutdown(&ds7505);
+	sim_reset_stats();
+	for (i = 0; i < 100; i++) {
+		ds7505_get_temp_one_shot(&ds7505);
+		k_msleep(60000);
+	}
+	sim_print_stats("zephyr ds7505_get_temp_one_shot", 100);
+	ds7505_oneshot_init(&oneshot, &ds7505);
+	sim_reset_stats();
+	for (i = 0; i < 100; i++) {
+		ds7505_oneshot_start(&oneshot, on_oneshot, NULL);
+		k_msleep(60000);
+	}
+	sim_print_stats("zephyr ds7505_oneshot", 100);
+	printk("zephyr ds7505_oneshot: %u done\n", oneshots);
+
+	/* adaptive resolution: 60 s at a steady 25 C, fixed 12 bits against 9 bits raised
+	 * on demand; then 10 s at +1 C/s, 20 s steady and a 0.1 C/s ramp into T_HYST
+	 */
+	ds7505_wake_up(&ds7505);
+	ds7505_set_temp_OS_centi(&ds7505, 4500);
+	ds7505_set_temp_HYST_centi(&ds7505, 4000);
+	sim_set_ambient(ADDR_48, 25.0f, 0.0f);
+	ds7505_set_resolution(&ds7505, BITS_12);
+	ds7505_sched_init(&sched, 100000);
+	ds7505_sched_add(&sched, &ds7505);
+	ds7505_sched_restart(&sched, k_uptime_get());
+	sim_reset_stats();
+	fixed_samples = run_scheduled(&sched, NULL, 60000, &fine_ms);
+	sim_print_stats("zephyr fixed 12 bits", fixed_samples);
+
+	ds7505_set_resolution(&ds7505, BITS_9);
+	ds7505_sched_restart(&sched, k_uptime_get());
+	ds7505_adaptive_init(&adaptive, &sched, 0, BITS_9, BITS_12);
+	sim_reset_stats();
+	adaptive_samples = run_scheduled(&sched, &adaptive, 60000, &fine_ms);
+	sim_print_stats("zephyr adaptive steady", adaptive_samples);
+	printk("zephyr adaptive steady: %u samples (fixed 12 bits: %u), %u switches, %u ms at 12 bits\n",
+	       adaptive_samples, fixed_samples, adaptive.switches, fine_ms);
+
+	fine_ms = 0;
+	switches = adaptive.switches;
+	sim_reset_stats();
+	sim_set_ambient(ADDR_48, 25.0f, 1.0f);
+	adaptive_samples = run_scheduled(&sched, &adaptive, 10000, &fine_ms);
+	sim_set_ambient(ADDR_48, 35.0f, 0.0f);
+	adaptive_samples += run_scheduled(&sched, &adaptive, 20000, &fine_ms);
+	sim_set_ambient(ADDR_48, 35.0f, 0.1f);
+	adaptive_samples += run_scheduled(&sched, &adaptive, 60000, &fine_ms);
+	sim_print_stats("zephyr adaptive ramp", adaptive_samples);
+	printk("zephyr adaptive ramp: %u samples, %u switches, %u ms at 12 bits, last %f C (%s)\n",
+	       adaptive_samples, adaptive.switches - switches, fine_ms, ds7505.temperature,
+	       ds7505_adaptive_fine(&adaptive) ? "12 bits" : "9 bits");
+}
+
+int main(void)
+{
+	bench();
+	return 0;
+}
@@ -0,0 +1,114 @@
+/**
+SimBus implementation of linux/I2CDev.h. Link this file instead of
+linux/I2CDev.cpp to run the Linux port on the simulator: every method is one
+call (one ioctl on real hardware) and ends with a STOP. trace() records on
+the simulated clock, so a bench run gives a trace for I2CDevReplay.cpp.
+ */
+
+#include "I2CDev.h"
+#include "DS7505Trace.h"
+#include "SimBus.h"
+
+#include <errno.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+// a NACK fails like the address NACK of a real adapter, a held SDA like an adapter
+// timeout after which the driver recovered the bus
+static int result(int simResult)
+{
+    if(simResult == SIMBUS_SUCCESS) {
+        return 0;
+    }
+    if(simResult == SIMBUS_BUS_ERROR) {
+        SimBus::defaultBus().recover();
+        errno = ETIMEDOUT;
+        return -1;
+    }
+    errno = ENXIO;
+    return -1;
+}
+
+// the driver measures simulated bus time
+uint32_t ds7505_now_us()
+{
+    return (uint32_t)(SimBus::defaultBus().now() / 1000);
+}
+
+void ds7505_sleep_ms(uint32_t ms)
+{
+    SimBus::defaultBus().sleep(ms * 1000000ULL);
+}
+
+// adapters wait one second for a busy bus unless setTimeout() says otherwise
+I2CDev::I2CDev(const char *path): _fd(0),
+                                  _trace(NULL)
+{
+    (void)path;
+    SimBus::defaultBus().busyTimeout(1000000000ULL);
+}
+
+I2CDev::~I2CDev(){
+}
+
+bool I2CDev::isOpen() const {
+    return true;
+}
+
+int I2CDev::fd() const {
+    return _fd;
+}
+
+int I2CDev::setTimeout(uint32_t ms){
+    SimBus::defaultBus().busyTimeout(((ms + 9) / 10) * 10000000ULL);
+    return 0;
+}
+
+void I2CDev::trace(DS7505TraceWriter *writer){
+    _trace = writer;
+}
+
+int I2CDev::write(uint8_t address, const char *data, int length){
+    struct i2c_msg msg = { address, 0, (uint16_t)length, (uint8_t *)data };
+    return rdwr(&msg, 1);
+}
+
+int I2CDev::read(uint8_t address, char *data, int length){
+    struct i2c_msg msg = { address, I2C_M_RD, (uint16_t)length, (uint8_t *)data };
+    return rdwr(&msg, 1);
+}
+
+int I2CDev::writeRead(uint8_t address, const char *wdata, int wlength,
+                      char *rdata, int rlength){
+    struct i2c_msg msgs[2] = {
+        { address, 0, (uint16_t)wlength, (uint8_t *)wdata },
+        { address, I2C_M_RD, (uint16_t)rlength, (uint8_t *)rdata }
+    };
+    return rdwr(msgs, 2);
+}
+
+int I2CDev::transfer(struct i2c_msg *msgs, int count){
+    return rdwr(msgs, count);
+}
+
+// recorded on the simulated clock like a real adapter on CLOCK_MONOTONIC
+int I2CDev::rdwr(struct i2c_msg *msgs, int count){
+    SimBus::Msg simMsgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    if(count > I2C_RDWR_IOCTL_MAX_MSGS) {
+        return -1;
+    }
+    for(int i = 0; i < count; i++) {
+        simMsgs[i].addr = msgs[i].addr;
+        simMsgs[i].read = (msgs[i].flags & I2C_M_RD) != 0;
+        simMsgs[i].buf = msgs[i].buf;
+        simMsgs[i].len = msgs[i].len;
+    }
+    uint32_t start = ds7505_now_us();
+    int ret = result(SimBus::defaultBus().transfer(simMsgs, count));
+    if(_trace != NULL) {
+        int error = ret == 0 ? 0 : errno;
+        _trace->record(start, ds7505_now_us() - start, msgs, count, error);
+        errno = error;
+    }
+    return ret;
+}
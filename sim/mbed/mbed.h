@@ -0,0 +1,379 @@
+/**
+Minimal stand-in for mbed.h so mbed/DS7505.cpp compiles and runs on a host
+against SimBus. Only what the driver and its example use is provided.
+ */
+
+#ifndef _SIM_MBED_H
+#define _SIM_MBED_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+#include <functional>
+
+#include "SimBus.h"
+
+#define DEVICE_I2C_ASYNCH   1
+
+#define I2C_EVENT_ERROR                 (1 << 1)
+#define I2C_EVENT_ERROR_NO_SLAVE        (1 << 2)
+#define I2C_EVENT_TRANSFER_COMPLETE     (1 << 3)
+#define I2C_EVENT_TRANSFER_EARLY_NACK   (1 << 4)
+#define I2C_EVENT_ALL                   (I2C_EVENT_ERROR | I2C_EVENT_TRANSFER_COMPLETE | \
+                                         I2C_EVENT_ERROR_NO_SLAVE | I2C_EVENT_TRANSFER_EARLY_NACK)
+
+namespace mbed {
+
+template <typename F>
+class Callback;
+
+template <typename R, typename... Args>
+class Callback<R(Args...)> {
+    public:
+        Callback() {}
+        Callback(std::nullptr_t) {}
+        template <typename F>
+        Callback(F f): _f(f) {}
+        template <typename T, typename U>
+        Callback(U *obj, R (T::*method)(Args...)): _f([obj, method](Args... args) {
+            return (obj->*method)(args...);
+        }) {}
+
+        R operator()(Args... args) const {
+            return _f(args...);
+        }
+        explicit operator bool() const {
+            return (bool)_f;
+        }
+    private:
+        std::function<R(Args...)> _f;
+};
+
+typedef Callback<void(int)> event_callback_t;
+
+template <typename T, typename U, typename R, typename... Args>
+Callback<R(Args...)> callback(U *obj, R (T::*method)(Args...)) {
+    return Callback<R(Args...)>(obj, method);
+}
+
+template <typename R, typename... Args>
+Callback<R(Args...)> callback(R (*func)(Args...)) {
+    return Callback<R(Args...)>(func);
+}
+
+}
+
+using namespace mbed;
+
+// microseconds of the simulated bus clock
+inline uint32_t us_ticker_read() {
+    return (uint32_t)(SimBus::defaultBus().now() / 1000);
+}
+
+// single-threaded host, nothing to lock
+class CriticalSectionLock {
+    public:
+        CriticalSectionLock() {}
+        ~CriticalSectionLock() {}
+};
+
+typedef enum {
+    PA_8,
+    PA_9,
+    PB_8,
+    PB_9,
+    LED1,
+    PIN_COUNT,
+    NC = -1
+} PinName;
+
+class I2C {
+    public:
+        I2C(PinName sda, PinName scl): _bus(SimBus::defaultBus()) {
+            (void)sda;
+            (void)scl;
+        }
+        I2C(SimBus &bus): _bus(bus) {}
+
+        void frequency(int hz) {
+            _bus.frequency(hz);
+        }
+
+        // 8-bit address, 0 on ACK like the mbed implementation
+        int read(int address, char *data, int length, bool repeated = false) {
+            return _bus.read(address >> 1, (uint8_t *)data, length, repeated) == SIMBUS_SUCCESS ? 0 : 1;
+        }
+        int write(int address, const char *data, int length, bool repeated = false) {
+            return _bus.write(address >> 1, (const uint8_t *)data, length, repeated) == SIMBUS_SUCCESS ? 0 : 1;
+        }
+
+        // the simulated transfer completes at once, the callback runs before transfer() returns
+        int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length,
+                     const event_callback_t &callback, int event = I2C_EVENT_TRANSFER_COMPLETE,
+                     bool repeated = false) {
+            SimBus::Msg msgs[2];
+            int count = 0;
+            if(tx_length > 0) {
+                msgs[count].addr = address >> 1;
+                msgs[count].read = false;
+                msgs[count].buf = (uint8_t *)tx_buffer;
+                msgs[count].len = tx_length;
+                count++;
+            }
+            if(rx_length > 0) {
+                msgs[count].addr = address >> 1;
+                msgs[count].read = true;
+                msgs[count].buf = (uint8_t *)rx_buffer;
+                msgs[count].len = rx_length;
+                count++;
+            }
+            (void)repeated;
+            int ret = _bus.transfer(msgs, count);
+            int result = ret == SIMBUS_SUCCESS ? I2C_EVENT_TRANSFER_COMPLETE :
+                         ret == SIMBUS_NACK ? I2C_EVENT_ERROR_NO_SLAVE : I2C_EVENT_ERROR;
+            if(callback && (result & event)) {
+                callback(result);
+            }
+            return 0;
+        }
+
+        void lock() {}
+        void unlock() {}
+
+        SimBus &bus() {
+            return _bus;
+        }
+    private:
+        SimBus &_bus;
+};
+
+// RAII lock of anything with lock()/unlock(), like platform/ScopedLock.h
+template <typename Lockable>
+class ScopedLock {
+    public:
+        ScopedLock(Lockable &lockable): _lockable(lockable) {
+            _lockable.lock();
+        }
+        ~ScopedLock() {
+            _lockable.unlock();
+        }
+    private:
+        Lockable &_lockable;
+};
+
+#define MBED_STATIC_ASSERT(expr, msg) static_assert(expr, msg)
+
+inline uint32_t core_util_atomic_load_u32(const volatile uint32_t *valuePtr){
+    return __atomic_load_n(valuePtr, __ATOMIC_SEQ_CST);
+}
+
+inline void core_util_atomic_store_u32(volatile uint32_t *valuePtr, uint32_t desiredValue){
+    __atomic_store_n(valuePtr, desiredValue, __ATOMIC_SEQ_CST);
+}
+
+inline uint8_t core_util_atomic_load_u8(const volatile uint8_t *valuePtr){
+    return __atomic_load_n(valuePtr, __ATOMIC_SEQ_CST);
+}
+
+typedef struct core_util_atomic_flag {
+    uint8_t _flag;
+} core_util_atomic_flag;
+
+#define CORE_UTIL_ATOMIC_FLAG_INIT { 0 }
+
+inline bool core_util_atomic_flag_test_and_set(volatile core_util_atomic_flag *flagPtr){
+    return __atomic_test_and_set(&flagPtr->_flag, __ATOMIC_SEQ_CST);
+}
+
+inline void core_util_atomic_flag_clear(volatile core_util_atomic_flag *flagPtr){
+    __atomic_clear(&flagPtr->_flag, __ATOMIC_SEQ_CST);
+}
+
+typedef enum {
+    PullNone,
+    PullUp,
+    PullDown,
+    OpenDrain
+} PinMode;
+
+typedef enum {
+    PIN_INPUT,
+    PIN_OUTPUT
+} PinDirection;
+
+// PB_8 is SCL and PB_9 is SDA of the default SimBus: rising SCL edges are recovery
+// clock pulses, a rising SDA edge while SCL is high is a STOP, SDA reads low while
+// a slave holds it
+class DigitalInOut {
+    public:
+        DigitalInOut(PinName pin, PinDirection direction = PIN_INPUT, PinMode mode = PullNone,
+                     int value = 0): _pin(pin), _output(direction == PIN_OUTPUT), _value(1) {
+            (void)mode;
+            if(_output) {
+                write(value);
+            }
+        }
+
+        void output() {
+            _output = true;
+        }
+        void input() {
+            _output = false;
+            _value = 1;
+        }
+        void mode(PinMode pull) {
+            (void)pull;
+        }
+
+        void write(int value) {
+            SimBus &bus = SimBus::defaultBus();
+            value = value ? 1 : 0;
+            if(_output && _value == 0 && value == 1) {
+                if(_pin == PB_8) {
+                    bus.clockScl();
+                } else if(_pin == PB_9 && sclHigh()) {
+                    bus.stopCondition();
+                }
+            }
+            if(_pin == PB_8) {
+                sclHigh() = value != 0;
+            }
+            _value = value;
+        }
+        int read() {
+            if(_pin == PB_9) {
+                return SimBus::defaultBus().sdaHeld() ? 0 : _value;
+            }
+            return _value;
+        }
+
+        DigitalInOut &operator=(int value) {
+            write(value);
+            return *this;
+        }
+        operator int() {
+            return read();
+        }
+    private:
+        PinName _pin;
+        bool _output;
+        int _value;
+
+        static bool &sclHigh() {
+            static bool high = true;
+            return high;
+        }
+};
+
+// edges are injected with InterruptIn::fire(pin, rising), as if the pin changed
+class InterruptIn {
+    public:
+        InterruptIn(PinName pin, PinMode mode = PullNone): _pin(pin) {
+            (void)mode;
+            pins()[_pin] = this;
+        }
+        ~InterruptIn() {
+            pins()[_pin] = nullptr;
+        }
+
+        void rise(Callback<void()> func) {
+            _rise = func;
+        }
+        void fall(Callback<void()> func) {
+            _fall = func;
+        }
+
+        static void fire(PinName pin, bool rising) {
+            InterruptIn *in = pins()[pin];
+            if(in == nullptr) {
+                return;
+            }
+            if(rising && in->_rise) {
+                in->_rise();
+            } else if(!rising && in->_fall) {
+                in->_fall();
+            }
+        }
+    private:
+        PinName _pin;
+        Callback<void()> _rise;
+        Callback<void()> _fall;
+
+        static InterruptIn **pins() {
+            static InterruptIn *table[PIN_COUNT] = {};
+            return table;
+        }
+};
+
+// events run when dispatch_once() or dispatch_for() is called, call_in() is due on the
+// virtual clock of the default SimBus, dispatch_for() advances it
+class EventQueue {
+    public:
+        int call(Callback<void()> func) {
+            return call_in(std::chrono::milliseconds(0), func);
+        }
+
+        int call_in(std::chrono::milliseconds ms, Callback<void()> func) {
+            if(_count == sizeof(_events) / sizeof(_events[0])) {
+                return 0;
+            }
+            _events[_count].due = SimBus::defaultBus().now() + ms.count() * 1000000ULL;
+            _events[_count].func = func;
+            _count++;
+            return ++_id;
+        }
+
+        void dispatch_once() {
+            uint64_t now = SimBus::defaultBus().now();
+            unsigned i = 0;
+            while(i < _count) {
+                if(_events[i].due <= now) {
+                    Callback<void()> func = _events[i].func;
+                    _events[i] = _events[--_count];
+                    func();
+                } else {
+                    i++;
+                }
+            }
+        }
+
+        void dispatch_for(std::chrono::milliseconds ms) {
+            SimBus &bus = SimBus::defaultBus();
+            uint64_t end = bus.now() + ms.count() * 1000000ULL;
+            while(true) {
+                uint64_t next = end;
+                for(unsigned i = 0; i < _count; i++) {
+                    if(_events[i].due < next) {
+                        next = _events[i].due;
+                    }
+                }
+                if(next > bus.now()) {
+                    bus.sleep(next - bus.now());
+                }
+                dispatch_once();
+                if(bus.now() >= end) {
+                    return;
+                }
+            }
+        }
+    private:
+        struct event_t {
+            uint64_t due;
+            Callback<void()> func;
+        };
+        event_t _events[16];
+        unsigned _count = 0;
+        int _id = 0;
+};
+
+inline void thread_sleep_for(uint32_t millisec){
+    SimBus::defaultBus().sleep(millisec * 1000000ULL);
+}
+
+inline void wait_us(int us){
+    SimBus::defaultBus().sleep(us * 1000ULL);
+}
+
+#endif
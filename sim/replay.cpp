@@ -0,0 +1,110 @@
+/**
+Record and replay of the Linux port, see linux/DS7505Trace.h. Built with
+-DSIM_RECORD against sim/linux/I2CDevSim.cpp the workload runs on the
+simulator and is recorded into the trace file; built against
+linux/I2CDevReplay.cpp the same workload runs from that trace (or from a
+field capture of the same calls) without the simulator. Both print the
+transfers and the bus time per API call, the replay also the transfers
+that left the recorded path, so a driver change shows up as a different
+line or as mismatches.
+usage: replay_linux [trace]
+ */
+
+#include <stdio.h>
+
+#include "DS7505.h"
+#include "DS7505Bus.h"
+#include "DS7505Trace.h"
+#ifdef SIM_RECORD
+#include "DS7505Sim.h"
+#include "SimBus.h"
+#define MODE "record"
+#else
+#define MODE "replay"
+#endif
+
+#define TRACE_PATH  "/tmp/ds7505-replay.trace"
+
+// the replay records what it replays as well, both sides count transfers the same way
+static void step(const char *label, DS7505TraceWriter &trace, int calls, uint32_t transfers,
+                 uint32_t startUs)
+{
+    printf("%s %-16s: %4d calls, %.2f transfers/call, %.1f us/call\n", MODE, label, calls,
+           (double)(trace.transfers() - transfers) / calls,
+           (double)(ds7505_now_us() - startUs) / calls);
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = argc > 1 ? argv[1] : TRACE_PATH;
+#ifdef SIM_RECORD
+    SimBus &bus = SimBus::defaultBus();
+    DS7505Sim sensors[3] = { DS7505Sim(0x48, 21.5f), DS7505Sim(0x49, 22.0f), DS7505Sim(0x4A, 23.0f) };
+    for(int i = 0; i < 3; i++) {
+        bus.attach(sensors[i]);
+    }
+    DS7505TraceWriter trace(path);
+    I2CDev i2c("/dev/i2c-sim");
+#else
+    DS7505TraceWriter trace("/tmp/ds7505-replayed.trace");
+    I2CDev i2c(path);
+#endif
+    if(!trace.isOpen() || !i2c.isOpen()) {
+        fprintf(stderr, "%s: cannot open\n", path);
+        return 1;
+    }
+    i2c.trace(&trace);
+    DS7505 ds7505(i2c);
+    DS7505Bus sensorBus(i2c);
+    DS7505Bus::sample_t samples[DS7505_BUS_MAX_SENSORS];
+
+    uint32_t transfers = trace.transfers();
+    uint32_t start = ds7505_now_us();
+    ds7505.getConfigReg();
+    ds7505.setConfigReg(DS7505::BITS_9);
+    ds7505.setTempOSCenti(4500);
+    ds7505.setTempHystCenti(4000);
+    step("configure", trace, 4, transfers, start);
+
+    transfers = trace.transfers();
+    start = ds7505_now_us();
+    for(int i = 0; i < 100; i++) {
+        ds7505.getTemp();
+    }
+    step("getTemp", trace, 100, transfers, start);
+
+#ifdef SIM_RECORD
+    bus.failNext(2);
+#endif
+    transfers = trace.transfers();
+    start = ds7505_now_us();
+    int8_t within = ds7505.getTempWithin(50000);
+    step("getTempWithin", trace, 1, transfers, start);
+
+    ds7505.shutDown();
+    transfers = trace.transfers();
+    start = ds7505_now_us();
+    for(int i = 0; i < 10; i++) {
+        ds7505.getTempOneShot();
+    }
+    step("getTempOneShot", trace, 10, transfers, start);
+
+    transfers = trace.transfers();
+    start = ds7505_now_us();
+    sensorBus.scan();
+    for(int i = 0; i < 100; i++) {
+        sensorBus.poll(samples);
+    }
+    step("scan + bus poll", trace, 101, transfers, start);
+
+    printf("%s: getTempWithin %d, last %d centi C, %u transfers, %u messages\n", MODE, within,
+           DS7505Protocol::rawToCenti(ds7505.ds7505.temperature_raw), trace.transfers(), trace.records());
+#ifndef SIM_RECORD
+    ds7505_replay_stats_t stats;
+    ds7505_replay_stats(stats);
+    printf("replay: %u transfers matched, %u mismatches, %u recorded errors, %u us bus time, "
+           "%u records left\n", stats.transfers, stats.mismatches, stats.errors, stats.bus_us,
+           stats.left);
+#endif
+    return 0;
+}
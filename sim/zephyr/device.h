@@ -0,0 +1,38 @@
+#ifndef _SIM_DEVICE_H
+#define _SIM_DEVICE_H
+
+#include <stdbool.h>
+#include <devicetree.h>
+
+struct device {
+	const char *name;
+	void *data;
+	const void *config;
+	const void *api;
+	int (*init)(const struct device *dev);
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* device bound to SimBus::defaultBus() */
+extern const struct device sim_i2c;
+const struct device *sim_i2c_device(void);
+
+/* devices defined with DEVICE_DT_INST_DEFINE are not initialized at boot */
+static inline int sim_device_init(const struct device *dev)
+{
+	return dev->init != NULL ? dev->init(dev) : 0;
+}
+
+static inline bool device_is_ready(const struct device *dev)
+{
+	return dev != NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_DEVICE_H */
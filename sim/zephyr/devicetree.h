@@ -0,0 +1,24 @@
+/*
+ * Devicetree of the host build: one "maxim,ds7505" node at 0x48 on the simulated
+ * bus, resolution = <12>, os-gpios = <&sim_gpio 3 GPIO_ACTIVE_LOW>. The instance
+ * macros expand for instance 0 only, the device is sim_ds7505_0.
+ */
+
+#ifndef _SIM_DEVICETREE_H
+#define _SIM_DEVICETREE_H
+
+#define DT_HAS_COMPAT_STATUS_OKAY(compat) 1
+#define DT_INST_FOREACH_STATUS_OKAY(fn) fn(0)
+
+#define SIM_DT_INST_0_resolution 12
+#define DT_INST_PROP(inst, prop) SIM_DT_INST_##inst##_##prop
+
+#define I2C_DT_SPEC_INST_GET(inst) { &sim_i2c, 0x48 }
+#define GPIO_DT_SPEC_INST_GET_OR(inst, prop, default_value) { &sim_gpio, 3, GPIO_ACTIVE_LOW }
+
+#define CONFIG_SENSOR_INIT_PRIORITY 90
+
+#define DEVICE_DT_INST_DEFINE(inst, init_fn, pm, data, config, level, prio, api)             \
+	const struct device sim_ds7505_##inst = { "DS7505_" #inst, data, config, api, init_fn }
+
+#endif /* _SIM_DEVICETREE_H */
@@ -0,0 +1,64 @@
+/*
+ * Subset of the Zephyr GPIO API for host builds. Pins do not change on their own,
+ * sim_gpio_fire() runs the callbacks registered for a pin as the GPIO ISR would.
+ */
+
+#ifndef _SIM_DRIVERS_GPIO_H
+#define _SIM_DRIVERS_GPIO_H
+
+#include <zephyr.h>
+#include <device.h>
+
+typedef uint8_t gpio_pin_t;
+typedef uint32_t gpio_flags_t;
+typedef uint32_t gpio_port_pins_t;
+
+#define GPIO_INPUT (1U << 16)
+#define GPIO_ACTIVE_LOW (1U << 0)
+#define GPIO_PULL_UP (1U << 4)
+#define GPIO_INT_DISABLE (1U << 21)
+#define GPIO_INT_EDGE_TO_ACTIVE (1U << 22)
+#define GPIO_INT_EDGE_TO_INACTIVE (1U << 23)
+
+struct gpio_dt_spec {
+	const struct device *port;
+	gpio_pin_t pin;
+	gpio_flags_t dt_flags;
+};
+
+struct gpio_callback;
+typedef void (*gpio_callback_handler_t)(const struct device *port, struct gpio_callback *cb,
+					gpio_port_pins_t pins);
+
+struct gpio_callback {
+	struct gpio_callback *next;
+	gpio_callback_handler_t handler;
+	gpio_port_pins_t pin_mask;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void gpio_init_callback(struct gpio_callback *callback,
+				      gpio_callback_handler_t handler, gpio_port_pins_t pin_mask)
+{
+	callback->handler = handler;
+	callback->pin_mask = pin_mask;
+}
+
+int gpio_pin_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t extra_flags);
+int gpio_pin_interrupt_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t flags);
+int gpio_add_callback(const struct device *port, struct gpio_callback *callback);
+int gpio_remove_callback(const struct device *port, struct gpio_callback *callback);
+
+/* simulated GPIO port and interrupt */
+extern const struct device sim_gpio;
+const struct device *sim_gpio_device(void);
+void sim_gpio_fire(const struct device *port, gpio_pin_t pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_DRIVERS_GPIO_H */
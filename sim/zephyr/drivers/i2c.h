@@ -0,0 +1,91 @@
+/*
+ * Subset of the Zephyr I2C API, i2c_transfer() is one driver call on SimBus,
+ * the messages are separated by repeated starts and end with a STOP.
+ */
+
+#ifndef _SIM_DRIVERS_I2C_H
+#define _SIM_DRIVERS_I2C_H
+
+#include <zephyr.h>
+#include <device.h>
+
+#define I2C_MSG_WRITE (0U << 0U)
+#define I2C_MSG_READ (1U << 0U)
+#define I2C_MSG_RW_MASK (1U << 0U)
+#define I2C_MSG_STOP (1U << 1U)
+#define I2C_MSG_RESTART (1U << 2U)
+
+struct i2c_msg {
+	uint8_t *buf;
+	uint32_t len;
+	uint8_t flags;
+};
+
+struct i2c_dt_spec {
+	const struct device *bus;
+	uint16_t addr;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int i2c_transfer(const struct device *dev, struct i2c_msg *msgs, uint8_t num_msgs,
+		 uint16_t addr);
+
+/* nine SCL pulses and a STOP on the simulated bus */
+int i2c_recover_bus(const struct device *dev);
+
+#ifdef CONFIG_I2C_CALLBACK
+typedef void (*i2c_callback_t)(const struct device *dev, int result, void *data);
+
+/* the simulated transfer completes at once, cb runs before i2c_transfer_cb() returns */
+int i2c_transfer_cb(const struct device *dev, struct i2c_msg *msgs, uint8_t num_msgs,
+		    uint16_t addr, i2c_callback_t cb, void *userdata);
+#endif
+
+static inline int i2c_write(const struct device *dev, const uint8_t *buf, uint32_t num_bytes,
+			    uint16_t addr)
+{
+	struct i2c_msg msg;
+
+	msg.buf = (uint8_t *)buf;
+	msg.len = num_bytes;
+	msg.flags = I2C_MSG_WRITE | I2C_MSG_STOP;
+
+	return i2c_transfer(dev, &msg, 1, addr);
+}
+
+static inline int i2c_read(const struct device *dev, uint8_t *buf, uint32_t num_bytes,
+			   uint16_t addr)
+{
+	struct i2c_msg msg;
+
+	msg.buf = buf;
+	msg.len = num_bytes;
+	msg.flags = I2C_MSG_READ | I2C_MSG_STOP;
+
+	return i2c_transfer(dev, &msg, 1, addr);
+}
+
+static inline int i2c_write_read(const struct device *dev, uint16_t addr, const void *write_buf,
+				 size_t num_write, void *read_buf, size_t num_read)
+{
+	struct i2c_msg msg[2];
+
+	msg[0].buf = (uint8_t *)write_buf;
+	msg[0].len = num_write;
+	msg[0].flags = I2C_MSG_WRITE;
+
+	msg[1].buf = (uint8_t *)read_buf;
+	msg[1].len = num_read;
+	msg[1].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+
+	return i2c_transfer(dev, msg, 2, addr);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_DRIVERS_I2C_H */
@@ -0,0 +1,136 @@
+/*
+ * Subset of the Zephyr sensor API for host builds, the calls go straight to the
+ * driver API of the device.
+ */
+
+#ifndef _SIM_DRIVERS_SENSOR_H
+#define _SIM_DRIVERS_SENSOR_H
+
+#include <zephyr.h>
+#include <device.h>
+
+struct sensor_value {
+	int32_t val1;
+	int32_t val2;
+};
+
+enum sensor_channel {
+	SENSOR_CHAN_AMBIENT_TEMP = 13,
+	SENSOR_CHAN_ALL = 57,
+};
+
+enum sensor_trigger_type {
+	SENSOR_TRIG_THRESHOLD = 2,
+};
+
+enum sensor_attribute {
+	SENSOR_ATTR_LOWER_THRESH = 2,
+	SENSOR_ATTR_UPPER_THRESH = 3,
+	SENSOR_ATTR_HYSTERESIS = 5,
+	SENSOR_ATTR_PRIV_START = 0x8000,
+};
+
+struct sensor_trigger {
+	enum sensor_trigger_type type;
+	enum sensor_channel chan;
+};
+
+typedef void (*sensor_trigger_handler_t)(const struct device *dev,
+					 const struct sensor_trigger *trigger);
+
+#ifdef CONFIG_SENSOR_ASYNC_API
+#include <rtio/rtio.h>
+
+struct sensor_chan_spec {
+	uint16_t chan_type;
+	uint16_t chan_idx;
+};
+
+struct sensor_read_config {
+	const struct device *sensor;
+	bool is_streaming;
+	struct sensor_chan_spec *channels;
+	size_t count;
+	size_t max;
+};
+
+struct sensor_decoder_api {
+	int (*get_frame_count)(const uint8_t *buffer, struct sensor_chan_spec channel,
+			       uint16_t *frame_count);
+	int (*get_size_info)(struct sensor_chan_spec channel, size_t *base_size,
+			     size_t *frame_size);
+	int (*decode)(const uint8_t *buffer, struct sensor_chan_spec channel, uint32_t *fit,
+		      uint16_t max_count, void *data_out);
+};
+
+/* SENSOR_DT_READ_IODEV() for one channel of a device that is not a devicetree node */
+#define SIM_SENSOR_READ_IODEV(name, dev, chan)                                               \
+	static struct sensor_chan_spec name##_channels[] = { { chan, 0 } };                  \
+	static struct sensor_read_config name##_config = { dev, false, name##_channels, 1,   \
+							   1 };                              \
+	static struct rtio_iodev name = { NULL, &name##_config }
+#endif
+
+struct sensor_driver_api {
+	int (*attr_set)(const struct device *dev, enum sensor_channel chan,
+			enum sensor_attribute attr, const struct sensor_value *val);
+	int (*trigger_set)(const struct device *dev, const struct sensor_trigger *trig,
+			   sensor_trigger_handler_t handler);
+	int (*sample_fetch)(const struct device *dev, enum sensor_channel chan);
+	int (*channel_get)(const struct device *dev, enum sensor_channel chan,
+			   struct sensor_value *val);
+#ifdef CONFIG_SENSOR_ASYNC_API
+	void (*submit)(const struct device *sensor, struct rtio_iodev_sqe *sqe);
+	int (*get_decoder)(const struct device *dev, const struct sensor_decoder_api **api);
+#endif
+};
+
+static inline int sensor_attr_set(const struct device *dev, enum sensor_channel chan,
+				  enum sensor_attribute attr, const struct sensor_value *val)
+{
+	return ((const struct sensor_driver_api *)dev->api)->attr_set(dev, chan, attr, val);
+}
+
+static inline int sensor_trigger_set(const struct device *dev, const struct sensor_trigger *trig,
+				     sensor_trigger_handler_t handler)
+{
+	return ((const struct sensor_driver_api *)dev->api)->trigger_set(dev, trig, handler);
+}
+
+static inline int sensor_sample_fetch(const struct device *dev)
+{
+	return ((const struct sensor_driver_api *)dev->api)->sample_fetch(dev, SENSOR_CHAN_ALL);
+}
+
+static inline int sensor_channel_get(const struct device *dev, enum sensor_channel chan,
+				     struct sensor_value *val)
+{
+	return ((const struct sensor_driver_api *)dev->api)->channel_get(dev, chan, val);
+}
+
+#ifdef CONFIG_SENSOR_ASYNC_API
+static inline int sensor_get_decoder(const struct device *dev,
+				     const struct sensor_decoder_api **decoder)
+{
+	return ((const struct sensor_driver_api *)dev->api)->get_decoder(dev, decoder);
+}
+
+/* blocking read into buf, the driver writes its encoded frame there */
+static inline int sensor_read(struct rtio_iodev *iodev, struct rtio *ctx, uint8_t *buf,
+			      size_t buf_len)
+{
+	const struct sensor_read_config *cfg = (const struct sensor_read_config *)iodev->data;
+	struct rtio_iodev_sqe sqe = { { iodev, buf, (uint32_t)buf_len }, 0 };
+
+	ctx->submitted++;
+	((const struct sensor_driver_api *)cfg->sensor->api)->submit(cfg->sensor, &sqe);
+	return sqe.result;
+}
+#endif
+
+static inline double sensor_value_to_double(const struct sensor_value *val)
+{
+	return (double)val->val1 + (double)val->val2 / 1000000;
+}
+
+#endif /* _SIM_DRIVERS_SENSOR_H */
@@ -0,0 +1,31 @@
+/*
+ * Decoded sensor data of the Zephyr read/decode API for host builds.
+ */
+
+#ifndef _SIM_DRIVERS_SENSOR_DATA_TYPES_H
+#define _SIM_DRIVERS_SENSOR_DATA_TYPES_H
+
+#include <zephyr.h>
+
+typedef int32_t q31_t;
+
+struct sensor_data_header {
+	uint64_t base_timestamp_ns;
+	uint16_t reading_count;
+};
+
+struct sensor_q31_sample_data {
+	uint32_t timestamp_delta;
+	union {
+		q31_t value;
+		q31_t temperature;
+	};
+};
+
+struct sensor_q31_data {
+	struct sensor_data_header header;
+	int8_t shift;
+	struct sensor_q31_sample_data readings[1];
+};
+
+#endif /* _SIM_DRIVERS_SENSOR_DATA_TYPES_H */
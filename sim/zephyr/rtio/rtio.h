@@ -0,0 +1,54 @@
+/*
+ * Subset of RTIO for host builds, one submission is completed before the
+ * submit call returns and the result is kept in the queue entry.
+ */
+
+#ifndef _SIM_RTIO_RTIO_H
+#define _SIM_RTIO_RTIO_H
+
+#include <zephyr.h>
+
+struct rtio {
+	uint32_t submitted;
+};
+
+#define RTIO_DEFINE(name, sq_sz, cq_sz) static struct rtio name
+
+struct rtio_iodev {
+	const void *api;
+	void *data;
+};
+
+struct rtio_sqe {
+	const struct rtio_iodev *iodev;
+	uint8_t *buf;
+	uint32_t buf_len;
+};
+
+struct rtio_iodev_sqe {
+	struct rtio_sqe sqe;
+	int result;
+};
+
+static inline int rtio_sqe_rx_buf(const struct rtio_iodev_sqe *iodev_sqe, uint32_t min_buf_len,
+				  uint32_t max_buf_len, uint8_t **buf, uint32_t *buf_len)
+{
+	if (iodev_sqe->sqe.buf_len < min_buf_len) {
+		return -ENOMEM;
+	}
+	*buf = iodev_sqe->sqe.buf;
+	*buf_len = iodev_sqe->sqe.buf_len < max_buf_len ? iodev_sqe->sqe.buf_len : max_buf_len;
+	return 0;
+}
+
+static inline void rtio_iodev_sqe_ok(struct rtio_iodev_sqe *iodev_sqe, int result)
+{
+	iodev_sqe->result = result;
+}
+
+static inline void rtio_iodev_sqe_err(struct rtio_iodev_sqe *iodev_sqe, int result)
+{
+	iodev_sqe->result = result;
+}
+
+#endif /* _SIM_RTIO_RTIO_H */
@@ -0,0 +1,35 @@
+/*
+ * C access to the default SimBus for Zephyr host builds.
+ */
+
+#ifndef _SIM_H
+#define _SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int sim_add_sensor(uint8_t addr, float ambient, float rate_per_second);
+void sim_remove_sensor(uint8_t addr);
+/* ambient of the sensor from now on, changing by rate_per_second */
+void sim_set_ambient(uint8_t addr, float ambient, float rate_per_second);
+/* O.S. output level of the simulated sensor, after the pending conversions */
+bool sim_sensor_os(uint8_t addr);
+void sim_reset_stats(void);
+void sim_print_stats(const char *label, uint32_t samples);
+/* driver calls since the last sim_reset_stats() */
+uint32_t sim_stats_calls(void);
+/* the next count transfers are not acknowledged */
+void sim_fail_next(uint32_t count);
+/* a slave holds SDA low for the next pulses SCL pulses */
+void sim_hold_sda(uint8_t pulses);
+bool sim_sda_held(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_H */
@@ -0,0 +1,8 @@
+#ifndef _SIM_PRINTK_H
+#define _SIM_PRINTK_H
+
+#include <stdio.h>
+
+#define printk printf
+
+#endif /* _SIM_PRINTK_H */
@@ -0,0 +1,118 @@
+/*
+ * Minimal stand-in for the Zephyr kernel headers so zephyr/ds7505.c compiles
+ * and runs on a host against SimBus.
+ */
+
+#ifndef _SIM_ZEPHYR_H
+#define _SIM_ZEPHYR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef __cplusplus
+#define BUILD_ASSERT(expr, msg) static_assert(expr, msg)
+#else
+#define BUILD_ASSERT(expr, msg) _Static_assert(expr, msg)
+#endif
+
+#define BIT(n) (1UL << (n))
+
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+#define ARG_UNUSED(x) (void)(x)
+
+/* the simulated work queue runs the handler before k_work_submit() returns */
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work {
+	k_work_handler_t handler;
+};
+
+void k_work_init(struct k_work *work, k_work_handler_t handler);
+int k_work_submit(struct k_work *work);
+int k_work_cancel(struct k_work *work);
+
+/* delayed work runs from k_msleep()/k_usleep() once the virtual clock reaches it */
+typedef struct {
+	uint64_t ns;
+} k_timeout_t;
+
+#define K_MSEC(ms) ((k_timeout_t){ (uint64_t)(ms)*1000000ULL })
+#define K_NO_WAIT ((k_timeout_t){ 0 })
+#define K_FOREVER ((k_timeout_t){ UINT64_MAX })
+
+struct k_work_delayable {
+	struct k_work work;
+	uint64_t due;
+	bool pending;
+};
+
+void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler);
+int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay);
+int k_work_cancel_delayable(struct k_work_delayable *dwork);
+struct k_work_delayable *k_work_delayable_from_work(struct k_work *work);
+
+int32_t k_msleep(int32_t ms);
+int32_t k_usleep(int32_t us);
+int64_t k_uptime_get(void);
+uint64_t sim_uptime_ns(void);
+
+/* one tick per ns on the simulated clock */
+#define k_uptime_ticks() ((int64_t)sim_uptime_ns())
+#define k_ticks_to_ns_floor64(t) ((uint64_t)(t))
+
+/* 1 MHz cycle counter on the simulated clock */
+#define k_cycle_get_32() ((uint32_t)(sim_uptime_ns() / 1000))
+#define k_cyc_to_us_floor32(c) ((uint32_t)(c))
+
+#define compiler_barrier() __asm__ __volatile__("" ::: "memory")
+
+/* single-threaded host, the mutex only counts so unbalanced use shows up */
+struct k_mutex {
+	uint32_t lock_count;
+};
+
+static inline int k_mutex_init(struct k_mutex *mutex)
+{
+	mutex->lock_count = 0;
+	return 0;
+}
+
+static inline int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	(void)timeout;
+	mutex->lock_count++;
+	return 0;
+}
+
+static inline int k_mutex_unlock(struct k_mutex *mutex)
+{
+	if (mutex->lock_count == 0) {
+		return -EINVAL;
+	}
+	mutex->lock_count--;
+	return 0;
+}
+
+/* single-threaded host, nothing to lock */
+static inline unsigned int irq_lock(void)
+{
+	return 0;
+}
+
+static inline void irq_unlock(unsigned int key)
+{
+	(void)key;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SIM_ZEPHYR_H */
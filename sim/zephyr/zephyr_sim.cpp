@@ -0,0 +1,289 @@
+#include "SimBus.h"
+
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include <drivers/gpio.h>
+#include <sim.h>
+
+static struct gpio_callback *sim_gpio_callbacks = NULL;
+extern "C" const struct device sim_i2c = { "SIM_I2C", &SimBus::defaultBus() };
+extern "C" const struct device sim_gpio = { "SIM_GPIO", &sim_gpio_callbacks };
+
+extern "C" const struct device *sim_i2c_device(void)
+{
+	return &sim_i2c;
+}
+
+extern "C" int i2c_transfer(const struct device *dev, struct i2c_msg *msgs, uint8_t num_msgs,
+			    uint16_t addr)
+{
+	SimBus *bus = (SimBus *)dev->data;
+	SimBus::Msg sim_msgs[8];
+
+	if (num_msgs > 8) {
+		return -EINVAL;
+	}
+	for (uint8_t i = 0; i < num_msgs; i++) {
+		sim_msgs[i].addr = (uint8_t)addr;
+		sim_msgs[i].read = (msgs[i].flags & I2C_MSG_RW_MASK) == I2C_MSG_READ;
+		sim_msgs[i].buf = msgs[i].buf;
+		sim_msgs[i].len = (int)msgs[i].len;
+	}
+	switch (bus->transfer(sim_msgs, num_msgs)) {
+	case SIMBUS_SUCCESS:
+		return 0;
+	case SIMBUS_BUS_ERROR:
+		return -ETIMEDOUT;
+	default:
+		return -EIO;
+	}
+}
+
+extern "C" int i2c_recover_bus(const struct device *dev)
+{
+	SimBus *bus = (SimBus *)dev->data;
+
+	bus->recover();
+	return bus->sdaHeld() ? -EBUSY : 0;
+}
+
+#ifdef CONFIG_I2C_CALLBACK
+extern "C" int i2c_transfer_cb(const struct device *dev, struct i2c_msg *msgs, uint8_t num_msgs,
+			       uint16_t addr, i2c_callback_t cb, void *userdata)
+{
+	int ret = i2c_transfer(dev, msgs, num_msgs, addr);
+
+	cb(dev, ret, userdata);
+	return 0;
+}
+#endif
+
+extern "C" const struct device *sim_gpio_device(void)
+{
+	return &sim_gpio;
+}
+
+extern "C" int gpio_pin_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t extra_flags)
+{
+	return spec->port == &sim_gpio ? 0 : -ENODEV;
+}
+
+extern "C" int gpio_pin_interrupt_configure_dt(const struct gpio_dt_spec *spec, gpio_flags_t flags)
+{
+	return spec->port == &sim_gpio ? 0 : -ENODEV;
+}
+
+extern "C" int gpio_add_callback(const struct device *port, struct gpio_callback *callback)
+{
+	struct gpio_callback **head = (struct gpio_callback **)port->data;
+
+	callback->next = *head;
+	*head = callback;
+	return 0;
+}
+
+extern "C" int gpio_remove_callback(const struct device *port, struct gpio_callback *callback)
+{
+	struct gpio_callback **node = (struct gpio_callback **)port->data;
+
+	while (*node != NULL) {
+		if (*node == callback) {
+			*node = callback->next;
+			return 0;
+		}
+		node = &(*node)->next;
+	}
+	return -EINVAL;
+}
+
+extern "C" void sim_gpio_fire(const struct device *port, gpio_pin_t pin)
+{
+	struct gpio_callback *cb = *(struct gpio_callback **)port->data;
+
+	while (cb != NULL) {
+		struct gpio_callback *next = cb->next;
+
+		if (cb->pin_mask & BIT(pin)) {
+			cb->handler(port, cb, BIT(pin));
+		}
+		cb = next;
+	}
+}
+
+extern "C" bool sim_sensor_os(uint8_t addr)
+{
+	DS7505Sim *dev = SimBus::defaultBus().device(addr);
+
+	if (dev == NULL) {
+		return false;
+	}
+	dev->update(SimBus::defaultBus().now());
+	return dev->os();
+}
+
+extern "C" void k_work_init(struct k_work *work, k_work_handler_t handler)
+{
+	work->handler = handler;
+}
+
+extern "C" int k_work_submit(struct k_work *work)
+{
+	work->handler(work);
+	return 1;
+}
+
+extern "C" int k_work_cancel(struct k_work *work)
+{
+	return 0;
+}
+
+#define SIM_MAX_DELAYED 16
+static struct k_work_delayable *sim_delayed[SIM_MAX_DELAYED];
+
+extern "C" void k_work_init_delayable(struct k_work_delayable *dwork, k_work_handler_t handler)
+{
+	k_work_init(&dwork->work, handler);
+	dwork->pending = false;
+}
+
+extern "C" int k_work_schedule(struct k_work_delayable *dwork, k_timeout_t delay)
+{
+	if (dwork->pending) {
+		return 0;
+	}
+	for (int i = 0; i < SIM_MAX_DELAYED; i++) {
+		if (sim_delayed[i] == NULL) {
+			dwork->due = SimBus::defaultBus().now() + delay.ns;
+			dwork->pending = true;
+			sim_delayed[i] = dwork;
+			return 1;
+		}
+	}
+	return -EBUSY;
+}
+
+extern "C" int k_work_cancel_delayable(struct k_work_delayable *dwork)
+{
+	for (int i = 0; i < SIM_MAX_DELAYED; i++) {
+		if (sim_delayed[i] == dwork) {
+			sim_delayed[i] = NULL;
+		}
+	}
+	dwork->pending = false;
+	return 0;
+}
+
+extern "C" struct k_work_delayable *k_work_delayable_from_work(struct k_work *work)
+{
+	return CONTAINER_OF(work, struct k_work_delayable, work);
+}
+
+/* advances the clock to end, running the delayed work that falls due on the way */
+static void sim_sleep_until(uint64_t end)
+{
+	SimBus &bus = SimBus::defaultBus();
+
+	while (true) {
+		int next = -1;
+
+		for (int i = 0; i < SIM_MAX_DELAYED; i++) {
+			if (sim_delayed[i] != NULL && sim_delayed[i]->due <= end &&
+			    (next < 0 || sim_delayed[i]->due < sim_delayed[next]->due)) {
+				next = i;
+			}
+		}
+		if (next < 0) {
+			break;
+		}
+		struct k_work_delayable *dwork = sim_delayed[next];
+
+		if (dwork->due > bus.now()) {
+			bus.sleep(dwork->due - bus.now());
+		}
+		sim_delayed[next] = NULL;
+		dwork->pending = false;
+		dwork->work.handler(&dwork->work);
+	}
+	if (end > bus.now()) {
+		bus.sleep(end - bus.now());
+	}
+}
+
+extern "C" int32_t k_msleep(int32_t ms)
+{
+	sim_sleep_until(SimBus::defaultBus().now() + ms * 1000000ULL);
+	return 0;
+}
+
+extern "C" int32_t k_usleep(int32_t us)
+{
+	sim_sleep_until(SimBus::defaultBus().now() + us * 1000ULL);
+	return 0;
+}
+
+extern "C" int64_t k_uptime_get(void)
+{
+	return (int64_t)(SimBus::defaultBus().now() / 1000000ULL);
+}
+
+extern "C" uint64_t sim_uptime_ns(void)
+{
+	return SimBus::defaultBus().now();
+}
+
+extern "C" int sim_add_sensor(uint8_t addr, float ambient, float rate_per_second)
+{
+	DS7505Sim *dev = new DS7505Sim(addr, ambient);
+
+	dev->setAmbient(ambient, rate_per_second);
+	return SimBus::defaultBus().attach(*dev);
+}
+
+extern "C" void sim_set_ambient(uint8_t addr, float ambient, float rate_per_second)
+{
+	DS7505Sim *dev = SimBus::defaultBus().device(addr);
+
+	if (dev != NULL) {
+		dev->setAmbient(ambient - rate_per_second * (SimBus::defaultBus().now() / 1e9f),
+				rate_per_second);
+	}
+}
+
+extern "C" void sim_remove_sensor(uint8_t addr)
+{
+	DS7505Sim *dev = SimBus::defaultBus().device(addr);
+
+	SimBus::defaultBus().detach(addr);
+	delete dev;
+}
+
+extern "C" void sim_reset_stats(void)
+{
+	SimBus::defaultBus().resetStats();
+}
+
+extern "C" void sim_fail_next(uint32_t count)
+{
+	SimBus::defaultBus().failNext(count);
+}
+
+extern "C" void sim_hold_sda(uint8_t pulses)
+{
+	SimBus::defaultBus().holdSda(pulses);
+}
+
+extern "C" bool sim_sda_held(void)
+{
+	return SimBus::defaultBus().sdaHeld();
+}
+
+extern "C" void sim_print_stats(const char *label, uint32_t samples)
+{
+	SimBus::defaultBus().printStats(label, samples);
+}
+
+extern "C" uint32_t sim_stats_calls(void)
+{
+	return SimBus::defaultBus().stats().calls;
+}
@@ -0,0 +1,57 @@
+/*
+ * Bus policy of DS7505Core (core/DS7505Core.h) for C++ applications on Zephyr,
+ * writeRead is one i2c_write_read() with a repeated start, transfer() one
+ * i2c_transfer().
+ */
+
+#ifndef _DS7505ZEPHYRBUS_H
+#define _DS7505ZEPHYRBUS_H
+
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+
+#include "DS7505Core.h"
+
+class DS7505ZephyrBus {
+public:
+	explicit DS7505ZephyrBus(const struct device *dev) : _dev(dev)
+	{
+	}
+
+	int write(uint8_t addr, const uint8_t *data, int length)
+	{
+		return i2c_write(_dev, data, length, addr);
+	}
+
+	int read(uint8_t addr, uint8_t *data, int length)
+	{
+		return i2c_read(_dev, data, length, addr);
+	}
+
+	int writeRead(uint8_t addr, const uint8_t *wdata, int wlength, uint8_t *rdata, int rlength)
+	{
+		return i2c_write_read(_dev, addr, wdata, wlength, rdata, rlength);
+	}
+
+	int transfer(uint8_t addr, DS7505Protocol::msg_t *msgs, int count)
+	{
+		struct i2c_msg i2cMsgs[DS7505Protocol::TRANSFER_MAX];
+
+		if (count > DS7505Protocol::TRANSFER_MAX) {
+			return -EINVAL;
+		}
+		for (int i = 0; i < count; i++) {
+			i2cMsgs[i].buf = msgs[i].data;
+			i2cMsgs[i].len = msgs[i].length;
+			i2cMsgs[i].flags = (msgs[i].read ? I2C_MSG_READ : I2C_MSG_WRITE) |
+					   (i + 1 == count ? I2C_MSG_STOP : 0);
+		}
+		return i2c_transfer(_dev, i2cMsgs, count, addr);
+	}
+
+private:
+	const struct device *_dev;
+};
+
+#endif //_DS7505ZEPHYRBUS_H_
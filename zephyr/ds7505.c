@@ -2,81 +2,358 @@
 #include <sys/printk.h>
 #include <device.h>
 #include <drivers/i2c.h>
+#include <errno.h>
+#include <string.h>
 #include "ds7505.h"
 
-static int8_t ds7505_get_temperature_reg(struct ds7505_t *ds7505, enum eReg tempReg)
+static uint32_t ds7505_now_us(void)
 {
-	uint8_t len = 2;
-	uint8_t data[len];
-	uint8_t reg = (uint8_t)tempReg;
-
-	if (i2c_write(ds7505->dev, &reg, 1, ds7505->addr) == 0) {
-		if (i2c_read(ds7505->dev, data, (uint32_t)len, ds7505->addr) == 0) {
-			int16_t buf = (data[0] << 8) | data[1];
-			float temp = buf / 256.0;
-			if (tempReg == TEMPER) {
-				ds7505->temperature = temp;
-			} else if (tempReg == T_OS) {
-				ds7505->temp_os = temp;
-			} else {
-				ds7505->temp_hyst = temp;
-			}
-			return DS7505_SUCCESS;
+	return k_cyc_to_us_floor32(k_cycle_get_32());
+};
+
+#ifdef DS7505_INSTRUMENT
+/* ret is passed through */
+static int ds7505_record(struct ds7505_t *ds7505, enum eOp op, uint32_t start_us, int ret)
+{
+	uint32_t us = ds7505_now_us() - start_us;
+	uint32_t limit = DS7505_INSTR_BUCKET0_US;
+	uint8_t bucket = 0;
+	struct ds7505_op_stats_t *stats = &ds7505->instr.op[op];
+	unsigned int key;
+
+	while (bucket < DS7505_INSTR_BUCKETS - 1 && us >= limit) {
+		bucket++;
+		limit <<= 1;
+	}
+
+	key = irq_lock();
+	stats->count++;
+	stats->total_us += us;
+	if (us > stats->max_us) {
+		stats->max_us = us;
+	}
+	stats->latency[bucket]++;
+	if (ret != 0) {
+		stats->errors++;
+		if (ret == -ETIMEDOUT || ret == -EAGAIN) {
+			stats->timeouts++;
+		} else if (ret == -EIO || ret == -ENXIO) {
+			stats->nacks++;
 		}
 	}
+	irq_unlock(key);
+	return ret;
+};
+#endif
+
+/* every blocking transfer goes through these, timed with DS7505_INSTRUMENT */
+static int ds7505_i2c_write(struct ds7505_t *ds7505, enum eOp op, const uint8_t *data,
+			    uint32_t len)
+{
+#ifdef DS7505_INSTRUMENT
+	uint32_t start = ds7505_now_us();
+
+	return ds7505_record(ds7505, op, start, i2c_write(ds7505->dev, data, len, ds7505->addr));
+#else
+	ARG_UNUSED(op);
+	return i2c_write(ds7505->dev, data, len, ds7505->addr);
+#endif
+};
+
+static int ds7505_i2c_read(struct ds7505_t *ds7505, uint8_t *data, uint32_t len)
+{
+#ifdef DS7505_INSTRUMENT
+	uint32_t start = ds7505_now_us();
+
+	return ds7505_record(ds7505, OP_DATA_READ, start,
+			     i2c_read(ds7505->dev, data, len, ds7505->addr));
+#else
+	return i2c_read(ds7505->dev, data, len, ds7505->addr);
+#endif
+};
+
+static int ds7505_i2c_write_read(struct ds7505_t *ds7505, const uint8_t *reg, uint8_t *data,
+				 uint32_t len)
+{
+#ifdef DS7505_INSTRUMENT
+	uint32_t start = ds7505_now_us();
+
+	return ds7505_record(ds7505, OP_DATA_READ, start,
+			     i2c_write_read(ds7505->dev, ds7505->addr, reg, 1, data, len));
+#else
+	return i2c_write_read(ds7505->dev, ds7505->addr, reg, 1, data, len);
+#endif
+};
+
+static int ds7505_i2c_transfer(struct ds7505_t *ds7505, enum eOp op, struct i2c_msg *msgs,
+			       uint8_t num_msgs)
+{
+#ifdef DS7505_INSTRUMENT
+	uint32_t start = ds7505_now_us();
+
+	return ds7505_record(ds7505, op, start,
+			     i2c_transfer(ds7505->dev, msgs, num_msgs, ds7505->addr));
+#else
+	ARG_UNUSED(op);
+	return i2c_transfer(ds7505->dev, msgs, num_msgs, ds7505->addr);
+#endif
+};
+
+/* k_mutex is recursive, a locked call can use the locked helpers */
+static void ds7505_lock(struct ds7505_t *ds7505)
+{
+	k_mutex_lock(ds7505->bus_lock, K_FOREVER);
+};
+
+static void ds7505_unlock(struct ds7505_t *ds7505)
+{
+	k_mutex_unlock(ds7505->bus_lock);
+};
+
+/* pointer write and data read go out as one transfer with a repeated start,
+ * only the read is sent when the sensor already points at reg; the lock keeps
+ * the pointer cache and the transfer together
+ */
+static int8_t ds7505_read(struct ds7505_t *ds7505, uint8_t reg, uint8_t *data, uint32_t len)
+{
+	int ret;
+
+	ds7505_lock(ds7505);
+	if (ds7505->pointer == reg) {
+		ret = ds7505_i2c_read(ds7505, data, len);
+	} else {
+		ret = ds7505_i2c_write_read(ds7505, &reg, data, len);
+	}
+	if (ret == 0) {
+		ds7505->pointer = reg;
+	} else {
+		ds7505->pointer = DS7505_POINTER_UNKNOWN;
+		ds7505->bus_error = ret;
+	}
+	ds7505_unlock(ds7505);
+	return ret == 0 ? DS7505_SUCCESS : DS7505_ERROR;
+};
+
+/* data[0] is the register address, the pointer stays there after the write */
+static int8_t ds7505_write(struct ds7505_t *ds7505, const uint8_t *data, uint32_t len)
+{
+	int ret;
+
+	ds7505_lock(ds7505);
+	ret = ds7505_i2c_write(ds7505, OP_CONFIG_WRITE, data, len);
+	ds7505->pointer = ret == 0 ? data[0] : DS7505_POINTER_UNKNOWN;
+	ds7505_unlock(ds7505);
+	return ret == 0 ? DS7505_SUCCESS : DS7505_ERROR;
+};
+
+/* commands go through the pointer byte, the pointer is unknown afterwards. SOFTWARE_POR
+ * and RECALL_DATA reload CONFIG from the EEPROM, the shadow is dropped in the same locked
+ * section so no other thread can refill it from before the command
+ */
+static int8_t ds7505_command(struct ds7505_t *ds7505, enum eCommand cmd)
+{
+	uint8_t command = (uint8_t)cmd;
+	int ret;
+
+	ds7505_lock(ds7505);
+	ds7505->pointer = DS7505_POINTER_UNKNOWN;
+	if (cmd == SOFTWARE_POR || cmd == RECALL_DATA) {
+		ds7505->config_valid = false;
+	}
+	ret = ds7505_i2c_write(ds7505, OP_COMMAND, &command, 1);
+	ds7505_unlock(ds7505);
+	return ret == 0 ? DS7505_SUCCESS : DS7505_ERROR;
+};
+
+/* writers are the reading thread and the async completion, irq_lock() keeps them apart;
+ * the release fences order the odd counter before the data and the data before the even
+ * one for a reader on another CPU, see ds7505_latest()
+ */
+static void ds7505_publish(struct ds7505_t *ds7505, int16_t raw)
+{
+	unsigned int key = irq_lock();
+
+	atomic_inc(&ds7505->seq);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	ds7505->latest.temperature_raw = raw;
+#ifndef DS7505_NO_FLOAT
+	ds7505->latest.temperature = raw / 256.0f;
+#endif
+	ds7505->latest.count++;
+	ds7505->latest.timestamp_us = ds7505_now_us();
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	atomic_inc(&ds7505->seq);
+	irq_unlock(key);
+};
+
+static void ds7505_store_temperature_reg(struct ds7505_t *ds7505, enum eReg tempReg, int16_t raw)
+{
+	if (tempReg == TEMPER) {
+		ds7505->temperature_raw = raw;
+#ifndef DS7505_NO_FLOAT
+		ds7505->temperature = raw / 256.0f;
+#endif
+		ds7505_publish(ds7505, raw);
+	} else if (tempReg == T_OS) {
+		ds7505->temp_os_raw = raw;
+#ifndef DS7505_NO_FLOAT
+		ds7505->temp_os = raw / 256.0f;
+#endif
+	} else {
+		ds7505->temp_hyst_raw = raw;
+#ifndef DS7505_NO_FLOAT
+		ds7505->temp_hyst = raw / 256.0f;
+#endif
+	}
+};
+
+static int8_t ds7505_get_temperature_reg(struct ds7505_t *ds7505, enum eReg tempReg)
+{
+	uint8_t data[DS7505_FRAME_SIZE];
+
+	if (ds7505_read(ds7505, (uint8_t)tempReg, data, sizeof(data)) == DS7505_SUCCESS) {
+		ds7505_store_temperature_reg(ds7505, tempReg, ds7505_decode_frame(data));
+		return DS7505_SUCCESS;
+	}
 	return DS7505_ERROR;
 };
 
-static int8_t ds7505_set_TOsor_HYST(struct ds7505_t *ds7505, enum eReg tOS_HYST, float temp)
+static int8_t ds7505_set_TOsor_HYST(struct ds7505_t *ds7505, enum eReg tOS_HYST, int16_t buff)
 {
 	uint8_t sendData[3];
-	int16_t buff = temp * 256;
 
-	sendData[1] = (uint8_t)tOS_HYST;
+	sendData[0] = (uint8_t)tOS_HYST;
 	sendData[1] = (buff & 0xFF00) >> 8;
 	sendData[2] = buff & 0xFF;
 
-	if (i2c_write(ds7505->dev, sendData, (uint32_t)sizeof(sendData) / sizeof(sendData[0]),
-		      ds7505->addr) == 0) {
-		if (tOS_HYST == T_OS) {
-			ds7505->temp_os = buff;
-		} else {
-			ds7505->temp_hyst = buff;
-		}
+	if (ds7505_write(ds7505, sendData, sizeof(sendData)) == DS7505_SUCCESS) {
+		ds7505_store_temperature_reg(ds7505, tOS_HYST, buff);
 		return DS7505_SUCCESS;
 	}
 	return DS7505_ERROR;
 };
 
+void ds7505_init(struct ds7505_t *ds7505, const struct device *dev, enum DS7505_addr addr)
+{
+	ds7505->dev = dev;
+	k_mutex_init(&ds7505->lock);
+	ds7505->bus_lock = &ds7505->lock;
+	ds7505->addr = addr;
+	ds7505->pointer = DS7505_POINTER_UNKNOWN;
+	ds7505->config = 0;
+	ds7505->config_valid = false;
+	ds7505->bus_error = 0;
+	ds7505->temp_hyst_raw = 0;
+	ds7505->temp_os_raw = 0;
+	ds7505->temperature_raw = 0;
+#ifndef DS7505_NO_FLOAT
+	ds7505->temp_hyst = 0;
+	ds7505->temp_os = 0;
+	ds7505->temperature = 0;
+#endif
+	atomic_set(&ds7505->seq, 0);
+	memset(&ds7505->latest, 0, sizeof(ds7505->latest));
+#ifdef DS7505_INSTRUMENT
+	memset(&ds7505->instr, 0, sizeof(ds7505->instr));
+#endif
+};
+
+void ds7505_set_bus_lock(struct ds7505_t *ds7505, struct k_mutex *lock)
+{
+	ds7505->bus_lock = lock != NULL ? lock : &ds7505->lock;
+};
+
+void ds7505_latest(const struct ds7505_t *ds7505, struct ds7505_reading_t *reading)
+{
+	atomic_val_t seq;
+
+	do {
+		seq = atomic_get(&ds7505->seq);
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		*reading = ds7505->latest;
+		/* the copy is complete before the counter is read again */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while ((seq & 1) != 0 || atomic_get(&ds7505->seq) != seq);
+};
+
+int8_t ds7505_read_frame(struct ds7505_t *ds7505, uint8_t *frame)
+{
+	return ds7505_read(ds7505, (uint8_t)TEMPER, frame, DS7505_FRAME_SIZE);
+};
+
+int16_t ds7505_decode_frame(const uint8_t *frame)
+{
+	return (int16_t)((frame[0] << 8) | frame[1]);
+};
+
+void ds7505_decode_frames(const uint8_t *frames, uint16_t count, int16_t *raw)
+{
+	for (uint16_t i = 0; i < count; i++) {
+		raw[i] = ds7505_decode_frame(&frames[i * DS7505_FRAME_SIZE]);
+	}
+};
+
+/* the shadow is stored under the lock of the read, a command cannot come in between */
 int8_t ds7505_get_config_reg(struct ds7505_t *ds7505)
 {
 	uint8_t config = 0;
-	uint8_t reg = (uint8_t)CONFIG;
-	if (i2c_write(ds7505->dev, &reg, 1, ds7505->addr) == 0) {
-		if (i2c_read(ds7505->dev, &config, 1, ds7505->addr) == 0) {
-			ds7505->config = config;
-			return DS7505_SUCCESS;
-		}
+	int8_t ret;
+
+	ds7505_lock(ds7505);
+	ret = ds7505_read(ds7505, (uint8_t)CONFIG, &config, 1);
+	if (ret == DS7505_SUCCESS) {
+		ds7505->config = config;
+		ds7505->config_valid = true;
 	}
+	ds7505_unlock(ds7505);
+	return ret;
+};
+
+int8_t ds7505_get_config_reg_cached(struct ds7505_t *ds7505)
+{
+	int8_t ret = DS7505_SUCCESS;
+
+	ds7505_lock(ds7505);
+	if (!ds7505->config_valid) {
+		ret = ds7505_get_config_reg(ds7505);
+	}
+	ds7505_unlock(ds7505);
+	return ret;
+};
+
+/* NVB is read-only, the shadow follows the written value without a read-back */
+static int8_t ds7505_set_config(struct ds7505_t *ds7505, uint8_t config)
+{
+	uint8_t data[2];
+
+	data[0] = (uint8_t)CONFIG;
+	data[1] = config & ~WRITE_IN_PROGRESS;
+	ds7505_lock(ds7505);
+	if (ds7505_write(ds7505, data, sizeof(data)) == DS7505_SUCCESS) {
+		ds7505->config = data[1];
+		ds7505->config_valid = true;
+		ds7505_unlock(ds7505);
+		return DS7505_SUCCESS;
+	}
+	ds7505->config_valid = false;
+	ds7505_unlock(ds7505);
 	return DS7505_ERROR;
 };
 
 static int8_t ds7505_shut_mode(struct ds7505_t *ds7505, enum eShutdown mode)
 {
-	if (ds7505_get_config_reg(ds7505) == DS7505_SUCCESS) {
-		uint8_t sendData[2];
-		sendData[0] = (uint8_t)CONFIG;
+	int8_t ret = DS7505_ERROR;
+
+	ds7505_lock(ds7505);
+	if (ds7505_get_config_reg_cached(ds7505) == DS7505_SUCCESS) {
 		if (mode == ACTIVE_CONVER) {
-			sendData[1] = ds7505->config & 0xFE;
+			ret = ds7505_set_config(ds7505, ds7505->config & 0xFE);
 		} else {
-			sendData[1] = ds7505->config | 0x01;
-		}
-		if (i2c_write(ds7505->dev, sendData, sizeof(sendData) / sizeof(sendData[0]),
-			      ds7505->addr) == 0) {
-			return DS7505_SUCCESS;
+			ret = ds7505_set_config(ds7505, ds7505->config | 0x01);
 		}
 	}
-	return DS7505_ERROR;
+	ds7505_unlock(ds7505);
+	return ret;
 };
 
 int8_t ds7505_get_temp(struct ds7505_t *ds7505)
@@ -84,6 +361,59 @@ int8_t ds7505_get_temp(struct ds7505_t *ds7505)
 	return ds7505_get_temperature_reg(ds7505, TEMPER);
 };
 
+/* the failed attempt is the estimate for the next one, the budget is checked before every
+ * attempt and every recovery; most drivers report a NACK and a bus fault both as -EIO, so
+ * a second failure in a row also recovers the bus, so it is usable for the next call
+ */
+int8_t ds7505_get_temp_within(struct ds7505_t *ds7505, uint32_t budget_us, uint8_t retries)
+{
+	uint32_t start = ds7505_now_us();
+	uint32_t attempt_start;
+	uint32_t attempt_us = 0;
+	uint32_t now;
+	bool bus_fault;
+	uint8_t attempt;
+	int ret;
+#ifdef DS7505_INSTRUMENT
+	unsigned int key;
+#endif
+
+	for (attempt = 0;; attempt++) {
+		attempt_start = ds7505_now_us();
+		if (attempt_start - start + attempt_us > budget_us) {
+			return DS7505_ERROR_DEADLINE;
+		}
+#ifdef DS7505_INSTRUMENT
+		if (attempt > 0) {
+			key = irq_lock();
+			ds7505->instr.op[OP_DATA_READ].retries++;
+			irq_unlock(key);
+		}
+#endif
+		if (ds7505_get_temperature_reg(ds7505, TEMPER) == DS7505_SUCCESS) {
+			return DS7505_SUCCESS;
+		}
+		now = ds7505_now_us();
+		attempt_us = now - attempt_start;
+		bus_fault = ds7505->bus_error == -ETIMEDOUT || ds7505->bus_error == -EAGAIN ||
+			    ds7505->bus_error == -EBUSY;
+		if (bus_fault || attempt > 0) {
+			if (now - start + DS7505_RECOVERY_US > budget_us) {
+				return DS7505_ERROR_DEADLINE;
+			}
+			ds7505_lock(ds7505);
+			ret = i2c_recover_bus(ds7505->dev);
+			ds7505_unlock(ds7505);
+			if (ret != 0 && ret != -ENOSYS) {
+				return DS7505_ERROR_BUS;
+			}
+		}
+		if (attempt == retries) {
+			return bus_fault ? DS7505_ERROR_BUS : DS7505_ERROR_NACK;
+		}
+	}
+};
+
 int8_t ds7505_get_temp_OS(struct ds7505_t *ds7505)
 {
 	return ds7505_get_temperature_reg(ds7505, T_OS);
@@ -98,47 +428,68 @@ int8_t ds7505_set_config_reg(struct ds7505_t *ds7505, enum eResolution resolutio
 			     enum eFault_Tolerance tolerance, enum eTermostat_Out_Polarity polarity,
 			     enum eTermostat_Mode mode)
 {
-	uint8_t data[2];
-	data[0] = (uint8_t)CONFIG;
-	data[1] = resolution | tolerance | polarity | mode;
-	if (i2c_write(ds7505->dev, data, sizeof(data) / sizeof(data[0]), ds7505->addr)) {
-		return ds7505_get_config_reg(ds7505);
+	return ds7505_set_config(ds7505, resolution | tolerance | polarity | mode);
+};
+
+/* only R1:R0 change, one CONFIG write from the shadow */
+int8_t ds7505_set_resolution(struct ds7505_t *ds7505, enum eResolution resolution)
+{
+	int8_t ret = DS7505_ERROR;
+
+	ds7505_lock(ds7505);
+	if (ds7505_get_config_reg_cached(ds7505) == DS7505_SUCCESS) {
+		ret = ds7505_set_config(ds7505, (ds7505->config & ~0x60) | (resolution & 0x60));
 	}
-	return DS7505_ERROR;
+	ds7505_unlock(ds7505);
+	return ret;
 };
 
-int8_t ds7505_set_temp_OS(struct ds7505_t *ds7505, float tempOS)
+int8_t ds7505_set_temp_OS_raw(struct ds7505_t *ds7505, int16_t tempOS)
 {
 	return ds7505_set_TOsor_HYST(ds7505, T_OS, tempOS);
 };
 
-int8_t ds7505_set_temp_HYST(struct ds7505_t *ds7505, float tempHYST)
+int8_t ds7505_set_temp_HYST_raw(struct ds7505_t *ds7505, int16_t tempHYST)
 {
 	return ds7505_set_TOsor_HYST(ds7505, T_HYST, tempHYST);
 };
 
+int8_t ds7505_set_temp_OS_centi(struct ds7505_t *ds7505, int32_t tempOS)
+{
+	return ds7505_set_TOsor_HYST(ds7505, T_OS, DS7505_CENTI_TO_RAW(tempOS));
+};
+
+int8_t ds7505_set_temp_HYST_centi(struct ds7505_t *ds7505, int32_t tempHYST)
+{
+	return ds7505_set_TOsor_HYST(ds7505, T_HYST, DS7505_CENTI_TO_RAW(tempHYST));
+};
+
+#ifndef DS7505_NO_FLOAT
+int8_t ds7505_set_temp_OS(struct ds7505_t *ds7505, float tempOS)
+{
+	return ds7505_set_TOsor_HYST(ds7505, T_OS, tempOS * 256);
+};
+
+int8_t ds7505_set_temp_HYST(struct ds7505_t *ds7505, float tempHYST)
+{
+	return ds7505_set_TOsor_HYST(ds7505, T_HYST, tempHYST * 256);
+};
+#endif
+
 int8_t ds7505_copy_SRAM_to_EPRROM(struct ds7505_t *ds7505)
 {
-	uint8_t command = (uint8_t)COPY_DATA;
-	if (i2c_write(ds7505->dev, &command, 1, ds7505->addr) == 0) {
-		return DS7505_SUCCESS;
-	}
-	return DS7505_ERROR;
+	return ds7505_command(ds7505, COPY_DATA);
 };
 
-void ds7505_software_POR(struct ds7505_t *ds7505)
+/* the sensor reloads CONFIG from the EEPROM */
+int8_t ds7505_software_POR(struct ds7505_t *ds7505)
 {
-	uint8_t command = (uint8_t)SOFTWARE_POR;
-	i2c_write(ds7505->dev, &command, 1, ds7505->addr);
+	return ds7505_command(ds7505, SOFTWARE_POR);
 };
 
 int8_t ds7505_recall_data(struct ds7505_t *ds7505)
 {
-	uint8_t command = (uint8_t)RECALL_DATA;
-	if (i2c_write(ds7505->dev, &command, 1, ds7505->addr) == 0) {
-		return DS7505_SUCCESS;
-	}
-	return DS7505_ERROR;
+	return ds7505_command(ds7505, RECALL_DATA);
 };
 
 bool ds7505_memory_busy(struct ds7505_t *ds7505)
@@ -152,6 +503,88 @@ bool ds7505_memory_busy(struct ds7505_t *ds7505)
 	return false;
 };
 
+/* T_OS and T_HYST keep 9 bits, 0.5 degC */
+#define DS7505_LIMIT_MASK ((int16_t)0xFF80)
+
+static int8_t ds7505_apply_profile_locked(struct ds7505_t *ds7505,
+					  const struct ds7505_profile_t *profile, bool commit)
+{
+	uint8_t config[2] = { CONFIG, (uint8_t)(profile->config & ~WRITE_IN_PROGRESS) };
+	uint8_t hyst[3] = { T_HYST, (profile->temp_hyst_raw & 0xFF00) >> 8,
+			    profile->temp_hyst_raw & 0xFF };
+	uint8_t os[3] = { T_OS, (profile->temp_os_raw & 0xFF00) >> 8, profile->temp_os_raw & 0xFF };
+	struct i2c_msg writes[3];
+	struct i2c_msg reads[6];
+	uint8_t read_config = 0;
+	uint8_t read_hyst[2];
+	uint8_t read_os[2];
+
+	writes[0].buf = config;
+	writes[0].len = sizeof(config);
+	writes[0].flags = I2C_MSG_WRITE;
+	writes[1].buf = hyst;
+	writes[1].len = sizeof(hyst);
+	writes[1].flags = I2C_MSG_RESTART | I2C_MSG_WRITE;
+	writes[2].buf = os;
+	writes[2].len = sizeof(os);
+	writes[2].flags = I2C_MSG_RESTART | I2C_MSG_WRITE | I2C_MSG_STOP;
+
+	ds7505->pointer = DS7505_POINTER_UNKNOWN;
+	ds7505->config_valid = false;
+	if (ds7505_i2c_transfer(ds7505, OP_CONFIG_WRITE, writes, 3) != 0) {
+		return DS7505_ERROR;
+	}
+
+	reads[0].buf = &config[0];
+	reads[0].len = 1;
+	reads[0].flags = I2C_MSG_WRITE;
+	reads[1].buf = &read_config;
+	reads[1].len = 1;
+	reads[1].flags = I2C_MSG_RESTART | I2C_MSG_READ;
+	reads[2].buf = &hyst[0];
+	reads[2].len = 1;
+	reads[2].flags = I2C_MSG_RESTART | I2C_MSG_WRITE;
+	reads[3].buf = read_hyst;
+	reads[3].len = sizeof(read_hyst);
+	reads[3].flags = I2C_MSG_RESTART | I2C_MSG_READ;
+	reads[4].buf = &os[0];
+	reads[4].len = 1;
+	reads[4].flags = I2C_MSG_RESTART | I2C_MSG_WRITE;
+	reads[5].buf = read_os;
+	reads[5].len = sizeof(read_os);
+	reads[5].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+
+	if (ds7505_i2c_transfer(ds7505, OP_DATA_READ, reads, 6) != 0) {
+		return DS7505_ERROR;
+	}
+	ds7505->pointer = T_OS;
+	ds7505->config = read_config;
+	ds7505->config_valid = true;
+	ds7505_store_temperature_reg(ds7505, T_HYST, ds7505_decode_frame(read_hyst));
+	ds7505_store_temperature_reg(ds7505, T_OS, ds7505_decode_frame(read_os));
+
+	if ((read_config & ~WRITE_IN_PROGRESS) != config[1] ||
+	    ds7505->temp_hyst_raw != (profile->temp_hyst_raw & DS7505_LIMIT_MASK) ||
+	    ds7505->temp_os_raw != (profile->temp_os_raw & DS7505_LIMIT_MASK)) {
+		return DS7505_ERROR;
+	}
+	if (commit) {
+		return ds7505_copy_SRAM_to_EPRROM(ds7505);
+	}
+	return DS7505_SUCCESS;
+};
+
+int8_t ds7505_apply_profile(struct ds7505_t *ds7505, const struct ds7505_profile_t *profile,
+			    bool commit)
+{
+	int8_t ret;
+
+	ds7505_lock(ds7505);
+	ret = ds7505_apply_profile_locked(ds7505, profile, commit);
+	ds7505_unlock(ds7505);
+	return ret;
+};
+
 int8_t ds7505_shutdown(struct ds7505_t *ds7505)
 {
 	return ds7505_shut_mode(ds7505, SHUTDOWN);
@@ -160,4 +593,142 @@ int8_t ds7505_shutdown(struct ds7505_t *ds7505)
 int8_t ds7505_wake_up(struct ds7505_t *ds7505)
 {
 	return ds7505_shut_mode(ds7505, ACTIVE_CONVER);
-};
\ No newline at end of file
+};
+
+/* SD is set again right after the wake: the conversion that started runs to the end
+ * and the sensor stops after it, continuous mode would start a second one before the read
+ */
+int8_t ds7505_get_temp_one_shot(struct ds7505_t *ds7505)
+{
+	if (ds7505_wake_up(ds7505) != DS7505_SUCCESS || ds7505_shutdown(ds7505) != DS7505_SUCCESS) {
+		return DS7505_ERROR;
+	}
+	k_msleep(ds7505_conversion_time_ms(ds7505->config));
+	return ds7505_get_temp(ds7505);
+};
+
+uint16_t ds7505_conversion_time_ms(uint8_t config)
+{
+	return 25 << ((config & BITS_12) >> 5);
+};
+
+#ifdef DS7505_INSTRUMENT
+void ds7505_instr_snapshot(const struct ds7505_t *ds7505, struct ds7505_instr_t *snapshot)
+{
+	unsigned int key = irq_lock();
+
+	*snapshot = ds7505->instr;
+	irq_unlock(key);
+};
+
+void ds7505_instr_reset(struct ds7505_t *ds7505)
+{
+	unsigned int key = irq_lock();
+
+	memset(&ds7505->instr, 0, sizeof(ds7505->instr));
+	irq_unlock(key);
+};
+#endif
+
+static void ds7505_async_done(const struct device *dev, int result, void *data)
+{
+	struct ds7505_async_t *req = data;
+	struct ds7505_t *ds7505 = req->ds7505;
+	int8_t status = DS7505_ERROR;
+
+#ifdef DS7505_INSTRUMENT
+	ds7505_record(ds7505, OP_DATA_READ, req->start_us, result);
+#endif
+	if (result == 0) {
+		int16_t buf = (req->data[0] << 8) | req->data[1];
+		ds7505_store_temperature_reg(ds7505, TEMPER, buf);
+		status = DS7505_SUCCESS;
+	}
+	req->busy = false;
+	if (req->cb != NULL) {
+#ifdef DS7505_NO_FLOAT
+		req->cb(ds7505, status, ds7505->temperature_raw, req->user_data);
+#else
+		req->cb(ds7505, status, ds7505->temperature, req->user_data);
+#endif
+	}
+};
+
+/* with the bus lock held: same pointer cache as the blocking reads, no pointer write
+ * when already at TEMPER. The cache is unknown until the transfer is done, a blocking
+ * read in between writes the pointer again and the completion does not touch it
+ */
+static void ds7505_async_prepare(struct ds7505_async_t *req)
+{
+	struct ds7505_t *ds7505 = req->ds7505;
+
+	req->num_msgs = 0;
+	if (ds7505->pointer != req->reg) {
+		req->msgs[req->num_msgs].buf = &req->reg;
+		req->msgs[req->num_msgs].len = 1;
+		req->msgs[req->num_msgs].flags = I2C_MSG_WRITE;
+		req->num_msgs++;
+	}
+	req->msgs[req->num_msgs].buf = req->data;
+	req->msgs[req->num_msgs].len = sizeof(req->data);
+	req->msgs[req->num_msgs].flags = I2C_MSG_RESTART | I2C_MSG_READ | I2C_MSG_STOP;
+	req->num_msgs++;
+	ds7505->pointer = DS7505_POINTER_UNKNOWN;
+#ifdef DS7505_INSTRUMENT
+	req->start_us = ds7505_now_us();
+#endif
+};
+
+#ifndef CONFIG_I2C_CALLBACK
+static void ds7505_async_work(struct k_work *work)
+{
+	struct ds7505_async_t *req = CONTAINER_OF(work, struct ds7505_async_t, work);
+	int ret;
+
+	ds7505_lock(req->ds7505);
+	ds7505_async_prepare(req);
+	ret = i2c_transfer(req->ds7505->dev, req->msgs, req->num_msgs, req->ds7505->addr);
+	if (ret == 0) {
+		req->ds7505->pointer = req->reg;
+	}
+	ds7505_unlock(req->ds7505);
+	ds7505_async_done(req->ds7505->dev, ret, req);
+};
+#endif
+
+int8_t ds7505_get_temp_async(struct ds7505_t *ds7505, struct ds7505_async_t *req,
+			     ds7505_read_cb_t cb, void *user_data)
+{
+	if (req->busy) {
+		return DS7505_ERROR;
+	}
+	req->busy = true;
+	req->ds7505 = ds7505;
+	req->cb = cb;
+	req->user_data = user_data;
+	req->reg = (uint8_t)TEMPER;
+
+#ifdef CONFIG_I2C_CALLBACK
+	/* queued with the driver under the lock, so it goes out before any transfer
+	 * that sees the pointer cache after the unlock
+	 */
+	ds7505_lock(ds7505);
+	ds7505_async_prepare(req);
+	if (i2c_transfer_cb(ds7505->dev, req->msgs, req->num_msgs, ds7505->addr,
+			    ds7505_async_done, req) != 0) {
+		ds7505_unlock(ds7505);
+		req->busy = false;
+		return DS7505_ERROR;
+	}
+	ds7505_unlock(ds7505);
+#else
+	k_work_init(&req->work, ds7505_async_work);
+	k_work_submit(&req->work);
+#endif
+	return DS7505_SUCCESS;
+};
+
+bool ds7505_async_busy(struct ds7505_async_t *req)
+{
+	return req->busy;
+};
@@ -5,6 +5,7 @@
 #include <sys/printk.h>
 #include <device.h>
 #include <drivers/i2c.h>
+#include <sys/atomic.h>
 
 #define PREFIX_ADDR 0x09
 #define POSIT_PREFIX_ADDR 3
@@ -15,6 +16,59 @@
 
 #define DS7505_SUCCESS 0
 #define DS7505_ERROR -1
+/* only returned by ds7505_get_temp_within() */
+#define DS7505_ERROR_NACK -2 /* -EIO, -ENXIO on the last attempt */
+#define DS7505_ERROR_BUS -3 /* -ETIMEDOUT, -EAGAIN, -EBUSY or i2c_recover_bus() failed */
+#define DS7505_ERROR_DEADLINE -4 /* the next attempt or recovery would not fit the budget */
+
+/* attempts after the first one in ds7505_get_temp_within() */
+#define DS7505_RETRIES 2
+/* what ds7505_get_temp_within() reserves for i2c_recover_bus(), nine SCL clocks and a
+ * STOP at 100 kHz
+ */
+#define DS7505_RECOVERY_US 150
+
+#define DS7505_POINTER_UNKNOWN 0xFF
+
+/* TEMPER register as sent by the sensor, MSB first */
+#define DS7505_FRAME_SIZE 2
+
+/* register value <-> centi-degrees, 1/256 degC per LSB, integer only */
+#define DS7505_RAW_TO_CENTI(raw) (((int32_t)(raw)*100) / 256)
+#define DS7505_CENTI_TO_RAW(centi) ((int16_t)(((int32_t)(centi)*256) / 100))
+
+/* bus operations counted with DS7505_INSTRUMENT; a pointer write that goes out
+ * with the read in one transfer is counted as OP_DATA_READ
+ */
+enum eOp {
+	OP_POINTER_WRITE = 0,
+	OP_DATA_READ = 1,
+	OP_CONFIG_WRITE = 2, /* CONFIG, T_HYST and T_OS */
+	OP_COMMAND = 3
+};
+
+#ifdef DS7505_INSTRUMENT
+#define DS7505_INSTR_OPS 4
+/* latency buckets: < 64 us, < 128 us, ... < 4096 us, >= 4096 us */
+#define DS7505_INSTR_BUCKETS 8
+#define DS7505_INSTR_BUCKET0_US 64
+
+struct ds7505_op_stats_t {
+	uint32_t count; /* transfers, failed ones included */
+	uint32_t errors; /* all failures, NACKs and timeouts included */
+	uint32_t nacks; /* -EIO, -ENXIO */
+	uint32_t timeouts; /* -ETIMEDOUT, -EAGAIN */
+	uint32_t retries;
+	uint32_t total_us;
+	uint32_t max_us;
+	uint32_t latency[DS7505_INSTR_BUCKETS];
+};
+
+/* per sensor, indexed by enum eOp */
+struct ds7505_instr_t {
+	struct ds7505_op_stats_t op[DS7505_INSTR_OPS];
+};
+#endif
 
 enum DS7505_addr {
 	ADDR_48 = BUILD_PREFIX_ADDR | 0x0,
@@ -56,33 +110,162 @@ enum eShutdown { ACTIVE_CONVER = 0x00, SHUTDOWN = 0x01 };
 
 enum eCommand { RECALL_DATA = 0xB8, COPY_DATA = 0x48, SOFTWARE_POR = 0x54 };
 
+/* latest TEMPER reading of a sensor, see ds7505_latest() */
+struct ds7505_reading_t {
+	int16_t temperature_raw; /* 1/256 degC per LSB */
+#ifndef DS7505_NO_FLOAT
+	float temperature;
+#endif
+	uint32_t count; /* readings published so far, 0 before the first one */
+	uint32_t timestamp_us; /* k_cycle_get_32() in us when it was published */
+};
+
 struct ds7505_t {
 	const struct device *dev;
+	struct k_mutex lock; /* own lock, used until ds7505_set_bus_lock() */
+	struct k_mutex *bus_lock; /* lock or the one shared by all sensors on dev */
 	enum DS7505_addr addr;
-	uint8_t config;
+	uint8_t pointer; /* last value written to the pointer register */
+	uint8_t config; /* shadow of CONFIG, NVB is only valid right after ds7505_get_config_reg() */
+	bool config_valid; /* false until read or written, after SOFTWARE_POR and RECALL_DATA */
+	int bus_error; /* negative errno of the last failed read */
+	int16_t temp_hyst_raw; /* register values, 1/256 degC per LSB */
+	int16_t temp_os_raw;
+	int16_t temperature_raw;
+#ifndef DS7505_NO_FLOAT
 	float temp_hyst;
 	float temp_os;
 	float temperature;
+#endif
+	atomic_t seq; /* odd while latest is written */
+	struct ds7505_reading_t latest;
+#ifdef DS7505_INSTRUMENT
+	struct ds7505_instr_t instr;
+#endif
+};
+
+/* complete desired state for ds7505_apply_profile() */
+struct ds7505_profile_t {
+	uint8_t config; /* resolution | tolerance | polarity | mode */
+	int16_t temp_hyst_raw; /* 1/256 degC per LSB, the sensor keeps 0.5 degC */
+	int16_t temp_os_raw;
 };
 
+void ds7505_init(struct ds7505_t *ds7505, const struct device *dev, enum DS7505_addr addr);
+
+/* Every sensor is locked by its own k_mutex after ds7505_init(), which keeps the pointer
+ * cache and the shadow consistent for a single sensor used from several threads (the
+ * struct must not be copied after that). Sensors on one bus share one k_mutex instead: it
+ * is held for the transfers of one call (pointer write and read, read-modify-write of
+ * CONFIG, profile and verify, bus recovery), never while a conversion runs; NULL goes
+ * back to the own lock. The I2C_CALLBACK path of ds7505_get_temp_async() holds it only
+ * while the transfer is queued, the driver orders its transfers itself.
+ */
+void ds7505_set_bus_lock(struct ds7505_t *ds7505, struct k_mutex *lock);
+/* Every TEMPER read is published with a sequence counter; any thread copies the latest
+ * reading without a lock and without holding up the reads, it retries while a new one
+ * is written.
+ */
+void ds7505_latest(const struct ds7505_t *ds7505, struct ds7505_reading_t *reading);
+
 int8_t ds7505_get_config_reg(struct ds7505_t *ds7505);
+/* reads CONFIG only when the shadow is not valid */
+int8_t ds7505_get_config_reg_cached(struct ds7505_t *ds7505);
 int8_t ds7505_set_config_reg(struct ds7505_t *ds7505, enum eResolution resolution,
 			     enum eFault_Tolerance tolerance, enum eTermostat_Out_Polarity polarity,
 			     enum eTermostat_Mode mode);
+/* only R1:R0 change, one CONFIG write from the shadow (read first when not valid) */
+int8_t ds7505_set_resolution(struct ds7505_t *ds7505, enum eResolution resolution);
 
 int8_t ds7505_get_temp(struct ds7505_t *ds7505);
+/* ds7505_get_temp() retried for at most retries more attempts while another one fits in
+ * budget_us; i2c_recover_bus() after a bus error and from the second failure on, when it
+ * fits too. The first attempt is bounded by the transfer timeout of the I2C driver only,
+ * not by budget_us
+ */
+int8_t ds7505_get_temp_within(struct ds7505_t *ds7505, uint32_t budget_us, uint8_t retries);
+
+/* Split read: the bus transfer stores the raw frame in the caller's buffer and
+ * leaves ds7505 untouched, the conversion to register values is done later,
+ * frames of many reads can be decoded in one pass.
+ */
+int8_t ds7505_read_frame(struct ds7505_t *ds7505, uint8_t *frame);
+int16_t ds7505_decode_frame(const uint8_t *frame);
+void ds7505_decode_frames(const uint8_t *frames, uint16_t count, int16_t *raw);
 int8_t ds7505_get_temp_OS(struct ds7505_t *ds7505);
 int8_t ds7505_get_temp_HYST(struct ds7505_t *ds7505);
 
+/* integer setters, no float code is pulled in with DS7505_NO_FLOAT */
+int8_t ds7505_set_temp_OS_raw(struct ds7505_t *ds7505, int16_t tempOS);
+int8_t ds7505_set_temp_HYST_raw(struct ds7505_t *ds7505, int16_t tempHYST);
+int8_t ds7505_set_temp_OS_centi(struct ds7505_t *ds7505, int32_t tempOS);
+int8_t ds7505_set_temp_HYST_centi(struct ds7505_t *ds7505, int32_t tempHYST);
+#ifndef DS7505_NO_FLOAT
 int8_t ds7505_set_temp_OS(struct ds7505_t *ds7505, float tempOS);
 int8_t ds7505_set_temp_HYST(struct ds7505_t *ds7505, float tempHYST);
+#endif
 
 int8_t ds7505_copy_SRAM_to_EPRROM(struct ds7505_t *ds7505);
-void ds7505_software_POR(struct ds7505_t *ds7505);
+int8_t ds7505_software_POR(struct ds7505_t *ds7505);
 int8_t ds7505_recall_data(struct ds7505_t *ds7505);
 bool ds7505_memory_busy(struct ds7505_t *ds7505);
+/* CONFIG, T_HYST and T_OS in one i2c_transfer(), verified with a second one,
+ * then COPY_DATA when commit is set and everything matched
+ */
+int8_t ds7505_apply_profile(struct ds7505_t *ds7505, const struct ds7505_profile_t *profile,
+			    bool commit);
 
 int8_t ds7505_shutdown(struct ds7505_t *ds7505);
 int8_t ds7505_wake_up(struct ds7505_t *ds7505);
+/* one conversion for a sensor kept in SHUTDOWN: wake and shut down at once (the started
+ * conversion still completes), k_msleep() the conversion time of the cached resolution,
+ * read TEMPER. Two CONFIG writes and one read, CONFIG is only read when the shadow is
+ * not valid;
+ * ds7505_oneshot.c does the same from the work queue
+ */
+int8_t ds7505_get_temp_one_shot(struct ds7505_t *ds7505);
+
+/* 25/50/100/200 ms for the R1:R0 bits of config */
+uint16_t ds7505_conversion_time_ms(uint8_t config);
+
+#ifdef DS7505_INSTRUMENT
+/* copy of the counters, consistent against the async completion */
+void ds7505_instr_snapshot(const struct ds7505_t *ds7505, struct ds7505_instr_t *snapshot);
+void ds7505_instr_reset(struct ds7505_t *ds7505);
+#endif
+
+#ifdef DS7505_NO_FLOAT
+typedef void (*ds7505_read_cb_t)(struct ds7505_t *ds7505, int8_t status, int16_t temperature,
+				 void *user_data);
+#else
+typedef void (*ds7505_read_cb_t)(struct ds7505_t *ds7505, int8_t status, float temperature,
+				 void *user_data);
+#endif
+
+/* state of one asynchronous read, owned by the caller and valid until the callback ran */
+struct ds7505_async_t {
+	struct ds7505_t *ds7505;
+	struct i2c_msg msgs[2];
+	uint8_t num_msgs;
+	uint8_t reg;
+	uint8_t data[2];
+	ds7505_read_cb_t cb;
+	void *user_data;
+	volatile bool busy;
+#ifdef DS7505_INSTRUMENT
+	uint32_t start_us;
+#endif
+#ifndef CONFIG_I2C_CALLBACK
+	struct k_work work;
+#endif
+};
+
+/* With CONFIG_I2C_CALLBACK the transfer is started with i2c_transfer_cb() and the
+ * callback runs from the I2C driver (usually its ISR). Without it the blocking
+ * transfer runs on the system work queue and the callback runs there.
+ */
+int8_t ds7505_get_temp_async(struct ds7505_t *ds7505, struct ds7505_async_t *req,
+			     ds7505_read_cb_t cb, void *user_data);
+bool ds7505_async_busy(struct ds7505_async_t *req);
 
 #endif //_DS7505_H_
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include <stdlib.h>
+#include "ds7505_adaptive.h"
+
+static bool ds7505_adaptive_near(const struct ds7505_adaptive_t *adaptive, int16_t raw)
+{
+	return abs(raw - adaptive->ds7505->temp_os_raw) <= adaptive->near_raw ||
+	       abs(raw - adaptive->ds7505->temp_hyst_raw) <= adaptive->near_raw;
+};
+
+/* the sensor starts a new conversion at the new resolution, the scheduler waits for it */
+static int8_t ds7505_adaptive_change(struct ds7505_adaptive_t *adaptive,
+				     enum eResolution resolution, uint32_t now_ms)
+{
+	if (ds7505_set_resolution(adaptive->ds7505, resolution) != DS7505_SUCCESS) {
+		return DS7505_ERROR;
+	}
+	ds7505_sched_restart_sensor(adaptive->sched, adaptive->index, now_ms);
+	adaptive->quiet = 0;
+	adaptive->switches++;
+	return DS7505_SUCCESS;
+};
+
+void ds7505_adaptive_init(struct ds7505_adaptive_t *adaptive, struct ds7505_sched_t *sched,
+			  uint8_t index, enum eResolution coarse, enum eResolution fine)
+{
+	adaptive->ds7505 = sched->sensors[index];
+	adaptive->sched = sched;
+	adaptive->index = index;
+	adaptive->coarse = coarse;
+	adaptive->fine = fine;
+	adaptive->near_raw = DS7505_ADAPTIVE_NEAR_RAW;
+	adaptive->change_raw = DS7505_ADAPTIVE_CHANGE_RAW;
+	adaptive->window_ms = DS7505_ADAPTIVE_WINDOW_MS;
+	adaptive->stable = DS7505_ADAPTIVE_STABLE;
+	adaptive->quiet = 0;
+	adaptive->started = false;
+	adaptive->ref_raw = 0;
+	adaptive->ref_ms = 0;
+	adaptive->switches = 0;
+};
+
+/* the change is measured against the first sample of a window, so a fast move is
+ * seen within one window and slow drift never adds up across windows
+ */
+int8_t ds7505_adaptive_update(struct ds7505_adaptive_t *adaptive, uint32_t now_ms)
+{
+	int16_t raw = adaptive->ds7505->temperature_raw;
+	bool moved = adaptive->started && abs(raw - adaptive->ref_raw) > adaptive->change_raw;
+
+	if (!adaptive->started || moved ||
+	    (uint32_t)(now_ms - adaptive->ref_ms) >= adaptive->window_ms) {
+		adaptive->started = true;
+		adaptive->ref_raw = raw;
+		adaptive->ref_ms = now_ms;
+	}
+	if (moved || ds7505_adaptive_near(adaptive, raw)) {
+		adaptive->quiet = 0;
+		if (ds7505_adaptive_fine(adaptive)) {
+			return DS7505_SUCCESS;
+		}
+		return ds7505_adaptive_change(adaptive, adaptive->fine, now_ms);
+	}
+	if (ds7505_adaptive_fine(adaptive) && ++adaptive->quiet >= adaptive->stable) {
+		return ds7505_adaptive_change(adaptive, adaptive->coarse, now_ms);
+	}
+	return DS7505_SUCCESS;
+};
+
+bool ds7505_adaptive_fine(const struct ds7505_adaptive_t *adaptive)
+{
+	return (adaptive->ds7505->config & 0x60) == adaptive->fine;
+};
@@ -0,0 +1,46 @@
+#ifndef _DS7505_ADAPTIVE_H
+#define _DS7505_ADAPTIVE_H
+
+#include "ds7505.h"
+#include "ds7505_sched.h"
+
+#define DS7505_ADAPTIVE_NEAR_RAW (2 * 256) /* 2 degC from T_OS or T_HYST */
+/* more than one 9-bit step (0.5 degC) within the window, a value flickering
+ * between two steps is not a change
+ */
+#define DS7505_ADAPTIVE_CHANGE_RAW 192
+#define DS7505_ADAPTIVE_WINDOW_MS 1000
+#define DS7505_ADAPTIVE_STABLE 8
+
+/* Adaptive resolution for one sensor of a ds7505_sched_t. Call ds7505_adaptive_update()
+ * after every new sample: quiet and far from T_OS/T_HYST the sensor runs at the coarse
+ * resolution (9 bits, 25 ms), when it moves faster than change_raw per window or comes
+ * within near_raw of a threshold it switches to the fine one (12 bits, 200 ms) at once,
+ * and back after stable quiet samples. A switch is one CONFIG write (R1:R0 only) and
+ * restarts the sensor in the scheduler. The thresholds come from the temp_os_raw and
+ * temp_hyst_raw shadows, read or set them first.
+ */
+struct ds7505_adaptive_t {
+	struct ds7505_t *ds7505;
+	struct ds7505_sched_t *sched;
+	uint8_t index;
+	enum eResolution coarse;
+	enum eResolution fine;
+	int16_t near_raw;
+	int16_t change_raw;
+	uint16_t window_ms;
+	uint8_t stable;
+	uint8_t quiet;
+	bool started;
+	int16_t ref_raw; /* first sample of the current window */
+	uint32_t ref_ms;
+	uint32_t switches;
+};
+
+void ds7505_adaptive_init(struct ds7505_adaptive_t *adaptive, struct ds7505_sched_t *sched,
+			  uint8_t index, enum eResolution coarse, enum eResolution fine);
+/* DS7505_ERROR when a switch failed, it is tried again with the next sample */
+int8_t ds7505_adaptive_update(struct ds7505_adaptive_t *adaptive, uint32_t now_ms);
+bool ds7505_adaptive_fine(const struct ds7505_adaptive_t *adaptive);
+
+#endif //_DS7505_ADAPTIVE_H_
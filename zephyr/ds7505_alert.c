@@ -0,0 +1,75 @@
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include <drivers/gpio.h>
+#include "ds7505_alert.h"
+
+static void ds7505_alert_isr(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+	struct ds7505_alert_t *alert = CONTAINER_OF(cb, struct ds7505_alert_t, gpio_cb);
+
+	k_work_submit(&alert->work);
+};
+
+/* reading the temperature also clears O.S. in interrupt mode */
+static void ds7505_alert_work(struct k_work *work)
+{
+	struct ds7505_alert_t *alert = CONTAINER_OF(work, struct ds7505_alert_t, work);
+	int8_t status = ds7505_get_temp(alert->ds7505);
+
+	if (alert->cb != NULL) {
+		alert->cb(alert->ds7505, status, alert->user_data);
+	}
+};
+
+int8_t ds7505_alert_attach(struct ds7505_alert_t *alert, struct ds7505_t *ds7505,
+			   const struct gpio_dt_spec *os, enum eTermostat_Out_Polarity polarity,
+			   ds7505_alert_cb_t cb, void *user_data)
+{
+	int ret;
+
+	alert->ds7505 = ds7505;
+	alert->os = *os;
+	alert->cb = cb;
+	alert->user_data = user_data;
+	k_work_init(&alert->work, ds7505_alert_work);
+
+	ret = gpio_pin_configure_dt(&alert->os, GPIO_INPUT);
+	if (ret != 0) {
+		printk("Error %d: failed to configure %s pin %d\n", ret, alert->os.port->name,
+		       alert->os.pin);
+		return DS7505_ERROR;
+	}
+	gpio_init_callback(&alert->gpio_cb, ds7505_alert_isr, BIT(alert->os.pin));
+	ret = gpio_add_callback(alert->os.port, &alert->gpio_cb);
+	if (ret != 0) {
+		printk("Error %d: failed to add calback on %s pin %d\n", ret, alert->os.port->name,
+		       alert->os.pin);
+		return DS7505_ERROR;
+	}
+	ret = gpio_pin_interrupt_configure_dt(&alert->os, GPIO_INT_EDGE_TO_ACTIVE);
+	if (ret != 0) {
+		printk("Error %d: failed to configure interrupt on %s pin %d\n", ret,
+		       alert->os.port->name, alert->os.pin);
+		gpio_remove_callback(alert->os.port, &alert->gpio_cb);
+		return DS7505_ERROR;
+	}
+
+	if (ds7505_get_config_reg_cached(ds7505) == DS7505_SUCCESS) {
+		uint8_t config = ds7505->config;
+		return ds7505_set_config_reg(ds7505, config & BITS_12,
+					     config & OUT_OF_LIMITS_TRIG_6, polarity, INTERRUPT);
+	}
+	return DS7505_ERROR;
+};
+
+int8_t ds7505_alert_detach(struct ds7505_alert_t *alert)
+{
+	gpio_pin_interrupt_configure_dt(&alert->os, GPIO_INT_DISABLE);
+	if (gpio_remove_callback(alert->os.port, &alert->gpio_cb) != 0) {
+		return DS7505_ERROR;
+	}
+	k_work_cancel(&alert->work);
+	return DS7505_SUCCESS;
+};
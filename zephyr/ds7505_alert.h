@@ -0,0 +1,31 @@
+#ifndef _DS7505_ALERT_H
+#define _DS7505_ALERT_H
+
+#include <drivers/gpio.h>
+#include "ds7505.h"
+
+typedef void (*ds7505_alert_cb_t)(struct ds7505_t *ds7505, int8_t status, void *user_data);
+
+/* O.S. alert of one sensor. Every instance has its own GPIO callback and work item,
+ * the GPIO ISR only submits the work item, the temperature is read on the system
+ * work queue and then handed to cb. Must stay valid while attached.
+ */
+struct ds7505_alert_t {
+	struct ds7505_t *ds7505;
+	struct gpio_dt_spec os;
+	struct gpio_callback gpio_cb;
+	struct k_work work;
+	ds7505_alert_cb_t cb;
+	void *user_data;
+};
+
+/* The O.S. pin flags in the devicetree must match polarity (GPIO_ACTIVE_LOW for
+ * ACTIVE_LOW), the interrupt fires on the edge to the active level. The sensor is
+ * switched to interrupt mode, resolution and fault tolerance are kept.
+ */
+int8_t ds7505_alert_attach(struct ds7505_alert_t *alert, struct ds7505_t *ds7505,
+			   const struct gpio_dt_spec *os, enum eTermostat_Out_Polarity polarity,
+			   ds7505_alert_cb_t cb, void *user_data);
+int8_t ds7505_alert_detach(struct ds7505_alert_t *alert);
+
+#endif //_DS7505_ALERT_H_
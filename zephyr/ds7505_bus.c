@@ -0,0 +1,137 @@
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include "ds7505_bus.h"
+
+void ds7505_bus_init(struct ds7505_bus_t *bus, const struct device *dev)
+{
+	bus->dev = dev;
+	k_mutex_init(&bus->lock);
+	bus->count = 0;
+};
+
+/* index in order[] of addr, or where it goes to keep the address order */
+static uint8_t ds7505_bus_position(struct ds7505_bus_t *bus, enum DS7505_addr addr)
+{
+	uint8_t pos = 0;
+
+	while (pos < bus->count && bus->sensors[bus->order[pos]].addr < addr) {
+		pos++;
+	}
+	return pos;
+};
+
+/* takes sensors[count], which the caller has set up */
+static void ds7505_bus_insert(struct ds7505_bus_t *bus, uint8_t pos)
+{
+	for (uint8_t i = bus->count; i > pos; i--) {
+		bus->order[i] = bus->order[i - 1];
+	}
+	bus->order[pos] = bus->count;
+	bus->count++;
+};
+
+/* appended to sensors[], only order[] is shifted to keep the address order */
+int8_t ds7505_bus_add(struct ds7505_bus_t *bus, enum DS7505_addr addr)
+{
+	uint8_t pos;
+
+	if (addr < ADDR_48 || addr > ADDR_4F) {
+		return DS7505_ERROR;
+	}
+	pos = ds7505_bus_position(bus, addr);
+	if (pos < bus->count && bus->sensors[bus->order[pos]].addr == addr) {
+		return DS7505_SUCCESS;
+	}
+	if (bus->count == DS7505_BUS_MAX_SENSORS) {
+		return DS7505_ERROR;
+	}
+	ds7505_init(&bus->sensors[bus->count], bus->dev, addr);
+	ds7505_set_bus_lock(&bus->sensors[bus->count], &bus->lock);
+	ds7505_bus_insert(bus, pos);
+	return DS7505_SUCCESS;
+};
+
+/* adds every address that answers a CONFIG read, returns the number of sensors.
+ * Every address is probed through the sensor that keeps it, so the pointer
+ * cache follows the CONFIG read and a new sensor starts with a valid config
+ * shadow; the free slot sensors[count] is only taken when the probe answers.
+ */
+uint8_t ds7505_bus_scan(struct ds7505_bus_t *bus)
+{
+	struct ds7505_t *probe;
+	uint8_t pos;
+
+	for (uint8_t addr = ADDR_48; addr <= ADDR_4F; addr++) {
+		pos = ds7505_bus_position(bus, (enum DS7505_addr)addr);
+		if (pos < bus->count && bus->sensors[bus->order[pos]].addr == addr) {
+			ds7505_get_config_reg(&bus->sensors[bus->order[pos]]);
+			continue;
+		}
+		if (bus->count == DS7505_BUS_MAX_SENSORS) {
+			continue;
+		}
+		probe = &bus->sensors[bus->count];
+		ds7505_init(probe, bus->dev, (enum DS7505_addr)addr);
+		ds7505_set_bus_lock(probe, &bus->lock);
+		if (ds7505_get_config_reg(probe) == DS7505_SUCCESS) {
+			ds7505_bus_insert(bus, pos);
+		}
+	}
+	return bus->count;
+};
+
+/* the i-th sensor in address order, NULL past the end */
+struct ds7505_t *ds7505_bus_sensor(struct ds7505_bus_t *bus, uint8_t i)
+{
+	if (i >= bus->count) {
+		return NULL;
+	}
+	return &bus->sensors[bus->order[i]];
+};
+
+/* one polling cycle in address order, samples must have room for bus->count
+ * entries, a sensor that NACKs gets DS7505_ERROR and the cycle moves on.
+ * The bus is held for the whole cycle so the reads go out back to back.
+ * Returns the number of sensors that answered.
+ */
+uint8_t ds7505_bus_poll(struct ds7505_bus_t *bus, struct ds7505_sample_t *samples)
+{
+	uint8_t ok = 0;
+
+	k_mutex_lock(&bus->lock, K_FOREVER);
+	for (uint8_t i = 0; i < bus->count; i++) {
+		struct ds7505_t *sensor = &bus->sensors[bus->order[i]];
+
+		samples[i].addr = sensor->addr;
+		samples[i].status = ds7505_get_temp(sensor);
+		samples[i].temperature_raw = sensor->temperature_raw;
+#ifndef DS7505_NO_FLOAT
+		samples[i].temperature = sensor->temperature;
+#endif
+		if (samples[i].status == DS7505_SUCCESS) {
+			ok++;
+		}
+	}
+	k_mutex_unlock(&bus->lock);
+	return ok;
+};
+
+/* the polling cycle without conversion, frames gets DS7505_FRAME_SIZE bytes and
+ * status one entry per sensor, decode with ds7505_decode_frames(). The frame of a
+ * sensor that NACKs is left as it was. Returns the number of sensors that answered.
+ */
+uint8_t ds7505_bus_read_frames(struct ds7505_bus_t *bus, uint8_t *frames, int8_t *status)
+{
+	uint8_t ok = 0;
+
+	k_mutex_lock(&bus->lock, K_FOREVER);
+	for (uint8_t i = 0; i < bus->count; i++) {
+		status[i] = ds7505_read_frame(&bus->sensors[bus->order[i]], &frames[i * DS7505_FRAME_SIZE]);
+		if (status[i] == DS7505_SUCCESS) {
+			ok++;
+		}
+	}
+	k_mutex_unlock(&bus->lock);
+	return ok;
+};
@@ -0,0 +1,36 @@
+#ifndef _DS7505_BUS_H
+#define _DS7505_BUS_H
+
+#include "ds7505.h"
+
+#define DS7505_BUS_MAX_SENSORS 8
+
+struct ds7505_sample_t {
+	enum DS7505_addr addr;
+	int8_t status;
+	int16_t temperature_raw;
+#ifndef DS7505_NO_FLOAT
+	float temperature;
+#endif
+};
+
+/* all sensors on one I2C bus. sensors[] is in the order they were added and an
+ * entry never moves, so a pointer from ds7505_bus_sensor() stays valid; order[]
+ * holds the indexes in address order, which the polling cycles follow
+ */
+struct ds7505_bus_t {
+	const struct device *dev;
+	struct k_mutex lock; /* bus lock of all sensors, see ds7505_set_bus_lock() */
+	struct ds7505_t sensors[DS7505_BUS_MAX_SENSORS];
+	uint8_t order[DS7505_BUS_MAX_SENSORS];
+	uint8_t count;
+};
+
+void ds7505_bus_init(struct ds7505_bus_t *bus, const struct device *dev);
+int8_t ds7505_bus_add(struct ds7505_bus_t *bus, enum DS7505_addr addr);
+uint8_t ds7505_bus_scan(struct ds7505_bus_t *bus);
+struct ds7505_t *ds7505_bus_sensor(struct ds7505_bus_t *bus, uint8_t i);
+uint8_t ds7505_bus_poll(struct ds7505_bus_t *bus, struct ds7505_sample_t *samples);
+uint8_t ds7505_bus_read_frames(struct ds7505_bus_t *bus, uint8_t *frames, int8_t *status);
+
+#endif //_DS7505_BUS_H_
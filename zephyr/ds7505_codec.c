@@ -0,0 +1,237 @@
+#include <zephyr.h>
+#include "ds7505_codec.h"
+
+/* MSB first, a byte is cleared when the first bit goes into it */
+static void ds7505_encoder_write_bits(struct ds7505_encoder_t *encoder, uint32_t value,
+				      uint8_t count)
+{
+	uint32_t byte;
+	uint8_t used;
+	uint8_t room;
+	uint8_t n;
+
+	while (count > 0) {
+		byte = encoder->bit_pos >> 3;
+		used = encoder->bit_pos & 0x07;
+		room = 8 - used;
+		n = count < room ? count : room;
+		if (used == 0) {
+			encoder->buffer[byte] = 0;
+		}
+		encoder->buffer[byte] |= ((value >> (count - n)) & ((1 << n) - 1)) << (room - n);
+		encoder->bit_pos += n;
+		count -= n;
+	}
+};
+
+void ds7505_encoder_init(struct ds7505_encoder_t *encoder, uint8_t *buffer, uint16_t size,
+			 uint8_t keyframe_interval)
+{
+	encoder->buffer = buffer;
+	encoder->size = size;
+	encoder->interval = keyframe_interval ? keyframe_interval : 1;
+	ds7505_encoder_reset(encoder);
+};
+
+int8_t ds7505_encoder_push(struct ds7505_encoder_t *encoder, int16_t raw, uint8_t resolution_bits)
+{
+	uint8_t shift;
+	int16_t value;
+	int16_t change;
+	int16_t masked;
+	uint32_t start;
+	uint32_t zigzag;
+	uint8_t length = 0;
+	uint8_t bits = 1;
+
+	if (resolution_bits < 9 || resolution_bits > 12) {
+		return DS7505_ERROR;
+	}
+	shift = 16 - resolution_bits;
+	value = raw >> shift;
+
+	/* keyframe: new block at the next byte */
+	if (encoder->header == encoder->size ||
+	    encoder->buffer[encoder->header + 4] == encoder->interval || shift != encoder->shift) {
+		start = (encoder->bit_pos + 7) / 8;
+		if (start + DS7505_CODEC_HEADER_SIZE > encoder->size) {
+			return DS7505_ERROR;
+		}
+		masked = value * (1 << shift);
+		encoder->buffer[start] = DS7505_CODEC_MAGIC;
+		encoder->buffer[start + 1] = resolution_bits;
+		encoder->buffer[start + 2] = (uint16_t)masked >> 8;
+		encoder->buffer[start + 3] = masked & 0xFF;
+		encoder->buffer[start + 4] = 1;
+		encoder->header = start;
+		encoder->bit_pos = (start + DS7505_CODEC_HEADER_SIZE) * 8;
+		encoder->shift = shift;
+		encoder->last = value;
+		encoder->samples++;
+		return DS7505_SUCCESS;
+	}
+
+	change = value - encoder->last;
+	zigzag = ((uint32_t)change << 1) ^ (uint32_t)(change >> 15);
+	if (change == 1 || change == -1) {
+		bits = 3;
+	} else if (change != 0) {
+		while ((zigzag >> length) != 0) {
+			length++;
+		}
+		bits = 6 + length;
+	}
+	if ((encoder->bit_pos + bits + 7) / 8 > encoder->size) {
+		return DS7505_ERROR;
+	}
+
+	if (change == 0) {
+		ds7505_encoder_write_bits(encoder, 0, 1);
+	} else if (bits == 3) {
+		ds7505_encoder_write_bits(encoder, change > 0 ? 0x04 : 0x05, 3);
+	} else {
+		ds7505_encoder_write_bits(encoder, 0x30 | length, 6);
+		ds7505_encoder_write_bits(encoder, zigzag, length);
+	}
+	encoder->buffer[encoder->header + 4]++;
+	encoder->last = value;
+	encoder->samples++;
+	return DS7505_SUCCESS;
+};
+
+int8_t ds7505_encoder_push_sensor(struct ds7505_encoder_t *encoder, const struct ds7505_t *ds7505)
+{
+	return ds7505_encoder_push(encoder, ds7505->temperature_raw,
+				   9 + ((ds7505->config & BITS_12) >> 5));
+};
+
+/* the rest of the buffer reads like erased flash, the decoder stops there */
+uint16_t ds7505_encoder_flush(struct ds7505_encoder_t *encoder)
+{
+	uint16_t used = ds7505_encoder_size(encoder);
+	uint16_t i;
+
+	for (i = used; i < encoder->size; i++) {
+		encoder->buffer[i] = DS7505_CODEC_ERASED;
+	}
+	encoder->header = encoder->size;
+	return used;
+};
+
+void ds7505_encoder_reset(struct ds7505_encoder_t *encoder)
+{
+	encoder->header = encoder->size;
+	encoder->bit_pos = 0;
+	encoder->shift = 0;
+	encoder->last = 0;
+	encoder->samples = 0;
+};
+
+uint16_t ds7505_encoder_size(const struct ds7505_encoder_t *encoder)
+{
+	return (encoder->bit_pos + 7) / 8;
+};
+
+static uint32_t ds7505_decoder_read_bits(struct ds7505_decoder_t *decoder, uint8_t count)
+{
+	uint32_t value = 0;
+	uint8_t used;
+	uint8_t room;
+	uint8_t n;
+
+	if (decoder->bit_pos + count > (uint32_t)decoder->size * 8) {
+		decoder->error = true;
+		return 0;
+	}
+	while (count > 0) {
+		used = decoder->bit_pos & 0x07;
+		room = 8 - used;
+		n = count < room ? count : room;
+		value = (value << n) |
+			((decoder->data[decoder->bit_pos >> 3] >> (room - n)) & ((1 << n) - 1));
+		decoder->bit_pos += n;
+		count -= n;
+	}
+	return value;
+};
+
+static bool ds7505_decoder_read_header(struct ds7505_decoder_t *decoder, int16_t *raw)
+{
+	const uint8_t *header = &decoder->data[decoder->bit_pos / 8];
+
+	if (header[0] != DS7505_CODEC_MAGIC || header[1] < 9 || header[1] > 12 || header[4] == 0) {
+		return false;
+	}
+	decoder->shift = 16 - header[1];
+	*raw = (int16_t)((header[2] << 8) | header[3]);
+	decoder->last = *raw >> decoder->shift;
+	decoder->left = header[4] - 1;
+	decoder->bit_pos += DS7505_CODEC_HEADER_SIZE * 8;
+	return true;
+};
+
+void ds7505_decoder_init(struct ds7505_decoder_t *decoder, const uint8_t *data, uint16_t size)
+{
+	decoder->data = data;
+	decoder->size = size;
+	decoder->bit_pos = 0;
+	decoder->left = 0;
+	decoder->shift = 0;
+	decoder->last = 0;
+	decoder->error = false;
+};
+
+uint16_t ds7505_decoder_decode(struct ds7505_decoder_t *decoder, int16_t *raw, uint16_t max)
+{
+	uint16_t n = 0;
+	int16_t change;
+	int16_t value;
+	uint32_t zigzag;
+	uint8_t i;
+
+	while (n < max && !decoder->error) {
+		if (decoder->left == 0) {
+			decoder->bit_pos = (decoder->bit_pos + 7) & ~0x07UL;
+			if (decoder->bit_pos / 8 + DS7505_CODEC_HEADER_SIZE > decoder->size ||
+			    decoder->data[decoder->bit_pos / 8] == DS7505_CODEC_ERASED) {
+				break;
+			}
+			if (!ds7505_decoder_read_header(decoder, &raw[n])) {
+				decoder->error = true;
+				break;
+			}
+			n++;
+			continue;
+		}
+
+		/* a zero byte is eight unchanged samples */
+		if ((decoder->bit_pos & 0x07) == 0 && decoder->left >= 8 && max - n >= 8 &&
+		    decoder->bit_pos / 8 < decoder->size && decoder->data[decoder->bit_pos / 8] == 0) {
+			value = decoder->last * (1 << decoder->shift);
+			for (i = 0; i < 8; i++) {
+				raw[n++] = value;
+			}
+			decoder->bit_pos += 8;
+			decoder->left -= 8;
+			continue;
+		}
+
+		change = 0;
+		if (ds7505_decoder_read_bits(decoder, 1) != 0) {
+			if (ds7505_decoder_read_bits(decoder, 1) == 0) {
+				change = ds7505_decoder_read_bits(decoder, 1) ? -1 : 1;
+			} else {
+				zigzag = ds7505_decoder_read_bits(decoder,
+								  ds7505_decoder_read_bits(decoder, 4));
+				change = (int16_t)((zigzag >> 1) ^ (0 - (zigzag & 1)));
+			}
+		}
+		if (decoder->error) {
+			break;
+		}
+		decoder->last += change;
+		decoder->left--;
+		raw[n++] = decoder->last * (1 << decoder->shift);
+	}
+	return n;
+};
@@ -0,0 +1,63 @@
+#ifndef _DS7505_CODEC_H
+#define _DS7505_CODEC_H
+
+#include "ds7505.h"
+
+/* Compact log format for the raw samples of one sensor. Every block starts
+ * with a byte-aligned keyframe, followed by the changes between samples as a
+ * bit stream at the sensor resolution (1/16 degC steps at 12 bits, 0.5 degC at 9):
+ *   block:  0xD5 | resolution bits (9..12) | raw MSB | raw LSB | samples in block
+ *   change: 0            same value
+ *           10s          +1 (s = 0) or -1 (s = 1) step
+ *           11 LLLL x..x zigzag of the change in L bits
+ * A slowly changing temperature costs 1..3 bits per sample instead of a 4-byte
+ * float. The encoder writes into a caller buffer and keeps the sample count in
+ * the header up to date, so the buffer decodes at any time. When push fails
+ * the buffer is full, flush pads the rest with 0xFF (erased flash, where the
+ * decoder stops), write it out and reset. A new keyframe starts every
+ * keyframe_interval samples and when the resolution changes.
+ */
+#define DS7505_CODEC_MAGIC 0xD5
+#define DS7505_CODEC_ERASED 0xFF
+#define DS7505_CODEC_HEADER_SIZE 5
+/* largest change: 11, 4-bit length, 15 bits of zigzag */
+#define DS7505_CODEC_MAX_BITS 21
+
+struct ds7505_encoder_t {
+	uint8_t *buffer;
+	uint16_t size;
+	uint8_t interval;
+	uint16_t header; /* offset of the open block, size when none */
+	uint32_t bit_pos;
+	uint8_t shift;
+	int16_t last; /* last value >> shift */
+	uint32_t samples;
+};
+
+struct ds7505_decoder_t {
+	const uint8_t *data;
+	uint16_t size;
+	uint32_t bit_pos;
+	uint8_t left; /* samples left in the current block */
+	uint8_t shift;
+	int16_t last;
+	bool error; /* a corrupt block stopped the decoder */
+};
+
+void ds7505_encoder_init(struct ds7505_encoder_t *encoder, uint8_t *buffer, uint16_t size,
+			 uint8_t keyframe_interval);
+/* DS7505_ERROR when the sample does not fit any more */
+int8_t ds7505_encoder_push(struct ds7505_encoder_t *encoder, int16_t raw, uint8_t resolution_bits);
+int8_t ds7505_encoder_push_sensor(struct ds7505_encoder_t *encoder, const struct ds7505_t *ds7505);
+/* bytes used, the rest is padded, the next push starts a new block */
+uint16_t ds7505_encoder_flush(struct ds7505_encoder_t *encoder);
+void ds7505_encoder_reset(struct ds7505_encoder_t *encoder);
+uint16_t ds7505_encoder_size(const struct ds7505_encoder_t *encoder);
+
+void ds7505_decoder_init(struct ds7505_decoder_t *decoder, const uint8_t *data, uint16_t size);
+/* decodes up to max samples (1/256 degC per LSB), can be called again for the rest;
+ * stops at the end of the data or at a corrupt block
+ */
+uint16_t ds7505_decoder_decode(struct ds7505_decoder_t *decoder, int16_t *raw, uint16_t max);
+
+#endif //_DS7505_CODEC_H_
@@ -0,0 +1,85 @@
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include "ds7505_eeprom.h"
+
+static void ds7505_eeprom_finish(struct ds7505_eeprom_t *op, int8_t status)
+{
+	op->busy = false;
+	if (op->cb != NULL) {
+		op->cb(op->ds7505, status, op->user_data);
+	}
+};
+
+static void ds7505_eeprom_schedule(struct ds7505_eeprom_t *op, uint16_t delay_ms)
+{
+	op->waited_ms += delay_ms;
+	k_work_schedule(&op->work, K_MSEC(delay_ms));
+};
+
+/* one CONFIG read per check, NVB stays set while the EEPROM is written */
+static void ds7505_eeprom_check(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ds7505_eeprom_t *op = CONTAINER_OF(dwork, struct ds7505_eeprom_t, work);
+
+	if (ds7505_get_config_reg(op->ds7505) != DS7505_SUCCESS) {
+		ds7505_eeprom_finish(op, DS7505_ERROR);
+	} else if ((op->ds7505->config & WRITE_IN_PROGRESS) == 0) {
+		ds7505_eeprom_finish(op, DS7505_SUCCESS);
+	} else if (op->waited_ms >= DS7505_EEPROM_TIMEOUT_MS) {
+		ds7505_eeprom_finish(op, DS7505_ERROR);
+	} else {
+		ds7505_eeprom_schedule(op, op->delay_ms);
+		if (op->delay_ms < DS7505_EEPROM_MAX_POLL_MS) {
+			op->delay_ms *= 2;
+		}
+	}
+};
+
+static int8_t ds7505_eeprom_start(struct ds7505_eeprom_t *op, int8_t status,
+				  uint16_t first_check_ms, ds7505_eeprom_cb_t cb, void *user_data)
+{
+	if (status != DS7505_SUCCESS) {
+		op->busy = false;
+		return DS7505_ERROR;
+	}
+	op->cb = cb;
+	op->user_data = user_data;
+	op->waited_ms = 0;
+	op->delay_ms = 1;
+	ds7505_eeprom_schedule(op, first_check_ms);
+	return DS7505_SUCCESS;
+};
+
+void ds7505_eeprom_init(struct ds7505_eeprom_t *op, struct ds7505_t *ds7505)
+{
+	op->ds7505 = ds7505;
+	op->busy = false;
+	k_work_init_delayable(&op->work, ds7505_eeprom_check);
+};
+
+int8_t ds7505_eeprom_commit(struct ds7505_eeprom_t *op, ds7505_eeprom_cb_t cb, void *user_data)
+{
+	if (op->busy) {
+		return DS7505_ERROR;
+	}
+	op->busy = true;
+	return ds7505_eeprom_start(op, ds7505_copy_SRAM_to_EPRROM(op->ds7505),
+				   DS7505_EEPROM_WRITE_MS, cb, user_data);
+};
+
+int8_t ds7505_eeprom_recall(struct ds7505_eeprom_t *op, ds7505_eeprom_cb_t cb, void *user_data)
+{
+	if (op->busy) {
+		return DS7505_ERROR;
+	}
+	op->busy = true;
+	return ds7505_eeprom_start(op, ds7505_recall_data(op->ds7505), DS7505_EEPROM_RECALL_MS,
+				   cb, user_data);
+};
+
+bool ds7505_eeprom_busy(struct ds7505_eeprom_t *op)
+{
+	return op->busy;
+};
@@ -0,0 +1,34 @@
+#ifndef _DS7505_EEPROM_H
+#define _DS7505_EEPROM_H
+
+#include "ds7505.h"
+
+#define DS7505_EEPROM_WRITE_MS 10 /* typical tWR, first NVB check after COPY_DATA */
+#define DS7505_EEPROM_RECALL_MS 1
+#define DS7505_EEPROM_MAX_POLL_MS 8 /* the check interval doubles up to this */
+#define DS7505_EEPROM_TIMEOUT_MS 100
+
+typedef void (*ds7505_eeprom_cb_t)(struct ds7505_t *ds7505, int8_t status, void *user_data);
+
+/* Non-blocking COPY_DATA / RECALL_DATA of one sensor. The command is sent at once,
+ * NVB is checked from the system work queue, first after the typical EEPROM write
+ * time and then with a growing interval, the bus is free for other sensors in
+ * between. cb runs on the work queue when NVB is clear or the timeout passed.
+ * Must stay valid until cb ran.
+ */
+struct ds7505_eeprom_t {
+	struct ds7505_t *ds7505;
+	struct k_work_delayable work;
+	ds7505_eeprom_cb_t cb;
+	void *user_data;
+	uint16_t waited_ms;
+	uint16_t delay_ms;
+	volatile bool busy;
+};
+
+void ds7505_eeprom_init(struct ds7505_eeprom_t *op, struct ds7505_t *ds7505);
+int8_t ds7505_eeprom_commit(struct ds7505_eeprom_t *op, ds7505_eeprom_cb_t cb, void *user_data);
+int8_t ds7505_eeprom_recall(struct ds7505_eeprom_t *op, ds7505_eeprom_cb_t cb, void *user_data);
+bool ds7505_eeprom_busy(struct ds7505_eeprom_t *op);
+
+#endif //_DS7505_EEPROM_H_
@@ -0,0 +1,44 @@
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include "ds7505_oneshot.h"
+
+static void ds7505_oneshot_read(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct ds7505_oneshot_t *op = CONTAINER_OF(dwork, struct ds7505_oneshot_t, work);
+	int8_t status = ds7505_get_temp(op->ds7505);
+
+	op->busy = false;
+	if (op->cb != NULL) {
+		op->cb(op->ds7505, status, op->user_data);
+	}
+};
+
+void ds7505_oneshot_init(struct ds7505_oneshot_t *op, struct ds7505_t *ds7505)
+{
+	op->ds7505 = ds7505;
+	op->busy = false;
+	k_work_init_delayable(&op->work, ds7505_oneshot_read);
+};
+
+int8_t ds7505_oneshot_start(struct ds7505_oneshot_t *op, ds7505_oneshot_cb_t cb, void *user_data)
+{
+	if (op->busy) {
+		return DS7505_ERROR;
+	}
+	if (ds7505_wake_up(op->ds7505) != DS7505_SUCCESS ||
+	    ds7505_shutdown(op->ds7505) != DS7505_SUCCESS) {
+		return DS7505_ERROR;
+	}
+	op->busy = true;
+	op->cb = cb;
+	op->user_data = user_data;
+	k_work_schedule(&op->work, K_MSEC(ds7505_conversion_time_ms(op->ds7505->config)));
+	return DS7505_SUCCESS;
+};
+
+bool ds7505_oneshot_busy(struct ds7505_oneshot_t *op)
+{
+	return op->busy;
+};
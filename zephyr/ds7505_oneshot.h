@@ -0,0 +1,26 @@
+#ifndef _DS7505_ONESHOT_H
+#define _DS7505_ONESHOT_H
+
+#include "ds7505.h"
+
+typedef void (*ds7505_oneshot_cb_t)(struct ds7505_t *ds7505, int8_t status, void *user_data);
+
+/* One-shot reads from the system work queue for a sensor kept in SHUTDOWN. Start
+ * wakes the sensor and shuts it down again at once (two CONFIG writes, the conversion
+ * that started still completes), the work reads TEMPER after the conversion time of
+ * the cached resolution, then cb runs on the work queue. Nothing runs during the conversion, the MCU can sleep.
+ * Must stay valid until cb ran.
+ */
+struct ds7505_oneshot_t {
+	struct ds7505_t *ds7505;
+	struct k_work_delayable work;
+	ds7505_oneshot_cb_t cb;
+	void *user_data;
+	volatile bool busy;
+};
+
+void ds7505_oneshot_init(struct ds7505_oneshot_t *op, struct ds7505_t *ds7505);
+int8_t ds7505_oneshot_start(struct ds7505_oneshot_t *op, ds7505_oneshot_cb_t cb, void *user_data);
+bool ds7505_oneshot_busy(struct ds7505_oneshot_t *op);
+
+#endif //_DS7505_ONESHOT_H_
@@ -0,0 +1,55 @@
+#include <zephyr.h>
+#include <sys/atomic.h>
+#include "ds7505_ring.h"
+
+void ds7505_ring_init(struct ds7505_ring_t *ring)
+{
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+	atomic_set(&ring->dropped, 0);
+};
+
+/* producer side, false when full (the sample is dropped and counted) */
+bool ds7505_ring_push(struct ds7505_ring_t *ring, const struct ds7505_record_t *record)
+{
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+
+	if (head - (uint32_t)atomic_get(&ring->tail) == DS7505_RING_SIZE) {
+		atomic_inc(&ring->dropped);
+		return false;
+	}
+	ring->buffer[head & (DS7505_RING_SIZE - 1)] = *record;
+	atomic_set(&ring->head, (atomic_val_t)(head + 1));
+	return true;
+};
+
+bool ds7505_ring_push_sensor(struct ds7505_ring_t *ring, const struct ds7505_t *ds7505,
+			     uint32_t timestamp)
+{
+	struct ds7505_record_t record;
+
+	record.timestamp = timestamp;
+	record.addr = ds7505->addr;
+	record.temperature_raw = ds7505->temperature_raw;
+	return ds7505_ring_push(ring, &record);
+};
+
+/* consumer side, copies up to max records, returns how many */
+uint16_t ds7505_ring_pop(struct ds7505_ring_t *ring, struct ds7505_record_t *records,
+			 uint16_t max)
+{
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+	uint32_t available = (uint32_t)atomic_get(&ring->head) - tail;
+	uint16_t n = available < max ? available : max;
+
+	for (uint16_t i = 0; i < n; i++) {
+		records[i] = ring->buffer[(tail + i) & (DS7505_RING_SIZE - 1)];
+	}
+	atomic_set(&ring->tail, (atomic_val_t)(tail + n));
+	return n;
+};
+
+uint16_t ds7505_ring_size(struct ds7505_ring_t *ring)
+{
+	return (uint32_t)atomic_get(&ring->head) - (uint32_t)atomic_get(&ring->tail);
+};
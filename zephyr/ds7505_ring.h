@@ -0,0 +1,41 @@
+#ifndef _DS7505_RING_H
+#define _DS7505_RING_H
+
+#include <sys/atomic.h>
+#include "ds7505.h"
+
+/* must be a power of two */
+#ifndef DS7505_RING_SIZE
+#define DS7505_RING_SIZE 32
+#endif
+
+BUILD_ASSERT((DS7505_RING_SIZE & (DS7505_RING_SIZE - 1)) == 0,
+	     "DS7505_RING_SIZE must be a power of two");
+
+struct ds7505_record_t {
+	uint32_t timestamp; /* ms */
+	enum DS7505_addr addr;
+	int16_t temperature_raw;
+};
+
+/* Single-producer/single-consumer ring of timestamped samples. The acquisition
+ * thread or a work item deferred from an ISR pushes, one consumer thread drains
+ * in batches, neither side takes a lock. The indices run freely and are masked
+ * on access.
+ */
+struct ds7505_ring_t {
+	struct ds7505_record_t buffer[DS7505_RING_SIZE];
+	atomic_t head; /* written by the producer only */
+	atomic_t tail; /* written by the consumer only */
+	atomic_t dropped;
+};
+
+void ds7505_ring_init(struct ds7505_ring_t *ring);
+bool ds7505_ring_push(struct ds7505_ring_t *ring, const struct ds7505_record_t *record);
+bool ds7505_ring_push_sensor(struct ds7505_ring_t *ring, const struct ds7505_t *ds7505,
+			     uint32_t timestamp);
+uint16_t ds7505_ring_pop(struct ds7505_ring_t *ring, struct ds7505_record_t *records,
+			 uint16_t max);
+uint16_t ds7505_ring_size(struct ds7505_ring_t *ring);
+
+#endif //_DS7505_RING_H_
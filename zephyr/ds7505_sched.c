@@ -0,0 +1,128 @@
+#include <zephyr.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include "ds7505_sched.h"
+
+/* without a valid shadow the sensor may be converting, the run finds out */
+static bool ds7505_sched_converting(struct ds7505_sched_t *sched, uint8_t index)
+{
+	return !sched->sensors[index]->config_valid || (sched->sensors[index]->config & SHUTDOWN) == 0;
+};
+
+void ds7505_sched_init(struct ds7505_sched_t *sched, uint32_t bus_frequency)
+{
+	sched->count = 0;
+	sched->bus_frequency = bus_frequency;
+};
+
+/* the conversion time and SD come from the config shadow, CONFIG is read first when
+ * the shadow is not valid; a sensor that does not answer is due at once
+ */
+int8_t ds7505_sched_add(struct ds7505_sched_t *sched, struct ds7505_t *ds7505)
+{
+	if (sched->count == DS7505_SCHED_MAX_SENSORS) {
+		return DS7505_ERROR;
+	}
+	sched->sensors[sched->count] = ds7505;
+	sched->due[sched->count] = 0;
+	sched->count++;
+	ds7505_get_config_reg_cached(ds7505);
+	return DS7505_SUCCESS;
+};
+
+/* the sensors start a new conversion, first result after one conversion time */
+void ds7505_sched_restart(struct ds7505_sched_t *sched, uint32_t now_ms)
+{
+	for (uint8_t i = 0; i < sched->count; i++) {
+		ds7505_sched_restart_sensor(sched, i, now_ms);
+	}
+};
+
+/* CONFIG is read again when ds7505_software_POR()/ds7505_recall_data() dropped the
+ * shadow; a sensor that does not answer is due at once and the next run reads it
+ */
+void ds7505_sched_restart_sensor(struct ds7505_sched_t *sched, uint8_t index, uint32_t now_ms)
+{
+	if (index >= sched->count) {
+		return;
+	}
+	sched->due[index] = now_ms;
+	if (ds7505_get_config_reg_cached(sched->sensors[index]) == DS7505_SUCCESS) {
+		sched->due[index] += ds7505_conversion_time_ms(sched->sensors[index]->config);
+	}
+};
+
+/* reads every sensor with a conversion finished since its last read, returns
+ * a bit mask of the sensors (by index) that got a new sample. A sensor without a
+ * valid shadow (it did not answer when added, ds7505_software_POR()) reads CONFIG
+ * first; when that fails too it is tried again after the longest conversion
+ */
+uint8_t ds7505_sched_run(struct ds7505_sched_t *sched, uint32_t now_ms)
+{
+	uint8_t fresh = 0;
+
+	for (uint8_t i = 0; i < sched->count; i++) {
+		struct ds7505_t *sensor = sched->sensors[i];
+
+		if (!ds7505_sched_converting(sched, i) || (int32_t)(now_ms - sched->due[i]) < 0) {
+			continue;
+		}
+		if (ds7505_get_config_reg_cached(sensor) != DS7505_SUCCESS) {
+			sched->due[i] = now_ms + ds7505_conversion_time_ms(BITS_12);
+			continue;
+		}
+		if (!ds7505_sched_converting(sched, i)) {
+			continue;
+		}
+		/* one conversion time after a read at least one new conversion has finished */
+		sched->due[i] = now_ms + ds7505_conversion_time_ms(sensor->config);
+		if (ds7505_get_temp(sensor) == DS7505_SUCCESS) {
+			fresh |= BIT(i);
+		}
+	}
+	return fresh;
+};
+
+/* time until the next sensor is due, DS7505_SCHED_IDLE when all are shut down */
+uint32_t ds7505_sched_next_due_ms(struct ds7505_sched_t *sched, uint32_t now_ms)
+{
+	uint32_t next = DS7505_SCHED_IDLE;
+
+	for (uint8_t i = 0; i < sched->count; i++) {
+		int32_t left;
+
+		if (!ds7505_sched_converting(sched, i)) {
+			continue;
+		}
+		left = (int32_t)(sched->due[i] - now_ms);
+		if (left <= 0) {
+			return 0;
+		}
+		if ((uint32_t)left < next) {
+			next = left;
+		}
+	}
+	return next;
+};
+
+/* 0 for a sensor in shutdown or without a valid shadow */
+uint32_t ds7505_sched_sample_rate_milli_hz(struct ds7505_sched_t *sched, uint8_t index)
+{
+	if (index >= sched->count || !sched->sensors[index]->config_valid ||
+	    !ds7505_sched_converting(sched, index)) {
+		return 0;
+	}
+	return 1000000 / ds7505_conversion_time_ms(sched->sensors[index]->config);
+};
+
+/* sum of the sensor rates, limited by the number of reads the bus can carry */
+uint32_t ds7505_sched_bus_sample_rate_milli_hz(struct ds7505_sched_t *sched)
+{
+	uint32_t total = 0;
+	uint32_t bus_limit = (sched->bus_frequency / DS7505_SCHED_READ_BITS) * 1000;
+
+	for (uint8_t i = 0; i < sched->count; i++) {
+		total += ds7505_sched_sample_rate_milli_hz(sched, i);
+	}
+	return total < bus_limit ? total : bus_limit;
+};
@@ -0,0 +1,35 @@
+#ifndef _DS7505_SCHED_H
+#define _DS7505_SCHED_H
+
+#include "ds7505.h"
+
+#define DS7505_SCHED_MAX_SENSORS 8
+/* one temperature read with the pointer already at TEMPER:
+ * START, address + ACK, two data bytes + ACK/NACK, STOP
+ */
+#define DS7505_SCHED_READ_BITS 29
+#define DS7505_SCHED_IDLE 0xFFFFFFFF
+
+/* Reads each sensor only when a new conversion is ready, the conversion time comes
+ * from the cached config of every sensor; adding and restarting a sensor read CONFIG
+ * when the shadow is not valid, a sensor that did not answer is retried every 200 ms.
+ * Call ds7505_sched_restart() after a config write or wake up.
+ */
+struct ds7505_sched_t {
+	struct ds7505_t *sensors[DS7505_SCHED_MAX_SENSORS];
+	uint32_t due[DS7505_SCHED_MAX_SENSORS];
+	uint8_t count;
+	uint32_t bus_frequency;
+};
+
+void ds7505_sched_init(struct ds7505_sched_t *sched, uint32_t bus_frequency);
+int8_t ds7505_sched_add(struct ds7505_sched_t *sched, struct ds7505_t *ds7505);
+void ds7505_sched_restart(struct ds7505_sched_t *sched, uint32_t now_ms);
+void ds7505_sched_restart_sensor(struct ds7505_sched_t *sched, uint8_t index, uint32_t now_ms);
+uint8_t ds7505_sched_run(struct ds7505_sched_t *sched, uint32_t now_ms);
+uint32_t ds7505_sched_next_due_ms(struct ds7505_sched_t *sched, uint32_t now_ms);
+/* rates in mHz (samples per 1000 s), 0 for a sensor in shutdown */
+uint32_t ds7505_sched_sample_rate_milli_hz(struct ds7505_sched_t *sched, uint8_t index);
+uint32_t ds7505_sched_bus_sample_rate_milli_hz(struct ds7505_sched_t *sched);
+
+#endif //_DS7505_SCHED_H_
@@ -0,0 +1,308 @@
+/* Zephyr sensor driver on top of ds7505.c, one device per "maxim,ds7505" node:
+ *
+ *	&i2c1 {
+ *		ds7505@48 {
+ *			compatible = "maxim,ds7505";
+ *			reg = <0x48>;
+ *			resolution = <12>;
+ *			os-gpios = <&gpioc 2 (GPIO_ACTIVE_LOW | GPIO_PULL_UP)>;
+ *		};
+ *	};
+ */
+#define DT_DRV_COMPAT maxim_ds7505
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <device.h>
+#include <drivers/i2c.h>
+#include <drivers/gpio.h>
+#include <drivers/sensor.h>
+#include "ds7505.h"
+#include "ds7505_alert.h"
+#include "ds7505_sensor.h"
+#ifdef CONFIG_SENSOR_ASYNC_API
+#include <drivers/sensor_data_types.h>
+#include <rtio/rtio.h>
+#endif
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+
+struct ds7505_sensor_config {
+	struct i2c_dt_spec i2c;
+	uint8_t resolution; /* CONFIG R1:R0 */
+	struct gpio_dt_spec os;
+};
+
+struct ds7505_sensor_data {
+	struct ds7505_t ds7505;
+	struct ds7505_alert_t alert;
+	const struct device *dev;
+	sensor_trigger_handler_t handler;
+	const struct sensor_trigger *trigger;
+};
+
+/* 1/256 degC per LSB, 1000000 / 256 = 15625 / 4 */
+static void ds7505_sensor_from_raw(int16_t raw, struct sensor_value *val)
+{
+	val->val1 = raw / 256;
+	val->val2 = ((raw % 256) * 15625) / 4;
+};
+
+static int32_t ds7505_sensor_to_centi(const struct sensor_value *val)
+{
+	return val->val1 * 100 + val->val2 / 10000;
+};
+
+static int ds7505_sensor_sample_fetch(const struct device *dev, enum sensor_channel chan)
+{
+	struct ds7505_sensor_data *data = dev->data;
+
+	if (chan != SENSOR_CHAN_ALL && chan != SENSOR_CHAN_AMBIENT_TEMP) {
+		return -ENOTSUP;
+	}
+	return ds7505_get_temp(&data->ds7505) == DS7505_SUCCESS ? 0 : -EIO;
+};
+
+static int ds7505_sensor_channel_get(const struct device *dev, enum sensor_channel chan,
+				     struct sensor_value *val)
+{
+	struct ds7505_sensor_data *data = dev->data;
+
+	if (chan != SENSOR_CHAN_AMBIENT_TEMP) {
+		return -ENOTSUP;
+	}
+	ds7505_sensor_from_raw(data->ds7505.temperature_raw, val);
+	return 0;
+};
+
+static int ds7505_sensor_attr_set(const struct device *dev, enum sensor_channel chan,
+				  enum sensor_attribute attr, const struct sensor_value *val)
+{
+	struct ds7505_sensor_data *data = dev->data;
+	struct ds7505_t *ds7505 = &data->ds7505;
+	int8_t status;
+
+	if (chan != SENSOR_CHAN_AMBIENT_TEMP && chan != SENSOR_CHAN_ALL) {
+		return -ENOTSUP;
+	}
+
+	switch ((int)attr) {
+	case SENSOR_ATTR_UPPER_THRESH:
+		status = ds7505_set_temp_OS_centi(ds7505, ds7505_sensor_to_centi(val));
+		break;
+	case SENSOR_ATTR_LOWER_THRESH:
+	case SENSOR_ATTR_HYSTERESIS:
+		status = ds7505_set_temp_HYST_centi(ds7505, ds7505_sensor_to_centi(val));
+		break;
+	case SENSOR_ATTR_DS7505_RESOLUTION:
+		if (val->val1 < 9 || val->val1 > 12) {
+			return -EINVAL;
+		}
+		status = ds7505_get_config_reg_cached(ds7505);
+		if (status == DS7505_SUCCESS) {
+			uint8_t config = ds7505->config;
+
+			status = ds7505_set_config_reg(ds7505, (val->val1 - 9) << 5,
+						       config & OUT_OF_LIMITS_TRIG_6,
+						       config & ACTIVE_HIGH, config & INTERRUPT);
+		}
+		break;
+	default:
+		return -ENOTSUP;
+	}
+	return status == DS7505_SUCCESS ? 0 : -EIO;
+};
+
+static void ds7505_sensor_alert(struct ds7505_t *ds7505, int8_t status, void *user_data)
+{
+	struct ds7505_sensor_data *data = user_data;
+
+	if (data->handler != NULL) {
+		data->handler(data->dev, data->trigger);
+	}
+};
+
+static int ds7505_sensor_trigger_set(const struct device *dev,
+				     const struct sensor_trigger *trig,
+				     sensor_trigger_handler_t handler)
+{
+	const struct ds7505_sensor_config *cfg = dev->config;
+	struct ds7505_sensor_data *data = dev->data;
+	enum eTermostat_Out_Polarity polarity;
+
+	if (cfg->os.port == NULL || trig->type != SENSOR_TRIG_THRESHOLD ||
+	    (trig->chan != SENSOR_CHAN_AMBIENT_TEMP && trig->chan != SENSOR_CHAN_ALL)) {
+		return -ENOTSUP;
+	}
+
+	if (data->handler != NULL) {
+		ds7505_alert_detach(&data->alert);
+		data->handler = NULL;
+	}
+	if (handler == NULL) {
+		return 0;
+	}
+
+	data->trigger = trig;
+	data->handler = handler;
+	polarity = (cfg->os.dt_flags & GPIO_ACTIVE_LOW) ? ACTIVE_LOW : ACTIVE_HIGH;
+	if (ds7505_alert_attach(&data->alert, &data->ds7505, &cfg->os, polarity,
+				ds7505_sensor_alert, data) != DS7505_SUCCESS) {
+		data->handler = NULL;
+		return -EIO;
+	}
+	return 0;
+};
+
+static int ds7505_sensor_init(const struct device *dev)
+{
+	const struct ds7505_sensor_config *cfg = dev->config;
+	struct ds7505_sensor_data *data = dev->data;
+	uint8_t config;
+
+	if (!device_is_ready(cfg->i2c.bus)) {
+		printk("DS7505: I2C %s is not ready\n", cfg->i2c.bus->name);
+		return -ENODEV;
+	}
+
+	data->dev = dev;
+	ds7505_init(&data->ds7505, cfg->i2c.bus, (enum DS7505_addr)cfg->i2c.addr);
+	if (ds7505_get_config_reg(&data->ds7505) != DS7505_SUCCESS) {
+		printk("DS7505: no answer from 0x%02x\n", cfg->i2c.addr);
+		return -EIO;
+	}
+
+	/* fault tolerance, polarity and mode stay as recalled from the EEPROM */
+	config = data->ds7505.config;
+	if (ds7505_set_config_reg(&data->ds7505, cfg->resolution, config & OUT_OF_LIMITS_TRIG_6,
+				  config & ACTIVE_HIGH, config & INTERRUPT) != DS7505_SUCCESS) {
+		return -EIO;
+	}
+	return 0;
+};
+
+#ifdef CONFIG_SENSOR_ASYNC_API
+/* one read as stored in the RTIO buffer, the frame is not converted until decode */
+struct ds7505_sensor_frame {
+	uint64_t timestamp_ns;
+	uint8_t raw[DS7505_FRAME_SIZE];
+};
+
+static void ds7505_sensor_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct sensor_read_config *read_cfg = iodev_sqe->sqe.iodev->data;
+	struct ds7505_sensor_data *data = dev->data;
+	struct ds7505_sensor_frame *frame;
+	uint8_t *buf;
+	uint32_t buf_len;
+	int ret;
+
+	if (read_cfg->is_streaming) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+	for (size_t i = 0; i < read_cfg->count; i++) {
+		enum sensor_channel chan = read_cfg->channels[i].chan_type;
+
+		if (chan != SENSOR_CHAN_AMBIENT_TEMP && chan != SENSOR_CHAN_ALL) {
+			rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+			return;
+		}
+	}
+
+	ret = rtio_sqe_rx_buf(iodev_sqe, sizeof(*frame), sizeof(*frame), &buf, &buf_len);
+	if (ret != 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
+		return;
+	}
+	frame = (struct ds7505_sensor_frame *)buf;
+	frame->timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks());
+	if (ds7505_read_frame(&data->ds7505, frame->raw) != DS7505_SUCCESS) {
+		rtio_iodev_sqe_err(iodev_sqe, -EIO);
+		return;
+	}
+	rtio_iodev_sqe_ok(iodev_sqe, 0);
+};
+
+static int ds7505_decoder_get_frame_count(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+					  uint16_t *frame_count)
+{
+	if (chan_spec.chan_type != SENSOR_CHAN_AMBIENT_TEMP || chan_spec.chan_idx != 0) {
+		return -ENOTSUP;
+	}
+	*frame_count = 1;
+	return 0;
+};
+
+static int ds7505_decoder_get_size_info(struct sensor_chan_spec chan_spec, size_t *base_size,
+					size_t *frame_size)
+{
+	if (chan_spec.chan_type != SENSOR_CHAN_AMBIENT_TEMP) {
+		return -ENOTSUP;
+	}
+	*base_size = sizeof(struct sensor_q31_data);
+	*frame_size = sizeof(struct sensor_q31_sample_data);
+	return 0;
+};
+
+/* q31 with shift 8 covers +-256 degC, the 1/256 degC register LSB is bit 15 */
+static int ds7505_decoder_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+				 uint32_t *fit, uint16_t max_count, void *data_out)
+{
+	const struct ds7505_sensor_frame *frame = (const struct ds7505_sensor_frame *)buffer;
+	struct sensor_q31_data *out = data_out;
+
+	if (chan_spec.chan_type != SENSOR_CHAN_AMBIENT_TEMP || chan_spec.chan_idx != 0) {
+		return -ENOTSUP;
+	}
+	if (*fit != 0 || max_count == 0) {
+		return 0;
+	}
+	out->header.base_timestamp_ns = frame->timestamp_ns;
+	out->header.reading_count = 1;
+	out->shift = 8;
+	out->readings[0].timestamp_delta = 0;
+	out->readings[0].temperature = (q31_t)ds7505_decode_frame(frame->raw) * (1 << 15);
+	*fit = 1;
+	return 1;
+};
+
+static const struct sensor_decoder_api ds7505_decoder_api = {
+	.get_frame_count = ds7505_decoder_get_frame_count,
+	.get_size_info = ds7505_decoder_get_size_info,
+	.decode = ds7505_decoder_decode,
+};
+
+static int ds7505_sensor_get_decoder(const struct device *dev,
+				     const struct sensor_decoder_api **decoder)
+{
+	*decoder = &ds7505_decoder_api;
+	return 0;
+};
+#endif
+
+static const struct sensor_driver_api ds7505_sensor_api = {
+	.sample_fetch = ds7505_sensor_sample_fetch,
+	.channel_get = ds7505_sensor_channel_get,
+	.attr_set = ds7505_sensor_attr_set,
+	.trigger_set = ds7505_sensor_trigger_set,
+#ifdef CONFIG_SENSOR_ASYNC_API
+	.submit = ds7505_sensor_submit,
+	.get_decoder = ds7505_sensor_get_decoder,
+#endif
+};
+
+#define DS7505_SENSOR_DEFINE(inst)                                                           \
+	static struct ds7505_sensor_data ds7505_sensor_data_##inst;                          \
+	static const struct ds7505_sensor_config ds7505_sensor_config_##inst = {             \
+		.i2c = I2C_DT_SPEC_INST_GET(inst),                                           \
+		.resolution = (DT_INST_PROP(inst, resolution) - 9) << 5,                     \
+		.os = GPIO_DT_SPEC_INST_GET_OR(inst, os_gpios, { 0 }),                       \
+	};                                                                                   \
+	DEVICE_DT_INST_DEFINE(inst, ds7505_sensor_init, NULL, &ds7505_sensor_data_##inst,    \
+			      &ds7505_sensor_config_##inst, POST_KERNEL,                     \
+			      CONFIG_SENSOR_INIT_PRIORITY, &ds7505_sensor_api);
+
+DT_INST_FOREACH_STATUS_OKAY(DS7505_SENSOR_DEFINE)
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef _DS7505_SENSOR_H
+#define _DS7505_SENSOR_H
+
+#include <drivers/sensor.h>
+
+/* sensor_attr_set() on SENSOR_CHAN_AMBIENT_TEMP:
+ * SENSOR_ATTR_UPPER_THRESH - T_OS, SENSOR_ATTR_LOWER_THRESH and SENSOR_ATTR_HYSTERESIS -
+ * T_HYST, both in degC, SENSOR_ATTR_DS7505_RESOLUTION - val1 = 9..12 bits.
+ */
+enum ds7505_sensor_attribute {
+	SENSOR_ATTR_DS7505_RESOLUTION = SENSOR_ATTR_PRIV_START,
+};
+
+#endif //_DS7505_SENSOR_H_
@@ -0,0 +1,115 @@
+#include <zephyr.h>
+#include <string.h>
+#include "ds7505_stats.h"
+
+/* centre of the bin holding the sample at per_mille of the window, kept within min..max */
+static int16_t ds7505_stats_percentile(const struct ds7505_stats_t *stats, uint16_t per_mille)
+{
+	uint32_t rank = ((uint32_t)stats->count * per_mille + 999) / 1000;
+	uint32_t seen = 0;
+	int32_t centre;
+	uint16_t i;
+
+	if (rank == 0) {
+		rank = 1;
+	}
+	for (i = 0; i < DS7505_STATS_BINS; i++) {
+		seen += stats->bins[i];
+		if (seen >= rank) {
+			centre = DS7505_STATS_MIN_RAW + (i << DS7505_STATS_BIN_SHIFT) +
+				 ((1 << DS7505_STATS_BIN_SHIFT) >> 1);
+			if (centre < stats->min) {
+				return stats->min;
+			}
+			return centre > stats->max ? stats->max : centre;
+		}
+	}
+	return stats->max;
+};
+
+static void ds7505_stats_fill(const struct ds7505_stats_t *stats, struct ds7505_summary_t *summary)
+{
+	summary->window = stats->windows;
+	summary->count = stats->count;
+	summary->min_raw = stats->min;
+	summary->max_raw = stats->max;
+	summary->mean_raw = stats->sum / stats->count;
+	summary->ema_raw = stats->ema >> DS7505_STATS_EMA_SHIFT;
+	summary->p50_raw = ds7505_stats_percentile(stats, 500);
+	summary->p90_raw = ds7505_stats_percentile(stats, 900);
+	summary->p99_raw = ds7505_stats_percentile(stats, 990);
+};
+
+void ds7505_stats_init(struct ds7505_stats_t *stats, uint16_t window)
+{
+	stats->window = window ? window : 1;
+	ds7505_stats_reset(stats);
+};
+
+bool ds7505_stats_update(struct ds7505_stats_t *stats, int16_t raw)
+{
+	int32_t bin;
+
+	if (stats->count == 0 || raw < stats->min) {
+		stats->min = raw;
+	}
+	if (stats->count == 0 || raw > stats->max) {
+		stats->max = raw;
+	}
+	stats->sum += raw;
+	if (stats->ema_valid) {
+		stats->ema += raw - (stats->ema >> DS7505_STATS_EMA_SHIFT);
+	} else {
+		stats->ema = (int32_t)raw << DS7505_STATS_EMA_SHIFT;
+		stats->ema_valid = true;
+	}
+
+	bin = ((int32_t)raw - DS7505_STATS_MIN_RAW) >> DS7505_STATS_BIN_SHIFT;
+	if (bin < 0) {
+		bin = 0;
+	} else if (bin >= DS7505_STATS_BINS) {
+		bin = DS7505_STATS_BINS - 1;
+	}
+	stats->bins[bin]++;
+	stats->count++;
+
+	if (stats->count < stats->window) {
+		return false;
+	}
+	stats->windows++;
+	ds7505_stats_fill(stats, &stats->snapshot);
+	stats->count = 0;
+	stats->sum = 0;
+	memset(stats->bins, 0, sizeof(stats->bins));
+	return true;
+};
+
+bool ds7505_stats_update_sensor(struct ds7505_stats_t *stats, const struct ds7505_t *ds7505)
+{
+	return ds7505_stats_update(stats, ds7505->temperature_raw);
+};
+
+void ds7505_stats_current(const struct ds7505_stats_t *stats, struct ds7505_summary_t *summary)
+{
+	if (stats->count == 0) {
+		memset(summary, 0, sizeof(*summary));
+		summary->window = stats->windows + 1;
+		summary->ema_raw = stats->ema >> DS7505_STATS_EMA_SHIFT;
+		return;
+	}
+	ds7505_stats_fill(stats, summary);
+	summary->window = stats->windows + 1;
+};
+
+void ds7505_stats_reset(struct ds7505_stats_t *stats)
+{
+	stats->count = 0;
+	stats->windows = 0;
+	stats->min = 0;
+	stats->max = 0;
+	stats->sum = 0;
+	stats->ema = 0;
+	stats->ema_valid = false;
+	memset(stats->bins, 0, sizeof(stats->bins));
+	memset(&stats->snapshot, 0, sizeof(stats->snapshot));
+};
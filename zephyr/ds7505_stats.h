@@ -0,0 +1,60 @@
+#ifndef _DS7505_STATS_H
+#define _DS7505_STATS_H
+
+#include "ds7505.h"
+
+/* histogram bin width in raw LSB (1/256 degC), 7 -> 0.5 degC, 361 bins */
+#ifndef DS7505_STATS_BIN_SHIFT
+#define DS7505_STATS_BIN_SHIFT 7
+#endif
+/* EMA weight of a new sample is 1/2^DS7505_STATS_EMA_SHIFT */
+#ifndef DS7505_STATS_EMA_SHIFT
+#define DS7505_STATS_EMA_SHIFT 3
+#endif
+#define DS7505_STATS_MIN_RAW (-55 * 256)
+#define DS7505_STATS_MAX_RAW (125 * 256)
+#define DS7505_STATS_BINS                                                                          \
+	(((DS7505_STATS_MAX_RAW - DS7505_STATS_MIN_RAW) >> DS7505_STATS_BIN_SHIFT) + 1)
+
+struct ds7505_summary_t {
+	uint32_t window; /* number of the window, counts from 1 */
+	uint16_t count; /* samples in the window */
+	int16_t min_raw; /* 1/256 degC per LSB like temperature_raw */
+	int16_t max_raw;
+	int16_t mean_raw;
+	int16_t ema_raw;
+	int16_t p50_raw;
+	int16_t p90_raw;
+	int16_t p99_raw;
+};
+
+/* Running statistics of one sensor, updated in O(1) with every new sample.
+ * Samples are grouped in windows of a fixed number of reads; when a window is
+ * full its min/max/mean, the EMA and the p50/p90/p99 of a histogram sketch are
+ * frozen in snapshot and the next window starts. The EMA runs across windows.
+ * The sketch has one counter per 0.5 degC from -55 to +125 degC, percentiles
+ * are the bin centres, it is scanned once per window and by
+ * ds7505_stats_current(), never on update.
+ */
+struct ds7505_stats_t {
+	uint16_t window;
+	uint16_t count;
+	uint32_t windows;
+	int16_t min;
+	int16_t max;
+	int32_t sum; /* 65535 samples of 0x7FF0 still fit */
+	int32_t ema; /* raw << DS7505_STATS_EMA_SHIFT */
+	bool ema_valid;
+	uint16_t bins[DS7505_STATS_BINS];
+	struct ds7505_summary_t snapshot;
+};
+
+void ds7505_stats_init(struct ds7505_stats_t *stats, uint16_t window);
+/* true when the sample closed a window and stats->snapshot changed */
+bool ds7505_stats_update(struct ds7505_stats_t *stats, int16_t raw);
+bool ds7505_stats_update_sensor(struct ds7505_stats_t *stats, const struct ds7505_t *ds7505);
+/* the window in progress, scans the histogram */
+void ds7505_stats_current(const struct ds7505_stats_t *stats, struct ds7505_summary_t *summary);
+void ds7505_stats_reset(struct ds7505_stats_t *stats);
+
+#endif //_DS7505_STATS_H_
@@ -11,6 +11,7 @@
 #include <drivers/gpio.h>
 
 #include "ds7505.h"
+#include "ds7505_alert.h"
 
 #define I2C DT_ALIAS(i2c0)
 #if !DT_NODE_HAS_STATUS(I2C, okay)
@@ -22,50 +23,13 @@
 #error "SW not supported"
 #endif
 
-void temp_os_callback(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
-{
-	printk("temp os callback run \n");
-}
-
+static struct ds7505_t ds7505;
+static struct ds7505_alert_t temp_os_alert;
 
-uint8_t ds7505_attach(struct ds7505_t *ds7505, const struct gpio_dt_spec temp_os,
-		      enum eTermostat_Out_Polarity polarity,
-		      gpio_callback_handler_t temp_os_callback)
+void temp_os_callback(struct ds7505_t *ds7505, int8_t status, void *user_data)
 {
-	gpio_flags_t flags = GPIO_INT_EDGE_TO_ACTIVE;
-	if (polarity == ACTIVE_LOW) {
-		flags = GPIO_INT_EDGE_TO_INACTIVE;
-	}
-	static struct gpio_callback temp_os_cb_data;
-	int ret;
-	ret = gpio_pin_configure_dt(&temp_os, GPIO_INPUT);
-	if (ret != 0) {
-		printk("Error %d: failed to configure %s pin %d\n", ret, temp_os.port->name,
-		       temp_os.pin);
-		return DS7505_ERROR;
-	}
-	ret = gpio_pin_interrupt_configure_dt(&temp_os, flags);
-	if (ret != 0) {
-		printk("Error %d: failed to configure interrupt on %s pin %d\n", ret,
-		       temp_os.port->name, temp_os.pin);
-		return DS7505_ERROR;
-	}
-	gpio_init_callback(&temp_os_cb_data, temp_os_callback, BIT(temp_os.pin));
-
-	ret = gpio_add_callback(temp_os.port, &temp_os_cb_data);
-	if (ret != 0) {
-		printk("Error %d: failed to add calback on %s pin %d\n", ret, temp_os.port->name,
-		       temp_os.pin);
-		return DS7505_ERROR;
-	}
-	ret = ds7505_get_config_reg(ds7505);
-	if (ret == 0) {
-		uint8_t read_config = ds7505->config;
-		return ds7505_set_config_reg(ds7505, read_config & 0x96, read_config & 0x24,
-					     polarity, INTERRUPT);
-	}
-	return DS7505_ERROR;
-};
+	printk("temp os callback run, temp (%d), %f.\n", status, ds7505->temperature);
+}
 
 void main(void)
 {
@@ -73,12 +37,11 @@ void main(void)
 
 	const struct device *i2c_dev = DEVICE_DT_GET(I2C);
 
-	struct ds7505_t ds7505;
-	ds7505.addr = ADDR_48;
-	ds7505.dev = i2c_dev;
+	ds7505_init(&ds7505, i2c_dev, ADDR_48);
 	int8_t i;
 
-	ds7505_attach(&ds7505, temp_os_int, ACTIVE_LOW, temp_os_callback);
+	ds7505_alert_attach(&temp_os_alert, &ds7505, &temp_os_int, ACTIVE_LOW, temp_os_callback,
+			    NULL);
 
 	printk("I2C: %s %d\n", i2c_dev->name, ds7505.addr);
 